@@ -3,6 +3,7 @@
 //
 // Fixed and working main program
 
+#include "binancerj/net/Endpoints.hpp"
 #include "binancerj/net/WebSocket.hpp"
 
 #include <atomic>
@@ -191,8 +192,8 @@ void mainThread() {
 
 int runLegacyDepthViewer() {
     try {
-        const std::string host = "fstream.binance.com"; // futures
-        const std::string port = "443";
+        const std::string host = binancerj::net::Endpoints::get().streamHost; // futures
+        const std::string port = binancerj::net::Endpoints::get().streamPort;
 
         const int numWebSockets = 1; // visualization: single stream is sufficient
         std::vector<std::thread> threads;
@@ -1,5 +1,6 @@
 #include "binancerj/core/ThreadPool.hpp"
 #include "binancerj/net/AsyncWebSocketHub.hpp"
+#include "binancerj/net/Endpoints.hpp"
 #include "binancerj/telemetry/PerfTelemetry.hpp"
 
 #include <algorithm>
@@ -96,8 +97,8 @@ int runConsoleApp() {
 
     std::signal(SIGINT, handleSignal);
 
-    const std::string host = "fstream.binance.com";
-    const std::string port = "443";
+    const std::string host = binancerj::net::Endpoints::get().streamHost;
+    const std::string port = binancerj::net::Endpoints::get().streamPort;
     const int workerCount = 10;
 
     telemetry::logGauge("app", "hardware_threads", static_cast<double>(std::thread::hardware_concurrency()));
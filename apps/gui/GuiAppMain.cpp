@@ -41,6 +41,26 @@
 #include "third_party/imgui/backends/imgui_impl_win32.h"
 #include "third_party/imgui/backends/imgui_impl_dx11.h"
 #include "binancerj/net/BinanceRest.hpp"
+#include "binancerj/net/ClockSync.hpp"
+#include "binancerj/net/Endpoints.hpp"
+#include "binancerj/net/OrderGateway.hpp"
+#include "binancerj/net/OrderJson.hpp"
+#include "binancerj/net/OrderStager.hpp"
+#include "binancerj/net/RestScheduler.hpp"
+#include "binancerj/net/UserDataStream.hpp"
+#include "binancerj/net/WsOrderClient.hpp"
+#include "binancerj/core/FootprintAggregator.hpp"
+#include "binancerj/core/TradeStats.hpp"
+#include "binancerj/core/SweepDetector.hpp"
+#include "binancerj/core/Candle.hpp"
+#include "binancerj/core/KlineCache.hpp"
+#include "binancerj/core/BackfillPlanner.hpp"
+#include "binancerj/core/CandleLod.hpp"
+#include "binancerj/core/CandleMerge.hpp"
+#include "binancerj/core/CandlePyramid.hpp"
+#include "binancerj/core/SymbolTable.hpp"
+#include "binancerj/core/OrderManager.hpp"
+#include "binancerj/core/OrderTracer.hpp"
 
 // Shared state for visualization
 static std::atomic<int> messageCount{0};
@@ -58,6 +78,23 @@ static std::map<double, double, std::less<double>>    g_bookAsks; // lowest pric
 struct PubTrade { double price; double qty; long long ts; bool isBuy; };
 static std::vector<PubTrade> g_trades;
 static std::mutex tradesMutex;
+// Footprint / session volume profile, fed per trade and read by the chart (re-bucketed on Load)
+static binancerj::core::FootprintAggregator g_footprint(10.0, 60000);
+static constexpr double kFootprintTicksPerBucket = 100.0; // Load sizes the bucket from the symbol's tick
+// Streaming VWAP / CVD / rolling aggressor stats over the chart symbol's tape (session-anchored by default)
+static binancerj::core::TradeStats g_tradeStats;
+// Sweep / large-trade detection, one slot per interned SymbolId; thresholds adapt per symbol
+static binancerj::core::SweepDetector g_sweeps(binancerj::core::SymbolTable::kMaxSymbols);
+// Symbol of the diff-depth book (g_bookBids / g_bookAsks); sweeps of other symbols get no level probe
+static constexpr const char* kBookStreamSymbol = "BTCUSDT";
+static binancerj::core::SymbolId book_symbol_id() {
+    static const auto id = binancerj::core::SymbolTable::instance().intern(kBookStreamSymbol);
+    return id;
+}
+// The trade stream follows the chart symbol; a newer stream retires the previous one. The feed
+// mutex orders a retiring stream's last trade against the resets of a symbol switch.
+static std::atomic<int> g_tradeStreamGen{0};
+static std::mutex g_tradeFeedMutex;
 
 // My fills buffer for chart markers
 struct MyFill { long long id; std::string symbol; double price; double qty; long long ts; bool isBuy; };
@@ -77,11 +114,9 @@ static std::set<std::string> g_openPosSymbols;
 // Leverage lookup per open symbol (for ROI in overlays)
 static std::mutex g_levMx;
 static std::unordered_map<std::string, int> g_leverageBySymbol;
-// Orders auto-refresh shared state
+// Fills auto-refresh shared state (open orders come from the OMS snapshot)
 static std::mutex g_ordersMx;
-static std::string g_openOrdersBody;
 static std::string g_userTradesBody;
-static std::atomic<int> g_lastStatusOO{0};
 static std::atomic<int> g_lastStatusUT{0};
 static std::mutex g_chartSymbolMutex; // guard g_chartSymbol for background readers
 // Quick Order: window toggle and percent setting
@@ -90,11 +125,17 @@ static float s_qo_pct = 100.0f;       // percent of available USDT to use
 // Quick Order window removed
 
 // ==== Chart state (candlesticks) ====
-struct Candle { long long t0; long long t1; double o; double h; double l; double c; double v; };
+using binancerj::core::Candle;
 static std::vector<Candle> g_candles;
 static std::mutex g_candlesMutex;
+static std::string g_candlesKey; // "<SYMBOL>_<interval>" that g_candles holds (guarded by g_candlesMutex)
 static std::string g_chartSymbol = "BTCUSDT";
+static std::atomic<binancerj::core::SymbolId> g_chartSymbolId{binancerj::core::kNoSymbol}; // g_chartSymbol interned on each switch
 static std::string g_chartInterval = "1m";
+static std::atomic<long long> g_chartIntervalMs{60LL*1000}; // g_chartInterval for background threads
+// 1m base with every coarser chart interval derived from it (live tail + instant switches)
+static binancerj::core::CandlePyramid g_pyramid;
+static constexpr int kPyramidBaseBars = 4500; // ~3 days of 1m: covers the live bar of every level up to 1d
 static bool g_chartLoading = false;
 static bool g_chartLive = true;
 static bool g_showChartWin = true;
@@ -108,10 +149,9 @@ static std::atomic<double> g_availableUSDT{0.0};
 static std::atomic<double> g_marginBalanceUSDT{0.0};
 // Public price mirrors for conversions (BNB->USDT)
 static std::atomic<double> g_bnbUsdt{0.0};
-// Exchange filters (tick/step/min) mirrored globally for chart interactions
-static std::atomic<double> g_priceTick{0.1};
-static std::atomic<double> g_qtyStep{0.001};
-static std::atomic<double> g_minQty{0.0};
+// Exchange filters (tick/step/min) of every symbol: binancerj::core::SymbolTable
+static constexpr const char* kSymbolTablePath = "cache/symbols.tsv";
+static constexpr const char* kOrderLatencyReportPath = "logs/order_latency";  // + .csv / .json
 
 // In-chart order dialog state
 static bool   g_showOrderDialog = false;
@@ -133,53 +173,228 @@ static std::mutex g_posOverlayMutex;
 static void RenderChartWindow();
 static void StartOrRestartKlineStream(const std::string& symbolLower, const std::string& interval);
 static void StartOrRestartAggTradeStream(const std::string& symbolLower);
-// Global background pollers (start once regardless of tabs)
-static void StartOrdersAndFillsPollerOnce();
+// Global background workers (start once regardless of tabs)
+static void StartUserDataMirrorOnce();
 static void StartBnbTickerPollerOnce();
 
-static void StartOrdersAndFillsPollerOnce() {
+// recvWindow for order entry: sized from the measured round trip once the exchange clock
+// is synced (timestamps are then exchange time), 5000 ms until then.
+static int order_recv_window() {
+    return binancerj::net::ClockSync::instance().recvWindowMs(5000);
+}
+
+// One full exchangeInfo call loads every symbol's filters; the table is then saved for the
+// next warm start.
+static bool refresh_symbol_table(BinanceRest& rest) {
+    auto r = rest.getExchangeInfo();
+    if (!r.ok) {
+        telemetry::logEvent("symbols", "exchange_info_failed status=" + std::to_string(r.status));
+        return false;
+    }
+    auto& table = binancerj::core::SymbolTable::instance();
+    if (table.loadExchangeInfo(r.body) == 0) return false;
+    table.save(kSymbolTablePath);
+    return true;
+}
+
+// Filters of the chart symbol; defaults until the symbol table knows it. Called every frame:
+// one atomic load of the interned id, no lock or string.
+struct ChartFilters { double tick{0.1}; double step{0.001}; double minQty{0.0}; };
+static ChartFilters chart_filters() {
+    ChartFilters f;
+    if (const auto* info = binancerj::core::SymbolTable::instance().info(g_chartSymbolId.load(std::memory_order_acquire))) {
+        if (info->tickSize > 0.0) f.tick = info->tickSize;
+        if (info->stepSize > 0.0) f.step = info->stepSize;
+        f.minQty = info->minQty;
+    }
+    return f;
+}
+
+// Cancels one order (orderId > 0) or all orders of symbol on the client's async I/O thread.
+// No thread per click; the open-orders list follows from the user data stream.
+static void cancel_order_async(BinanceRest* rest, const std::string& symbol, long long orderId) {
+    if (!rest) return;
+    BinanceRest::AsyncOptions opts;
+    opts.onComplete = [symbol, orderId](const BinanceRest::Result& r) {
+        if (orderId > 0) std::cout << "[REST] Cancel order #" << orderId << ": status=" << r.status << " ok=" << (r.ok?"true":"false") << "\n" << r.body << std::endl;
+        else std::cout << "[REST] Cancel ALL (" << symbol << ") status=" << r.status << " ok=" << (r.ok?"true":"false") << "\n" << r.body << std::endl;
+    };
+    if (orderId > 0) (void)rest->cancelOrderAsync(symbol, orderId, "", order_recv_window(), std::move(opts));
+    else (void)rest->cancelAllOpenOrdersAsync(symbol, order_recv_window(), std::move(opts));
+}
+
+// Every order this app places: client order ids, phases, and the open-order table the views read.
+static binancerj::core::OrderManager& order_manager() {
+    static binancerj::core::OrderManager oms;
+    return oms;
+}
+
+// Per-order latency from intent to first fill; published each second, exported on demand and at exit.
+static binancerj::core::OrderTracer& order_tracer() {
+    static binancerj::core::OrderTracer tracer;
+    return tracer;
+}
+
+// Transport shared by the order gateway and the quick order stager: REST by default, the
+// ws-fapi session when Endpoints selects it (BINANCE_RJ_ORDER_TRANSPORT=ws).
+static binancerj::net::OrderEntry& order_entry() {
+    if (binancerj::net::Endpoints::get().wsOrderEntry) {
+        static binancerj::net::WsOrderClient ws;
+        static const bool opened = (ws.setInsecureTLS(false), ws.connect(), true);
+        (void)opened;
+        return ws;
+    }
+    static BinanceRest rest(binancerj::net::Endpoints::get().restHost);
+    static const bool secure = (rest.setInsecureTLS(false), true);
+    (void)secure;
+    static binancerj::net::RestOrderEntry entry(rest);
+    return entry;
+}
+
+// Orders leave through one gateway: the UI thread only queues intents, the gateway's thread
+// hands them to the REST client's async path, and answers come back once per frame through
+// drain_order_acks(). Declared after order_manager(), so it is destroyed first.
+static binancerj::net::OrderGateway& order_gateway() {
+    binancerj::core::OrderTracer& tracer = order_tracer();  // created first, so it outlives the gateway
+    static binancerj::net::OrderGateway gateway(order_entry(), order_manager());
+    static const bool traced = (gateway.setTracer(&tracer), true);
+    (void)traced;
+    return gateway;
+}
+
+// Quick order payloads (buy/sell at the touch, position closes) for the chart symbol, restaged
+// every frame the book, balance or positions moved, so a hotkey only queues a staged payload.
+static binancerj::net::OrderStager& order_stager() {
+    static binancerj::net::OrderStager stager(order_entry());
+    return stager;
+}
+
+// Which view shows an order's answer (OrderIntent::source).
+enum OrderAckSink { kAckTrade = 1, kAckTradeExit, kAckQuick, kAckDialog, kAckChart };
+static std::string g_tradeResp;   // Trade panel: last answer
+static std::string g_quickResp;   // Quick Order: newest answers first
+
+// Queues o and returns "<tag>queued #<clientOrderId>" (or why it was not queued) for the view.
+static std::string queue_order(BinanceRest::OrderRequest o, int sink, std::string tag, std::function<void(const binancerj::net::OrderAck&)> then = {}) {
+    binancerj::net::OrderIntent intent;
+    intent.order = std::move(o);
+    intent.recvWindowMs = order_recv_window();
+    intent.source = sink;
+    intent.tag = tag;
+    intent.then = std::move(then);
+    const std::string cid = order_gateway().submit(std::move(intent));
+    return tag + (cid.empty() ? std::string("not sent: order queue full") : "queued #" + cid);
+}
+
+// Queues a staged payload: the gateway stamps the client order id, timestamp and signature.
+static std::string queue_staged(binancerj::net::OrderStager::StagedPtr staged, int sink, std::string tag) {
+    binancerj::net::OrderIntent intent;
+    intent.staged = std::move(staged);
+    intent.source = sink;
+    intent.tag = tag;
+    const std::string cid = order_gateway().submit(std::move(intent));
+    return tag + (cid.empty() ? std::string("not sent: order queue full") : "queued #" + cid);
+}
+
+// One line per answer: "<tag>OK #<orderId> NEW" or "<tag>ERR <status> <code msg>".
+static std::string ack_line(const binancerj::net::OrderAck& a) {
+    const long long orderId = binancerj::net::parseOrderJson(a.result.body).orderId;
+    if (a.result.ok && orderId > 0) return a.tag + "OK #" + std::to_string(orderId) + " " + binancerj::core::toString(a.phase);
+    std::string err = binancerj::net::orderErrorText(a.result.body);
+    if (err.empty()) err = a.result.body.substr(0, 120);
+    return a.tag + "ERR " + std::to_string(a.result.status) + " " + err;
+}
+
+// Routes the answers received since the last frame to the views that sent the orders.
+static void drain_order_acks() {
+    static std::vector<binancerj::net::OrderAck> acks;
+    acks.clear();
+    if (order_gateway().drainAcks(acks) == 0) return;
+    for (const auto& a : acks) {
+        std::cout << "[ORDER] " << a.clientOrderId << " " << ack_line(a) << " (queue " << a.queueUs << "us, ack " << a.ackMs << "ms)" << std::endl;
+        switch (a.source) {
+            case kAckTrade: g_tradeResp = ack_line(a) + "\n" + a.result.body; break;
+            case kAckTradeExit: g_tradeResp += "\n" + ack_line(a); break;
+            case kAckDialog: g_dialogResp = ack_line(a) + "\n" + a.result.body; break;
+            case kAckQuick:
+                g_quickResp = ack_line(a) + "\n" + g_quickResp;
+                if (g_quickResp.size() > 4000) g_quickResp.resize(4000);
+                break;
+            default: break;
+        }
+    }
+}
+
+// Account state pushed by the user data stream; REST only reconciles it in the background.
+static binancerj::net::UserDataStream& user_data_stream() {
+    binancerj::core::OrderTracer& tracer = order_tracer();  // created first, so it outlives the stream
+    static binancerj::net::UserDataStream stream;
+    static const bool attached = (stream.setOrderManager(&order_manager()), stream.setOrderTracer(&tracer), true);
+    (void)attached;
+    return stream;
+}
+
+// Threads that wait on the stream's account state. Joined before main returns: the stream is a
+// function-static, and its condition variable must not be destroyed while they wait on it.
+static std::atomic<bool> g_mirrorStop{false};
+static std::vector<std::thread> g_mirrorThreads;  // UI thread only
+
+static void StopUserDataMirrors() {
+    g_mirrorStop.store(true, std::memory_order_relaxed);
+    for (auto& t : g_mirrorThreads) {
+        if (t.joinable()) t.join();
+    }
+    g_mirrorThreads.clear();
+}
+
+// Mirrors user data stream snapshots into the Fills view on every account change (and chart
+// symbol switch): fills of the chart symbol in the REST shape the view parses, chart fill
+// markers, and fees paid on each open position. Open orders are read from the OMS directly.
+static void StartUserDataMirrorOnce() {
     static bool started = false; if (started) return; started = true;
-    std::thread([]{
+    binancerj::net::UserDataStream& uds = user_data_stream();
+    uds.start();
+    g_mirrorThreads.emplace_back([&uds]{
         try {
-            BinanceRest rest("fapi.binance.com"); rest.setInsecureTLS(false);
-            for (;;) {
-                // Chart symbol snapshot
+            std::uint64_t seen = 0;
+            std::string lastSym;
+            while (!g_mirrorStop.load(std::memory_order_relaxed)) {
                 std::string symChart; { std::lock_guard<std::mutex> lk(g_chartSymbolMutex); symChart = g_chartSymbol; }
-                // Refresh open orders for chart symbol
-                auto r1 = rest.getOpenOrders(symChart, 5000);
-                { std::lock_guard<std::mutex> lk(g_ordersMx); g_openOrdersBody = r1.body; g_lastStatusOO.store(r1.status, std::memory_order_relaxed); }
-
-                // Refresh last fills snapshot for chart symbol (for UI details)
-                try {
-                    auto rChart = rest.getUserTrades(symChart, 200, 5000);
-                    { std::lock_guard<std::mutex> lk(g_ordersMx); g_userTradesBody = rChart.body; }
-                    g_lastStatusUT.store(rChart.status, std::memory_order_relaxed);
-                    using nlohmann::json; auto j = json::parse(rChart.body, nullptr, false);
-                    std::vector<ParsedFill> pf;
-                    if (j.is_array()) {
-                        for (auto &e : j) {
-                            ParsedFill f{}; f.id = e.value("id", 0LL);
-                            bool buyer=false; if (e.contains("isBuyer") && e["isBuyer"].is_boolean()) buyer=e["isBuyer"].get<bool>(); else if (e.contains("buyer") && e["buyer"].is_boolean()) buyer=e["buyer"].get<bool>();
-                            f.isBuyer = buyer;
-                            auto getd=[&](const nlohmann::json& v)->double{ if (v.is_string()) return std::stod(v.get<std::string>()); else if(v.is_number()) return v.get<double>(); else return 0.0; };
-                            f.price = e.contains("price")? getd(e["price"]) : 0.0; f.qty = e.contains("qty")? getd(e["qty"]) : 0.0;
-                            f.time = e.value("time", 0LL); f.commission = e.contains("commission")? getd(e["commission"]) : 0.0; f.commissionAsset = e.value("commissionAsset", "");
-                            pf.push_back(std::move(f));
-                        }
-                    }
-                    { std::lock_guard<std::mutex> lk(g_fillsMutex); g_lastFills.swap(pf); }
-                } catch (...) {}
-
-                // Build fetch list from currently open positions + chart symbol
-                std::set<std::string> fetchSyms; { std::lock_guard<std::mutex> lk(g_openSymbolsMx); fetchSyms = g_openPosSymbols; }
-                fetchSyms.insert(symChart);
-                // Snapshot current net position amounts (symbol -> amt)
-                std::unordered_map<std::string,double> posAmtSnap; {
-                    std::lock_guard<std::mutex> lk(g_posOverlayMutex);
-                    for (auto &t : g_posOverlay) {
-                        posAmtSnap[std::get<0>(t)] = std::get<1>(t);
-                    }
+                const bool symChanged = symChart != lastSym;
+                if (symChanged) { uds.watchSymbol(symChart); lastSym = symChart; }
+                const std::uint64_t v = symChanged ? uds.state().version() : uds.state().waitForChange(seen, std::chrono::milliseconds(250));
+                if (v == seen && !symChanged) continue;
+                seen = v;
+                const auto snap = uds.snapshot();
+                if (snap->version == 0) continue;  // nothing loaded yet
+
+                using nlohmann::json;
+                // Chart symbol fills, oldest first like userTrades (last 200)
+                std::vector<const binancerj::core::FillState*> symFills;
+                for (std::size_t i = snap->fills.size(); i-- > 0 && symFills.size() < 200;) {
+                    if (snap->fills[i].symbol == symChart) symFills.push_back(&snap->fills[i]);
                 }
+                std::reverse(symFills.begin(), symFills.end());
+                json ut = json::array();
+                std::vector<ParsedFill> pf;
+                std::vector<MyFill> markers;
+                for (const auto* f : symFills) {
+                    const bool buyer = f->side == "BUY";
+                    ut.push_back({{"id", f->tradeId}, {"orderId", f->orderId}, {"isBuyer", buyer}, {"price", f->price}, {"qty", f->qty}, {"time", f->timeMs},
+                                  {"commission", f->commission}, {"commissionAsset", f->commissionAsset}});
+                    pf.push_back(ParsedFill{f->tradeId, buyer, f->price, f->qty, f->timeMs, f->commission, f->commissionAsset});
+                    markers.push_back(MyFill{f->tradeId, symChart, f->price, f->qty, f->timeMs, buyer});
+                }
+                {
+                    std::lock_guard<std::mutex> lk(g_ordersMx);
+                    g_userTradesBody = ut.dump();
+                    g_lastStatusUT.store(200, std::memory_order_relaxed);
+                }
+                { std::lock_guard<std::mutex> lk(g_fillsMutex); g_lastFills.swap(pf); }
+                { std::lock_guard<std::mutex> lk(g_myFillsMutex); g_myFills.swap(markers); }
+
+                // Fees of each open position: walk its symbol's fills newest first until the
+                // position size is covered.
                 auto toUSDT = [&](const std::string& asset, double amount)->double{
                     if (amount <= 0.0) return 0.0;
                     if (asset == "USDT") return amount;
@@ -191,54 +406,39 @@ static void StartOrdersAndFillsPollerOnce() {
                     }
                     return 0.0;
                 };
-                for (const auto &sym : fetchSyms) {
-                    try {
-                        auto rTrades = rest.getUserTrades(sym, 500, 5000);
-                        using nlohmann::json; auto jt = json::parse(rTrades.body, nullptr, false);
-                        if (jt.is_array()) {
-                            struct T { bool buy; double qty; double comm; std::string asset; };
-                            std::vector<T> trades; trades.reserve(jt.size());
-                            auto getd=[&](const nlohmann::json& v)->double{ if (v.is_string()) return std::stod(v.get<std::string>()); else if (v.is_number()) return v.get<double>(); else return 0.0; };
-                            for (auto &e : jt) {
-                                bool buyer=false; if (e.contains("isBuyer") && e["isBuyer"].is_boolean()) buyer=e["isBuyer"].get<bool>(); else if (e.contains("buyer") && e["buyer"].is_boolean()) buyer=e["buyer"].get<bool>();
-                                double q = e.contains("qty")? getd(e["qty"]) : 0.0;
-                                double c = e.contains("commission")? getd(e["commission"]) : 0.0;
-                                std::string a = e.value("commissionAsset", "");
-                                trades.push_back(T{buyer,q,c,a});
-                            }
-                            double posAmt = 0.0; auto itp = posAmtSnap.find(sym); if (itp!=posAmtSnap.end()) posAmt = itp->second;
-                            double need = std::abs(posAmt);
-                            double feeSum = 0.0;
-                            if (need > 1e-12) {
-                                for (int i=(int)trades.size()-1; i>=0 && need>1e-12; --i) {
-                                    const auto &tr = trades[i];
-                                    bool contributes = (posAmt>0 && tr.buy) || (posAmt<0 && !tr.buy);
-                                    if (!contributes || tr.qty <= 0.0) continue;
-                                    double useQty = std::min(need, tr.qty);
-                                    double frac = std::max(0.0, std::min(1.0, useQty / tr.qty));
-                                    feeSum += toUSDT(tr.asset, tr.comm * frac);
-                                    need -= useQty;
-                                }
-                            }
-                            {
-                                std::lock_guard<std::mutex> fk(g_feeMx);
-                                g_feeSpentBySymbolUSDT[sym] = feeSum;
-                            }
-                        }
-                    } catch (...) {}
+                std::unordered_map<std::string, double> fees;
+                for (const auto& p : snap->positions) {
+                    if (std::abs(p.amount) < 1e-12 || fees.count(p.symbol)) continue;
+                    const double posAmt = snap->positionAmount(p.symbol);
+                    double need = std::abs(posAmt);
+                    double feeSum = 0.0;
+                    for (std::size_t i = snap->fills.size(); i-- > 0 && need > 1e-12;) {
+                        const auto& tr = snap->fills[i];
+                        if (tr.symbol != p.symbol) continue;
+                        const bool buy = tr.side == "BUY";
+                        const bool contributes = (posAmt > 0 && buy) || (posAmt < 0 && !buy);
+                        if (!contributes || tr.qty <= 0.0) continue;
+                        double useQty = std::min(need, tr.qty);
+                        double frac = std::max(0.0, std::min(1.0, useQty / tr.qty));
+                        feeSum += toUSDT(tr.commissionAsset, tr.commission * frac);
+                        need -= useQty;
+                    }
+                    fees[p.symbol] = feeSum;
+                }
+                {
+                    std::lock_guard<std::mutex> fk(g_feeMx);
+                    for (const auto& [sym, fee] : fees) g_feeSpentBySymbolUSDT[sym] = fee;
                 }
-
-                std::this_thread::sleep_for(std::chrono::seconds(1));
             }
         } catch (...) {}
-    }).detach();
+    });
 }
 
 static void StartBnbTickerPollerOnce() {
     static bool started = false; if (started) return; started = true;
     std::thread([]{
         try {
-            BinanceRest rest("fapi.binance.com"); rest.setInsecureTLS(false);
+            BinanceRest rest(binancerj::net::Endpoints::get().restHost); rest.setInsecureTLS(false);
             for (;;) {
                 auto r = rest.getTickerPrice("BNBUSDT");
                 try {
@@ -268,7 +468,8 @@ static void receiveOrderBook(const std::string& host, const std::string& port, i
         WebSocket ws(host, port);
         ws.connect();
         // Subscribe to full diff depth (not limited to 20 levels)
-        ws.send("{\"method\":\"SUBSCRIBE\",\"params\":[\"btcusdt@depth@100ms\"],\"id\":" + std::to_string(id) + "}");
+        std::string bookSym = kBookStreamSymbol; std::transform(bookSym.begin(), bookSym.end(), bookSym.begin(), ::tolower);
+        ws.send("{\"method\":\"SUBSCRIBE\",\"params\":[\"" + bookSym + "@depth@100ms\"],\"id\":" + std::to_string(id) + "}");
 
         for (;;) {
             std::string message = ws.receive();
@@ -343,15 +544,37 @@ sleep_short:
     }
 }
 
+// Passive side a sweep is about to consume, snapshotted when its first fill arrives
+static int SnapshotSweepBookLevels(void*, std::uint16_t slot, double fromPrice, bool isBuy, double* prices, int maxLevels)
+{
+    if ((int)slot != book_symbol_id()) return -1; // only one symbol's book is streamed
+    int n = 0;
+    std::lock_guard<std::mutex> lk(bookMutex);
+    if (isBuy) {
+        if (g_bookAsks.empty()) return -1;
+        for (auto it = g_bookAsks.lower_bound(fromPrice - 1e-9); it != g_bookAsks.end() && n < maxLevels; ++it) prices[n++] = it->first;
+        return n;
+    }
+    if (g_bookBids.empty()) return -1;
+    for (auto it = g_bookBids.lower_bound(fromPrice + 1e-9); it != g_bookBids.end() && n < maxLevels; ++it) prices[n++] = it->first;
+    return n;
+}
+
 // Receive public trades and keep small ring buffer
-static void receivePublicTrades(const std::string& host, const std::string& port, const std::string& symbolLower)
+static void receivePublicTrades(const std::string& host, const std::string& port, const std::string& symbolLower, int gen)
 {
     try {
+        g_sweeps.setLevelProbe(&SnapshotSweepBookLevels, nullptr);
+        std::string symbolUpper = symbolLower; std::transform(symbolUpper.begin(), symbolUpper.end(), symbolUpper.begin(), ::toupper);
+        const auto slot = binancerj::core::SymbolTable::instance().intern(symbolUpper);
         WebSocket ws(host, port);
         ws.connect();
         std::string sub = std::string("{\"method\":\"SUBSCRIBE\",\"params\":[\"") + symbolLower + "@trade\"],\"id\":99}";
         ws.send(sub);
-        for (;;) {
+        const auto& clock = binancerj::net::ClockSync::instance();
+        long long latSumMs = 0; long long latCount = 0;
+        auto latWindowStart = std::chrono::steady_clock::now();
+        while (g_tradeStreamGen.load() == gen) {
             std::string msg = ws.receive();
             if (msg.empty()) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); continue; }
             try {
@@ -365,7 +588,21 @@ static void receivePublicTrades(const std::string& host, const std::string& port
                 if (d->contains("q")) qty   = std::stod((*d)["q"].get<std::string>());
                 if (d->contains("T")) ts    = (*d)["T"].get<long long>();
                 if (d->contains("m")) { bool m = (*d)["m"].get<bool>(); isBuy = !m; }
+                if (ts > 0 && clock.synced()) {
+                    // Exchange trade time -> local receive, averaged per second
+                    latSumMs += clock.exchangeLatencyMs(ts); ++latCount;
+                    auto nowSteady = std::chrono::steady_clock::now();
+                    if (nowSteady - latWindowStart >= std::chrono::seconds(1)) {
+                        telemetry::logGauge("ws", "trade_latency_ms", static_cast<double>(latSumMs) / latCount);
+                        latSumMs = 0; latCount = 0; latWindowStart = nowSteady;
+                    }
+                }
                 if (price>0 && qty>0) {
+                    std::lock_guard<std::mutex> feed(g_tradeFeedMutex);
+                    if (g_tradeStreamGen.load() != gen) break; // retired by a symbol switch
+                    g_footprint.addTrade(ts, price, qty, isBuy);
+                    g_tradeStats.addTrade(ts, price, qty, isBuy);
+                    if (slot != binancerj::core::kNoSymbol) g_sweeps.onTrade((std::uint16_t)slot, ts, price, qty, isBuy);
                     std::lock_guard<std::mutex> lk(tradesMutex);
                     g_trades.push_back(PubTrade{price, qty, ts, isBuy});
                     // Time-based retention to avoid dropping trades within current candle
@@ -382,6 +619,19 @@ static void receivePublicTrades(const std::string& host, const std::string& port
     } catch (...) { /* ignore */ }
 }
 
+// Points the trade tape at the chart symbol. The caller resets the per-symbol aggregates under
+// g_tradeFeedMutex together with this call, so no trade of the old symbol lands after them.
+static void StartOrRestartTradeStream(const std::string& symbolLower)
+{
+    static std::string lastSym;
+    if (symbolLower == lastSym) return;
+    lastSym = symbolLower;
+    const int gen = ++g_tradeStreamGen;
+    { std::lock_guard<std::mutex> lk(tradesMutex); g_trades.clear(); }
+    const auto& ep = binancerj::net::Endpoints::get();
+    std::thread(receivePublicTrades, ep.streamHost, ep.streamPort, symbolLower, gen).detach();
+}
+
 // ===== ImGui + D3D11 integration =====
 static ID3D11Device*            g_pd3dDevice = nullptr;
 static ID3D11DeviceContext*     g_pd3dDeviceContext = nullptr;
@@ -520,7 +770,6 @@ static void RenderOrderBookUI()
     static bool t_dualSide = false; // hedge mode
     static int t_leverage = 20;
     static int t_marginTypeIdx = 0; // 0=CROSS 1=ISOLATED
-    static std::string t_lastOrderResp;
 
     // Filters and sizing helpers
     static double s_qtyStep = 0.001;   // LOT_SIZE/MARKET_LOT_SIZE.stepSize
@@ -541,112 +790,89 @@ static void RenderOrderBookUI()
     static std::vector<std::tuple<std::string,double,double,int,double,std::string,std::string,double>> s_positions; // symbol, amt, entry, lev, upnl, marginType, side, mark
     static std::mutex s_positionsMutex;
 
-    static std::unique_ptr<BinanceRest> s_rest(new BinanceRest("fapi.binance.com"));
+    static std::unique_ptr<BinanceRest> s_rest(new BinanceRest(binancerj::net::Endpoints::get().restHost));
     if (s_rest) s_rest->setInsecureTLS(false);
 
-    // Background poller to refresh positions/balances (faster cadence)
+    // Mirror positions/balances from the user data stream whenever the account changes
     static bool s_posPollerStarted = false;
     if (!s_posPollerStarted) {
         s_posPollerStarted = true;
-        std::thread([&]{
+        g_mirrorThreads.emplace_back([&]{
             try {
-                BinanceRest rest("fapi.binance.com");
-                rest.setInsecureTLS(false);
-                for (;;) {
-                    auto r = rest.getAccountInfo(5000);
-                    if (r.ok) {
-                        try {
-                            using nlohmann::json; auto j = json::parse(r.body, nullptr, false);
-                            auto getd = [](const nlohmann::json& v)->double { if (v.is_string()) return std::stod(v.get<std::string>()); else return v.get<double>(); };
-                            double avail = s_availableUSDT, margin = s_marginBalanceUSDT;
-                            double taker = s_takerRate, maker = s_makerRate;
-                            std::vector<std::tuple<std::string,double,double,int,double,std::string,std::string,double>> pos;
-                            if (j.is_object()) {
-                                if (j.contains("assets") && j["assets"].is_array()) {
-                                    for (auto& a : j["assets"]) {
-                                        if (!a.is_object() || !a.contains("asset")) continue;
-                                        if (a["asset"].get<std::string>() == "USDT") {
-                                            if (a.contains("availableBalance")) avail = getd(a["availableBalance"]);
-                                            if (a.contains("marginBalance"))    margin = getd(a["marginBalance"]);
-                                        }
-                                    }
-                                }
-                                if (j.contains("takerCommissionRate")) taker = getd(j["takerCommissionRate"]);
-                                if (j.contains("makerCommissionRate")) maker = getd(j["makerCommissionRate"]);
-                                if (j.contains("positions") && j["positions"].is_array()) {
-                                    for (auto& p : j["positions"]) {
-                                        if (!p.is_object()) continue;
-                                        std::string sym = p.contains("symbol") ? p["symbol"].get<std::string>() : std::string();
-                                        double amt   = p.contains("positionAmt") ? getd(p["positionAmt"]) : 0.0;
-                                        if (std::abs(amt) < 1e-12) continue;
-                                        double entry = p.contains("entryPrice") ? getd(p["entryPrice"]) : 0.0;
-                                        int lev      = p.contains("leverage") ? (p["leverage"].is_string()? std::stoi(p["leverage"].get<std::string>()) : p["leverage"].get<int>()) : 0;
-                                        double upnl  = p.contains("unrealizedProfit") ? getd(p["unrealizedProfit"]) : 0.0;
-                                        std::string mtype = p.contains("marginType") ? p["marginType"].get<std::string>() : std::string();
-                                        std::string pside = p.contains("positionSide") ? p["positionSide"].get<std::string>() : std::string();
-                                        double mark  = p.contains("markPrice") ? getd(p["markPrice"]) : 0.0;
-                                        pos.emplace_back(sym, amt, entry, lev, upnl, mtype, pside, mark);
-                                    }
-                                }
-                            }
-                            {
-                                std::lock_guard<std::mutex> lk(s_positionsMutex);
-                                s_availableUSDT = avail;
-                                s_marginBalanceUSDT = margin;
-                                s_takerRate = taker;
-                                s_makerRate = maker;
-                                g_takerRate.store(taker, std::memory_order_relaxed);
-                                g_makerRate.store(maker, std::memory_order_relaxed);
-                                s_positions.swap(pos);
-                            }
-                            // Mirror wallet balances globally for cross-window usage
-                            g_availableUSDT.store(avail, std::memory_order_relaxed);
-                            g_marginBalanceUSDT.store(margin, std::memory_order_relaxed);
-                            // Publish lightweight overlay for chart
-                            std::vector<std::tuple<std::string,double,double>> ov;
-                            for (auto &t : s_positions) {
-                                const std::string& sym = std::get<0>(t);
-                                double amt = std::get<1>(t);
-                                double entry = std::get<2>(t);
-                                if (std::abs(amt) > 1e-12 && entry > 0.0)
-                                    ov.emplace_back(sym, amt, entry);
-                            }
-                            {
-                                std::lock_guard<std::mutex> gk(g_posOverlayMutex);
-                                g_posOverlay.swap(ov);
+                binancerj::net::UserDataStream& uds = user_data_stream();
+                uds.start();
+                std::uint64_t seen = 0;
+                while (!g_mirrorStop.load(std::memory_order_relaxed)) {
+                    const std::uint64_t v = uds.state().waitForChange(seen, std::chrono::seconds(1));
+                    if (v == seen || v == 0) continue;
+                    seen = v;
+                    const auto snap = uds.snapshot();
+                    double avail = s_availableUSDT, margin = s_marginBalanceUSDT;
+                    if (const auto* usdt = snap->balance("USDT")) {
+                        avail = usdt->availableBalance;
+                        margin = usdt->marginBalance;
+                    }
+                    const double taker = snap->takerRate, maker = snap->makerRate;
+                    std::vector<std::tuple<std::string,double,double,int,double,std::string,std::string,double>> pos;
+                    for (const auto& p : snap->positions) {
+                        if (std::abs(p.amount) < 1e-12) continue;
+                        pos.emplace_back(p.symbol, p.amount, p.entryPrice, p.leverage, p.unrealizedPnl, p.marginType, p.positionSide, p.markPrice);
+                    }
+                    {
+                        std::lock_guard<std::mutex> lk(s_positionsMutex);
+                        s_availableUSDT = avail;
+                        s_marginBalanceUSDT = margin;
+                        s_takerRate = taker;
+                        s_makerRate = maker;
+                        g_takerRate.store(taker, std::memory_order_relaxed);
+                        g_makerRate.store(maker, std::memory_order_relaxed);
+                        s_positions.swap(pos);
+                    }
+                    // Mirror wallet balances globally for cross-window usage
+                    g_availableUSDT.store(avail, std::memory_order_relaxed);
+                    g_marginBalanceUSDT.store(margin, std::memory_order_relaxed);
+                    // Publish lightweight overlay for chart
+                    std::vector<std::tuple<std::string,double,double>> ov;
+                    for (auto &t : s_positions) {
+                        const std::string& sym = std::get<0>(t);
+                        double amt = std::get<1>(t);
+                        double entry = std::get<2>(t);
+                        if (std::abs(amt) > 1e-12 && entry > 0.0)
+                            ov.emplace_back(sym, amt, entry);
+                    }
+                    {
+                        std::lock_guard<std::mutex> gk(g_posOverlayMutex);
+                        g_posOverlay.swap(ov);
+                    }
+                    // Update open position symbols and reset fee tracking for closed symbols
+                    {
+                        std::set<std::string> curOpen;
+                        for (auto &t2 : s_positions) { curOpen.insert(std::get<0>(t2)); }
+                        std::set<std::string> prevOpen;
+                        {
+                            std::lock_guard<std::mutex> lk(g_openSymbolsMx);
+                            prevOpen = g_openPosSymbols;
+                            g_openPosSymbols = curOpen;
+                        }
+                        // Rebuild leverage lookup for overlays
+                        {
+                            std::lock_guard<std::mutex> lk2(g_levMx);
+                            g_leverageBySymbol.clear();
+                            for (auto &t2 : s_positions) {
+                                g_leverageBySymbol[std::get<0>(t2)] = std::get<3>(t2);
                             }
-                            // Update open position symbols and reset fee tracking for closed symbols
-                            {
-                                std::set<std::string> curOpen;
-                                for (auto &t2 : s_positions) { curOpen.insert(std::get<0>(t2)); }
-                                std::set<std::string> prevOpen;
-                                {
-                                    std::lock_guard<std::mutex> lk(g_openSymbolsMx);
-                                    prevOpen = g_openPosSymbols;
-                                    g_openPosSymbols = curOpen;
-                                }
-                                // Rebuild leverage lookup for overlays
-                                {
-                                    std::lock_guard<std::mutex> lk2(g_levMx);
-                                    g_leverageBySymbol.clear();
-                                    for (auto &t2 : s_positions) {
-                                        g_leverageBySymbol[std::get<0>(t2)] = std::get<3>(t2);
-                                    }
-                                }
-                                for (const auto &sym2 : prevOpen) {
-                                    if (curOpen.find(sym2) == curOpen.end()) {
-                                        std::lock_guard<std::mutex> fk(g_feeMx);
-                                        g_feeSpentBySymbolUSDT.erase(sym2);
-                                        g_seenTradeIdsBySymbol.erase(sym2);
-                                    }
-                                }
+                        }
+                        for (const auto &sym2 : prevOpen) {
+                            if (curOpen.find(sym2) == curOpen.end()) {
+                                std::lock_guard<std::mutex> fk(g_feeMx);
+                                g_feeSpentBySymbolUSDT.erase(sym2);
+                                g_seenTradeIdsBySymbol.erase(sym2);
                             }
-                        } catch (...) {}
+                        }
                     }
-                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
                 }
             } catch (...) {}
-        }).detach();
+        });
     }
 
     // Public Trades window toggle
@@ -981,6 +1207,22 @@ static void RenderOrderBookUI()
 
         // Shared trading state aliases
         char* sym = t_sym;
+        // Panel filters follow the symbol table (unchanged until it knows the symbol). The id is
+        // resolved only when the field changes, or the table grows while the name is unknown.
+        static std::string s_symKey;
+        static binancerj::core::SymbolId s_symId = binancerj::core::kNoSymbol;
+        static std::size_t s_symTableSize = 0;
+        {
+            auto& table = binancerj::core::SymbolTable::instance();
+            if (s_symKey != sym || (s_symId == binancerj::core::kNoSymbol && s_symTableSize != table.size())) {
+                s_symKey = sym;
+                s_symId = table.find(s_symKey);
+                s_symTableSize = table.size();
+            }
+        }
+        if (const auto* info = binancerj::core::SymbolTable::instance().info(s_symId)) {
+            s_priceTick = info->tickSize; s_qtyStep = info->stepSize; s_minQty = info->minQty;
+        }
         float& orderQty = t_orderQty;
         float& limitPrice = t_limitPrice;
         float& stopPrice = t_stopPrice;
@@ -990,7 +1232,7 @@ static void RenderOrderBookUI()
         bool& dualSide = t_dualSide;
         int& leverage = t_leverage;
         int& marginTypeIdx = t_marginTypeIdx; // 0=CROSS 1=ISOLATED
-        std::string& lastOrderResp = t_lastOrderResp;
+        std::string& lastOrderResp = g_tradeResp;
         const char* types[] = {"MARKET","LIMIT","STOP_MARKET","TAKE_PROFIT_MARKET"};
         const char* tifs[] = {"GTC","IOC","FOK"};
         const char* margins[] = {"CROSS","ISOLATED"};
@@ -1025,38 +1267,19 @@ static void RenderOrderBookUI()
         ImGui::SameLine();
         if (ImGui::Button("Refresh Filters/Bal")) {
             if (s_rest) {
-                // Exchange filters
-                auto r1 = s_rest->getExchangeInfo(sym);
-                s_lastHttpStatus = r1.status; s_lastHttpBody = r1.body;
-                if (r1.ok) {
-                    try {
-                        using nlohmann::json; auto j = json::parse(r1.body, nullptr, false);
-                        if (j.is_object() && j.contains("symbols") && j["symbols"].is_array() && !j["symbols"].empty()) {
-                            auto s = j["symbols"][0];
-                            if (s.contains("filters") && s["filters"].is_array()) {
-                                double tick = s_priceTick, step = s_qtyStep, minq = s_minQty;
-                                for (auto& f : s["filters"]) {
-                                    if (!f.is_object() || !f.contains("filterType")) continue;
-                                    std::string ft = f["filterType"].get<std::string>();
-                                    auto getd = [](const nlohmann::json& v)->double { if (v.is_string()) return std::stod(v.get<std::string>()); else return v.get<double>(); };
-                                    if (ft == "PRICE_FILTER") {
-                                        if (f.contains("tickSize")) tick = getd(f["tickSize"]);
-                                    } else if (ft == "LOT_SIZE") {
-                                        if (f.contains("stepSize")) step = getd(f["stepSize"]);
-                                        if (f.contains("minQty"))  minq = getd(f["minQty"]);
-                                    }
-                                }
-                                s_priceTick = tick; s_qtyStep = step; s_minQty = minq;
-                                // Mirror globally for chart interactions
-                                g_priceTick.store(s_priceTick, std::memory_order_relaxed);
-                                g_qtyStep.store(s_qtyStep, std::memory_order_relaxed);
-                                g_minQty.store(s_minQty, std::memory_order_relaxed);
-                                s_filtersMsg = "Loaded filters: tick=" + std::to_string(s_priceTick) + ", step=" + std::to_string(s_qtyStep) + ", minQty=" + std::to_string(s_minQty);
-                            }
-                        }
-                    } catch (...) {}
+                // Exchange filters: reload the whole symbol table (one call, cached briefly)
+                if (refresh_symbol_table(*s_rest)) {
+                    s_symKey = sym;
+                    s_symId = binancerj::core::SymbolTable::instance().find(s_symKey);
+                    if (const auto* info = binancerj::core::SymbolTable::instance().info(s_symId)) {
+                        s_priceTick = info->tickSize; s_qtyStep = info->stepSize; s_minQty = info->minQty;
+                        s_filtersMsg = "Loaded filters: tick=" + std::to_string(s_priceTick) + ", step=" + std::to_string(s_qtyStep) + ", minQty=" + std::to_string(s_minQty)
+                            + ", minNotional=" + std::to_string(info->minNotional);
+                    } else {
+                        s_filtersMsg = std::string("Unknown symbol ") + sym;
+                    }
                 } else {
-                    s_filtersMsg = std::string("exchangeInfo ERR ") + std::to_string(r1.status);
+                    s_filtersMsg = "exchangeInfo ERR";
                 }
                 // Account
                 auto r2 = s_rest->getAccountInfo(5000);
@@ -1257,64 +1480,37 @@ static void RenderOrderBookUI()
                 ImGui::EndPopup();
             }
             if (doSend) {
-                auto r = s_rest->placeOrder(sym, side, ot, qQty, qPrice, tifs[tifIdx], reduceOnly, false, 5000, positionSide, qStop, (orderTypeIdx>=2? workingTypes[workingTypeIdx]:"MARK_PRICE"));
-                char hdr[96]; snprintf(hdr, sizeof(hdr), "%s %s %s: ", side.c_str(), ot, sym);
-                lastOrderResp = std::string(hdr) + (r.ok?"OK ":"ERR ") + std::to_string(r.status) + "\n" + r.body;
-                // Attached TP/SL as reduce-only market stops
+                BinanceRest::OrderRequest entry;
+                entry.symbol = sym; entry.side = side; entry.type = ot; entry.quantity = qQty; entry.price = qPrice; entry.timeInForce = tifs[tifIdx];
+                entry.reduceOnly = reduceOnly; entry.positionSide = positionSide; entry.stopPrice = qStop; entry.workingType = (orderTypeIdx>=2? workingTypes[workingTypeIdx]:"MARK_PRICE");
+                // Attached TP/SL as reduce-only market stops, queued once the entry is accepted
+                // (the exits are reduce-only, so they must not race the entry itself)
                 double ref = (orderTypeIdx==1 && qPrice>0)? qPrice : (mid>0? mid : (isLong? ask:bid));
+                std::vector<BinanceRest::OrderRequest> exits;
+                auto make_exit = [&](const char* exitType, double trigger) {
+                    BinanceRest::OrderRequest o;
+                    o.symbol = sym; o.side = isLong?"SELL":"BUY"; o.type = exitType; o.quantity = qQty;
+                    o.reduceOnly = true; o.positionSide = positionSide; o.stopPrice = trigger; o.workingType = workingTypes[workingTypeIdx];
+                    exits.push_back(o);
+                };
                 if (attachTP && ref>0) {
                     double tpp = ref * (isLong? (1.0 + tpOffsetPct/100.0) : (1.0 - tpOffsetPct/100.0));
-                    tpp = floor_step(tpp, s_priceTick);
-                    (void)s_rest->placeOrder(sym, isLong?"SELL":"BUY", "TAKE_PROFIT_MARKET", qQty, 0.0, "GTC", true, false, 5000, positionSide, tpp, workingTypes[workingTypeIdx]);
+                    make_exit("TAKE_PROFIT_MARKET", floor_step(tpp, s_priceTick));
                 }
                 if (attachSL && ref>0) {
                     double slp = ref * (isLong? (1.0 - slOffsetPct/100.0) : (1.0 + slOffsetPct/100.0));
-                    slp = floor_step(slp, s_priceTick);
-                    (void)s_rest->placeOrder(sym, isLong?"SELL":"BUY", "STOP_MARKET", qQty, 0.0, "GTC", true, false, 5000, positionSide, slp, workingTypes[workingTypeIdx]);
+                    make_exit("STOP_MARKET", floor_step(slp, s_priceTick));
                 }
-                // Quick async refresh for positions overlay
-                std::thread([s=std::string(sym)]{
-                    try {
-                        BinanceRest rest("fapi.binance.com"); rest.setInsecureTLS(false);
-                        auto rr = rest.getAccountInfo(3000);
-                        if (!rr.ok) return;
-                        using nlohmann::json; auto j = json::parse(rr.body, nullptr, false);
-                        if (!j.is_object() || !j.contains("positions")) return;
-                        std::vector<std::tuple<std::string,double,double>> ov;
-                        auto getd = [](const nlohmann::json& v)->double { if (v.is_string()) return std::stod(v.get<std::string>()); else return v.get<double>(); };
-                        for (auto &p : j["positions"]) {
-                            if (!p.is_object()) continue;
-                            std::string sy = p.contains("symbol") ? p["symbol"].get<std::string>() : std::string();
-                            if (!s.empty() && sy != s) continue;
-                            double amt = p.contains("positionAmt") ? getd(p["positionAmt"]) : 0.0;
-                            double entry = p.contains("entryPrice") ? getd(p["entryPrice"]) : 0.0;
-                            if (std::abs(amt) > 1e-12 && entry > 0.0) ov.emplace_back(sy, amt, entry);
-                        }
-                        if (!ov.empty()) { std::lock_guard<std::mutex> lk(g_posOverlayMutex); g_posOverlay.swap(ov); }
-
-                        // Refresh recent user trades for chart markers
-                        auto ut = rest.getUserTrades(s.empty()? g_chartSymbol : s, 50, 3000);
-                        if (ut.ok) {
-                            try {
-                                auto ju = json::parse(ut.body, nullptr, false);
-                                if (ju.is_array()) {
-                                    std::vector<MyFill> tmp;
-                                    for (auto &e : ju) {
-                                        long long id = e.value("id", 0LL);
-                                        bool isBuyer = false; if (e.contains("isBuyer") && e["isBuyer"].is_boolean()) isBuyer = e["isBuyer"].get<bool>(); else if (e.contains("buyer") && e["buyer"].is_boolean()) isBuyer = e["buyer"].get<bool>();
-                                        auto parseD=[&](const nlohmann::json& v)->double{ if (v.is_string()) return std::stod(v.get<std::string>()); else if(v.is_number()) return v.get<double>(); else return 0.0; };
-                                        double price = e.contains("price")? parseD(e["price"]) : 0.0;
-                                        double qty   = e.contains("qty")? parseD(e["qty"]) : 0.0;
-                                        long long ts = e.value("time", 0LL);
-                                        tmp.push_back(MyFill{id, s.empty()? g_chartSymbol : s, price, qty, ts, isBuyer});
-                                    }
-                                    std::lock_guard<std::mutex> lk2(g_myFillsMutex);
-                                    g_myFills.swap(tmp);
-                                }
-                            } catch(...) {}
-                        }
-                    } catch (...) {}
-                }).detach();
+                char hdr[96]; snprintf(hdr, sizeof(hdr), "%s %s %s: ", side.c_str(), ot, sym);
+                std::function<void(const binancerj::net::OrderAck&)> thenExits;
+                if (!exits.empty()) {
+                    thenExits = [exits](const binancerj::net::OrderAck& a) {
+                        if (!a.result.ok) return;
+                        for (const auto& e : exits) (void)queue_order(e, kAckTradeExit, e.type + " " + e.symbol + ": ");
+                    };
+                }
+                lastOrderResp = queue_order(entry, kAckTrade, hdr, std::move(thenExits));
+                // Positions overlay and fill markers follow from the user data stream events
             }
         };
 
@@ -1325,55 +1521,87 @@ static void RenderOrderBookUI()
             auto floor_step_loc = [](double v, double step)->double { if (step <= 0) return v; double n = std::floor((v + 1e-12) / step); return n * step; };
             auto ceil_step_loc  = [](double v, double step)->double { if (step <= 0) return v; double n = std::floor((v + 1e-12) / step); double x = n * step; if (x < v - 1e-12) x += step; return x; };
 
-            auto send_quick = [&](bool isBuy){
-                if (!s_rest) return std::string("REST not ready");
-                std::string sym = g_chartSymbol;
-                double ask=0.0, bid=0.0; {
+            // Keep the quick order payloads staged; a no-op unless an input moved since last frame
+            {
+                static binancerj::net::OrderStager::Inputs in;
+                in.symbol = g_chartSymbol;
+                in.bestAsk = in.bestBid = 0.0; // "No book" unless the streamed book is the chart symbol's
+                if (g_chartSymbolId.load(std::memory_order_acquire) == book_symbol_id()) {
                     std::lock_guard<std::mutex> lk(bookMutex);
-                    if (!g_bookAsks.empty()) ask = g_bookAsks.begin()->first;
-                    if (!g_bookBids.empty()) bid = g_bookBids.begin()->first;
+                    in.bestAsk = g_bookAsks.empty() ? 0.0 : g_bookAsks.begin()->first;
+                    in.bestBid = g_bookBids.empty() ? 0.0 : g_bookBids.begin()->first;
                 }
-                double refP = isBuy ? ask : bid; if (refP <= 0.0) return std::string("No book");
-                int lev = t_leverage; bool useLev = s_useLeverageForSize;
-                double notional = s_availableUSDT * (std::max(0.0f, s_qo_pct)/100.0f) * (useLev ? (double)lev : 1.0);
-                double q = notional / refP; q = floor_step_loc(q, s_qtyStep); if (q < s_minQty) q = s_minQty;
-                if (q <= 0.0) return std::string("Qty too small");
-                double qPrice = isBuy ? ceil_step_loc(refP, s_priceTick) : floor_step_loc(refP, s_priceTick);
-                std::string side = isBuy? "BUY" : "SELL";
-                std::string positionSide; if (t_dualSide) positionSide = isBuy?"LONG":"SHORT";
-                auto r = s_rest->placeOrder(sym, side, "LIMIT", q, qPrice, "IOC", false, false, 5000, positionSide, 0.0, "MARK_PRICE");
-                char hdr[96]; snprintf(hdr, sizeof(hdr), "%s LIMIT %s: ", side.c_str(), sym.c_str());
-                return std::string(hdr) + (r.ok?"OK ":"ERR ") + std::to_string(r.status) + "\n" + r.body;
+                in.availableUsdt = s_availableUSDT;
+                in.sizePct = s_qo_pct;
+                in.leverage = s_useLeverageForSize ? (double)t_leverage : 1.0;
+                // The chart symbol's own filters; the Trade panel's s_* follow t_sym, which may differ
+                const ChartFilters cf = chart_filters();
+                in.qtyStep = cf.step; in.priceTick = cf.tick; in.minQty = cf.minQty;
+                in.dualSide = t_dualSide;
+                in.recvWindowMs = order_recv_window();
+                in.positions.clear();
+                {
+                    std::lock_guard<std::mutex> lk(s_positionsMutex);
+                    for (auto &pt : s_positions) {
+                        if (std::get<0>(pt) == in.symbol) in.positions.push_back(binancerj::net::OrderStager::Position{std::get<1>(pt), std::get<7>(pt)});
+                    }
+                }
+                order_stager().update(in);
+            }
+
+            // Hot path: take the staged payload and queue it; nothing is rounded or serialized here
+            auto send_quick = [&](bool isBuy){
+                const auto staged = order_stager().current();
+                const auto& order = isBuy ? staged->buy : staged->sell;
+                if (!order) return staged->note.empty() ? std::string("Not staged") : staged->note;
+                return queue_staged(order, kAckQuick, order->order.side + " LIMIT " + order->order.symbol + ": ");
             };
 
             auto flatten_all = [&](){
-                if (!s_rest) return std::string("REST not ready");
+                // The chart symbol's closes are staged; other symbols are built here
+                const auto staged = order_stager().current();
+                std::string log;
+                for (const auto& order : staged->flatten) {
+                    char hdr[160]; snprintf(hdr, sizeof(hdr), "%s %s LIMIT q=%.6f @%.2f: ", order->order.symbol.c_str(), order->order.side.c_str(), order->order.quantity, order->order.price);
+                    log = queue_staged(order, kAckQuick, hdr) + "\n" + log;
+                }
                 std::vector<std::tuple<std::string,double,double,int,double,std::string,std::string,double>> pos_copy;
                 { std::lock_guard<std::mutex> lk(s_positionsMutex); pos_copy = s_positions; }
-                std::string log;
                 for (auto &pt : pos_copy) {
                     const std::string& psym = std::get<0>(pt);
+                    if (psym == staged->symbol) continue;
                     double amt = std::get<1>(pt); if (std::abs(amt) < 1e-12) continue;
+                    // Each position rounds on its own symbol's grid
+                    const auto& table = binancerj::core::SymbolTable::instance();
+                    const auto psymId = table.find(psym);
+                    const auto* info = table.info(psymId);
+                    if (!info || info->stepSize <= 0.0 || info->tickSize <= 0.0) { log = psym + ": no symbol filters, not flattened\n" + log; continue; }
                     double mark = std::get<7>(pt);
-                    double ask=0.0, bid=0.0; { std::lock_guard<std::mutex> lk(bookMutex); if (!g_bookAsks.empty()) ask = g_bookAsks.begin()->first; if (!g_bookBids.empty()) bid = g_bookBids.begin()->first; }
+                    double ask=0.0, bid=0.0;
+                    if (psymId == book_symbol_id()) { std::lock_guard<std::mutex> lk(bookMutex); if (!g_bookAsks.empty()) ask = g_bookAsks.begin()->first; if (!g_bookBids.empty()) bid = g_bookBids.begin()->first; }
                     bool isLong = (amt>0);
                     std::string side = isLong? "SELL" : "BUY";
                     double refP = isLong ? bid : ask; if (refP<=0.0 && mark>0.0) refP = mark;
-                    double q = std::abs(amt); q = floor_step_loc(q, s_qtyStep); if (q < s_minQty) q = s_minQty; if (q<=0.0) continue;
-                    double qPrice = isLong ? floor_step_loc(refP, s_priceTick) : ceil_step_loc(refP, s_priceTick);
+                    if (refP <= 0.0) { log = psym + ": no price, not flattened\n" + log; continue; }
+                    double q = std::abs(amt); q = floor_step_loc(q, info->stepSize); if (q < info->minQty) q = info->minQty; if (q<=0.0) continue;
+                    double qPrice = isLong ? floor_step_loc(refP, info->tickSize) : ceil_step_loc(refP, info->tickSize);
                     std::string positionSide; if (t_dualSide) positionSide = isLong?"LONG":"SHORT";
-                    auto r = s_rest->placeOrder(psym.c_str(), side, "LIMIT", q, qPrice, "IOC", true, false, 5000, positionSide, 0.0, "MARK_PRICE");
-                    log += psym+" FLAT "+side+" q="+std::to_string(q)+" @"+std::to_string(qPrice)+" -> "+(r.ok?"OK ":"ERR ")+std::to_string(r.status)+"\n";
+                    BinanceRest::OrderRequest o;
+                    o.symbol = psym; o.side = side; o.type = "LIMIT"; o.quantity = q; o.price = qPrice;
+                    o.timeInForce = "IOC"; o.reduceOnly = true; o.positionSide = positionSide;
+                    // Every position is queued at once; the gateway has them all on the wire together
+                    char hdr[160]; snprintf(hdr, sizeof(hdr), "%s %s LIMIT q=%.6f @%.2f: ", psym.c_str(), side.c_str(), q, qPrice);
+                    log = queue_order(o, kAckQuick, hdr) + "\n" + log;
                 }
                 return log;
             };
 
-            static std::string qo_last;
+            std::string& qo_last = g_quickResp;
             // Hotkeys: Ctrl+J BUY, Ctrl+K SELL, Ctrl+X FLATTEN
             {
                 ImGuiIO& io = ImGui::GetIO();
-                if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_J)) { g_showQuickWin = true; qo_last = send_quick(true); }
-                if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_K)) { g_showQuickWin = true; qo_last = send_quick(false); }
+                if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_J)) { g_showQuickWin = true; qo_last = send_quick(true) + "\n" + qo_last; }
+                if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_K)) { g_showQuickWin = true; qo_last = send_quick(false) + "\n" + qo_last; }
                 if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_X)) { g_showQuickWin = true; qo_last = flatten_all() + qo_last; }
             }
 
@@ -1385,24 +1613,29 @@ static void RenderOrderBookUI()
                     ImGui::TextDisabled("Best Ask: %.4f   Best Bid: %.4f", ask, bid);
                     ImGui::Separator();
                     ImGui::TextDisabled("Size %%"); ImGui::SameLine(); ImGui::SliderFloat("##qo_pct", &s_qo_pct, 1.0f, 100.0f, "%.0f%%");
-                    // Preview qty at mid reference
-                    double ref = (ask>0&&bid>0)? 0.5*(ask+bid) : (ask>0?ask:bid);
-                    if (ref>0) {
-                        int lev=t_leverage; double notional = s_availableUSDT * (s_qo_pct/100.0f) * (s_useLeverageForSize? (double)lev : 1.0); double q = notional/ref; q = floor_step_loc(q, s_qtyStep); ImGui::Text("Est Qty: %.6f", q);
+                    // What the buttons and hotkeys send right now
+                    {
+                        const auto staged = order_stager().current();
+                        if (staged->buy) ImGui::Text("BUY  %.6f @ %.4f", staged->buy->order.quantity, staged->buy->order.price);
+                        if (staged->sell) ImGui::Text("SELL %.6f @ %.4f", staged->sell->order.quantity, staged->sell->order.price);
+                        if (!staged->buy || !staged->sell) ImGui::TextDisabled("%s", staged->note.c_str());
                     }
                     ImVec2 bw(ImGui::GetContentRegionAvail().x*0.5f - 4.0f, 40.0f);
                     ImGui::PushStyleColor(ImGuiCol_Button, IM_COL32(40,150,90,255));
                     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, IM_COL32(60,180,110,255));
-                    if (ImGui::Button("Quick LONG", bw)) qo_last = send_quick(true);
+                    if (ImGui::Button("Quick LONG", bw)) qo_last = send_quick(true) + "\n" + qo_last;
                     ImGui::PopStyleColor(2);
                     ImGui::SameLine();
                     ImGui::PushStyleColor(ImGuiCol_Button, IM_COL32(160,60,60,255));
                     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, IM_COL32(190,80,80,255));
-                    if (ImGui::Button("Quick SHORT", bw)) qo_last = send_quick(false);
+                    if (ImGui::Button("Quick SHORT", bw)) qo_last = send_quick(false) + "\n" + qo_last;
                     ImGui::PopStyleColor(2);
 
                     ImGui::Separator();
                     if (ImGui::Button("Flatten ALL (IOC)", ImVec2(-FLT_MIN, 0))) { qo_last = flatten_all() + qo_last; }
+                    if (ImGui::Button("Export latency report", ImVec2(-FLT_MIN, 0))) {
+                        qo_last = std::string(order_tracer().writeReport(kOrderLatencyReportPath) ? "Latency report: " : "Latency report FAILED: ") + kOrderLatencyReportPath + ".csv/.json\n" + qo_last;
+                    }
                     if (!qo_last.empty()) { ImGui::Separator(); ImGui::BeginChild("qo_resp", ImVec2(0,80), true); ImGui::TextUnformatted(qo_last.c_str()); ImGui::EndChild(); }
                 }
                 ImGui::End();
@@ -1540,26 +1773,17 @@ static void RenderOrderBookUI()
                 ImGui::EndTabItem();
             }
             if (ImGui::BeginTabItem("Orders")) {
-                // Parse open orders (auto-refreshed every 1s in background)
+                // Open orders of the chart symbol from the OMS snapshot (pending ones included)
                 struct OO { long long id; std::string side,type,status,pside; double price,origQty,executedQty; long long time; bool reduceOnly; };
                 std::vector<OO> oos;
-                std::string openOrdersSnapshot; int lastStatusOO_snapshot=0; { std::lock_guard<std::mutex> lk(g_ordersMx); openOrdersSnapshot=g_openOrdersBody; lastStatusOO_snapshot=g_lastStatusOO.load(std::memory_order_relaxed); }
-                try {
-                    using nlohmann::json; auto j = json::parse(openOrdersSnapshot, nullptr, false);
-                    if (j.is_array()) {
-                        for (auto &e : j) {
-                            OO x{}; x.id = e.contains("orderId")? e["orderId"].get<long long>() : 0;
-                            x.side = e.value("side", ""); x.type = e.value("type", ""); x.status = e.value("status", "");
-                            x.pside = e.value("positionSide", ""); x.reduceOnly = e.value("reduceOnly", false);
-                            auto getd=[&](const nlohmann::json& v)->double{ if (v.is_string()) return std::stod(v.get<std::string>()); else if(v.is_number()) return v.get<double>(); else return 0.0; };
-                            x.price = e.contains("price")? getd(e["price"]) : 0.0;
-                            x.origQty = e.contains("origQty")? getd(e["origQty"]) : 0.0;
-                            x.executedQty = e.contains("executedQty")? getd(e["executedQty"]) : 0.0;
-                            x.time = e.contains("time")? e["time"].get<long long>() : 0;
-                            oos.push_back(x);
-                        }
+                {
+                    const auto table = order_manager().snapshot();
+                    for (const auto& m : table->orders) {
+                        const auto& o = m.order;
+                        if (o.symbol != g_chartSymbol) continue;
+                        oos.push_back(OO{o.orderId, o.side, o.type, binancerj::core::toString(m.phase), o.positionSide, o.price, o.origQty, o.executedQty, o.updateTimeMs, o.reduceOnly});
                     }
-                } catch (...) {}
+                }
 
                 if (ImGui::BeginTable("OOTable", 9, ImGuiTableFlags_RowBg|ImGuiTableFlags_Borders|ImGuiTableFlags_SizingStretchProp)) {
                     ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_WidthFixed, 110.0f);
@@ -1575,7 +1799,7 @@ static void RenderOrderBookUI()
                     for (size_t i=0;i<oos.size();++i) {
                         auto &x = oos[i];
                         ImGui::TableNextRow();
-                        ImGui::TableSetColumnIndex(0); ImGui::Text("%lld", x.id);
+                        ImGui::TableSetColumnIndex(0); if (x.id > 0) ImGui::Text("%lld", x.id); else ImGui::TextDisabled("pending");
                         // More intuitive side label: LONG/SHORT and Close- semantics
                         {
                             const ImVec4 colBuy(0.2f,0.9f,0.5f,1.0f);
@@ -1598,35 +1822,11 @@ static void RenderOrderBookUI()
                         // Context menu per row
                         ImGui::PushID((int)i);
             if (ImGui::BeginPopupContextItem("oo_ctx")) {
-                            if (ImGui::MenuItem("Cancel")) {
-                                if (s_rest) {
-                                    long long oid = x.id;
-                                    std::thread([oid]{
-                                        try {
-                                            if (!s_rest) return;
-                                            auto r = s_rest->cancelOrder(g_chartSymbol, oid, "", 5000);
-                                            std::cout << "[REST] Cancel order #" << oid << ": status=" << r.status << " ok=" << (r.ok?"true":"false") << "\n" << r.body << std::endl;
-                                            auto r2 = s_rest->getOpenOrders(g_chartSymbol,5000);
-                                            std::lock_guard<std::mutex> lk(g_ordersMx);
-                                            g_lastStatusOO.store(r2.status, std::memory_order_relaxed);
-                                            g_openOrdersBody = r2.body;
-                                        } catch(...){}
-                                    }).detach();
-                                }
+                            if (ImGui::MenuItem("Cancel", nullptr, false, x.id > 0)) {
+                                cancel_order_async(s_rest.get(), g_chartSymbol, x.id);
                             }
                             if (ImGui::MenuItem("Cancel ALL (symbol)")) {
-                                if (s_rest) {
-                                    std::thread([]{
-                                        try {
-                                            auto r = s_rest->cancelAllOpenOrders(g_chartSymbol, 5000);
-                                            std::cout << "[REST] Cancel ALL (" << g_chartSymbol << ") status=" << r.status << " ok=" << (r.ok?"true":"false") << "\n" << r.body << std::endl;
-                                            auto r2=s_rest->getOpenOrders(g_chartSymbol,5000);
-                                            std::lock_guard<std::mutex> lk(g_ordersMx);
-                                            g_lastStatusOO.store(r2.status, std::memory_order_relaxed);
-                                            g_openOrdersBody=r2.body;
-                                        } catch(...){}
-                                    }).detach();
-                                }
+                                cancel_order_async(s_rest.get(), g_chartSymbol, 0);
                             }
                             if (ImGui::MenuItem("Duplicate as LIMIT")) {
                                 snprintf(t_sym, sizeof(t_sym), "%s", g_chartSymbol.c_str());
@@ -1731,14 +1931,9 @@ static long long interval_to_ms(const std::string& iv) {
     for (auto& it : map) if (iv == it.k) return it.v; return 60LL*1000;
 }
 
-static void merge_and_sort_candles(std::vector<Candle>& base, std::vector<Candle>& add) {
-    std::unordered_map<long long, Candle> m;
-    m.reserve(base.size() + add.size());
-    for (auto& c : base) m[c.t0] = c;
-    for (auto& c : add) m[c.t0] = c;
-    base.clear(); base.reserve(m.size());
-    for (auto& kv : m) base.push_back(kv.second);
-    std::sort(base.begin(), base.end(), [](const Candle& a, const Candle& b){ return a.t0 < b.t0; });
+static std::string interval_from_ms(long long ms) {
+    for (const char* iv : {"1m","3m","5m","15m","30m","1h","2h","4h","6h","12h","1d"}) if (interval_to_ms(iv) == ms) return iv;
+    return "1m";
 }
 
 static std::vector<Candle> parse_klines_body(const std::string& body) {
@@ -1762,74 +1957,186 @@ static std::vector<Candle> parse_klines_body(const std::string& body) {
     return out;
 }
 
-static void fetch_klines_parallel(const std::string& symbol, const std::string& iv, int candles) {
-    if (candles <= 0) return;
+// Per symbol/interval on-disk caches, mapped on first use and kept open for instant chart switches
+static binancerj::core::KlineCache& kline_cache_for(const std::string& symbol, const std::string& iv) {
+    static std::mutex mx;
+    static std::map<std::string, std::unique_ptr<binancerj::core::KlineCache>> caches;
+    std::lock_guard<std::mutex> lk(mx);
+    auto& slot = caches[symbol + "_" + iv];
+    if (!slot) {
+        slot = std::make_unique<binancerj::core::KlineCache>("cache/klines", symbol, iv);
+        slot->open();
+    }
+    return *slot;
+}
+
+// Requests the planned segments of [from, to] through the shared scheduler and returns them
+// merged by t0. Closed candles are persisted to the cache; the newest bar is always refreshed.
+// Segments nearest to focusT (the visible edge) are dispatched first.
+static std::vector<Candle> fetch_missing_klines(const std::string& symbol, const std::string& iv,
+                                                binancerj::core::BackfillPlanner& planner,
+                                                long long from, long long to, long long focusT) {
+    const long long ms_per = interval_to_ms(iv);
+    long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    // The newest bar may still be open: always refresh it
+    std::vector<binancerj::core::TimeRange> segs = planner.plan(from, to);
+    long long liveT0 = planner.alignDown(now_ms);
+    if (to >= liveT0 && (segs.empty() || segs.front().to < liveT0)) segs.insert(segs.begin(), binancerj::core::TimeRange{liveT0, liveT0});
+    telemetry::logGauge("chart", "kline_segments", (double)segs.size());
+
+    // Shared weight-aware scheduler: bounded connections, token buckets, visible range first
+    using binancerj::net::RestScheduler;
+    auto& sched = RestScheduler::shared();
+    auto submitSeg = [&](const binancerj::core::TimeRange& seg) {
+        int limit = (int)std::min<long long>(1500, (seg.to - seg.from) / ms_per + 1);
+        long long dist = (focusT < seg.from) ? seg.from - focusT : (focusT > seg.to ? focusT - seg.to : 0);
+        int priority = (int)std::min<long long>(1000, dist / (1500 * ms_per));
+        return sched.submit(RestScheduler::EndpointClass::Market, RestScheduler::klinesWeight(limit), priority,
+            [symbol, iv, seg, ms_per, limit](BinanceRest& rest){ return rest.getKlines(symbol, iv, seg.from, seg.to + ms_per - 1, limit); });
+    };
+    std::vector<std::future<BinanceRest::Result>> futs;
+    futs.reserve(segs.size());
+    for (auto seg : segs) futs.push_back(submitSeg(seg));
+    // A failed chunk is logged and planned once more: the scheduler holds the retry until the
+    // governor's back-off is over. A chunk that fails again stays a gap the next load re-plans.
+    constexpr int kChunkAttempts = 2;
+    std::vector<std::vector<Candle>> parts(segs.size());
+    std::vector<size_t> pending(segs.size());
+    for (size_t i = 0; i < pending.size(); ++i) pending[i] = i;
+    for (int attempt = 1; !pending.empty(); ++attempt) {
+        std::vector<size_t> retry;
+        for (size_t i : pending) {
+            BinanceRest::Result r;
+            try { r = futs[i].get(); } catch (const std::exception& ex) { r.ok = false; r.status = -1; r.body = ex.what(); }
+            if (r.ok) { parts[i] = parse_klines_body(r.body); continue; }
+            const bool again = attempt < kChunkAttempts && (r.status < 0 || r.status == 429 || r.status == 418 || r.status >= 500);
+            telemetry::logEvent("chart", std::string(again ? "kline_chunk_retry" : "kline_chunk_failed") + " symbol=" + symbol + " interval=" + iv
+                + " from=" + std::to_string(segs[i].from) + " to=" + std::to_string(segs[i].to)
+                + " status=" + std::to_string(r.status) + " body=" + r.body.substr(0, 200));
+            if (again) { futs[i] = submitSeg(segs[i]); retry.push_back(i); }
+        }
+        pending.swap(retry);
+    }
+    // Each chunk is already sorted by t0: one k-way merge over all of them
+    std::vector<Candle> fetched;
+    {
+        std::vector<const std::vector<Candle>*> runs;
+        runs.reserve(parts.size());
+        // segs are newest-first; feed runs oldest-first (order only matters for duplicate t0)
+        for (auto it = parts.rbegin(); it != parts.rend(); ++it) runs.push_back(&*it);
+        binancerj::core::mergeSortedRuns(runs, fetched);
+    }
+    if (!fetched.empty()) {
+        // Persist closed candles only; the live one keeps changing
+        std::vector<Candle> closed;
+        closed.reserve(fetched.size());
+        for (auto& c : fetched) if (c.t1 < now_ms) closed.push_back(c);
+        kline_cache_for(symbol, iv).store(closed);
+    }
+    return fetched;
+}
+
+// Loads [from, to] for symbol/interval: cache hits are merged first, then only the ranges
+// neither memory nor cache has are requested. Results merge into g_candles in place.
+static void backfill_klines(const std::string& symbol, const std::string& iv, long long from, long long to, long long focusT) {
+    if (to < from) return;
     g_chartLoading = true;
-    std::thread([symbol, iv, candles]{
-        BinanceRest rest("fapi.binance.com");
-        rest.setInsecureTLS(false);
+    if (interval_to_ms(iv) == g_pyramid.baseIntervalMs()) g_pyramid.expect(symbol);
+    std::thread([symbol, iv, from, to, focusT]{
         const long long ms_per = interval_to_ms(iv);
-        const int max_per_req = 1500;
-        // Determine overall time range
-        long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-        long long total_span = (long long)candles * ms_per;
-        long long start = now_ms - total_span;
-        if (start < 0) start = 0;
-        // Build chunks of <= max_per_req candles (in chronological order)
-        struct Seg { long long a; long long b; };
-        std::vector<Seg> segs;
-        int remaining = candles;
-        long long seg_end = now_ms;
-        while (remaining > 0) {
-            int take = std::min(remaining, max_per_req);
-            long long seg_start = seg_end - (long long)take * ms_per;
-            if (seg_start < start) seg_start = start;
-            segs.push_back(Seg{seg_start, seg_end});
-            seg_end = seg_start;
-            remaining -= take;
-        }
-        // Fetch concurrently (limit parallelism)
-        std::vector<std::future<std::vector<Candle>>> futs;
-        futs.reserve(segs.size());
-        for (size_t i = 0; i < segs.size(); ++i) {
-            auto seg = segs[i];
-            futs.push_back(std::async(std::launch::async, [symbol, iv, seg](){
-                BinanceRest lr("fapi.binance.com");
-                lr.setInsecureTLS(false);
-                auto r = lr.getKlines(symbol, iv, seg.a, seg.b, 1500);
-                if (!r.ok) return std::vector<Candle>{};
-                return parse_klines_body(r.body);
-            }));
-        }
-        std::vector<Candle> merged;
-        for (auto& f : futs) {
-            try {
-                auto part = f.get();
-                if (!part.empty()) merge_and_sort_candles(merged, part);
-            } catch (...) {}
+        const std::string key = symbol + "_" + iv;
+        auto& cache = kline_cache_for(symbol, iv);
+        binancerj::core::BackfillPlanner planner(ms_per, 1500);
+
+        // Cached rows first so the chart switches immediately
+        std::vector<Candle> cached;
+        cache.read(planner.alignDown(from), to, cached);
+        planner.addCoverage(cached);
+        {
+            std::lock_guard<std::mutex> lk(g_candlesMutex);
+            if (g_candlesKey != key) { g_candles.clear(); g_candlesKey = key; }
+            if (!cached.empty()) binancerj::core::mergeCandlesInto(g_candles, cached);
+            planner.addCoverage(g_candles);
         }
-        if (!merged.empty()) {
+        std::vector<Candle> fetched = fetch_missing_klines(symbol, iv, planner, from, to, focusT);
+        std::vector<Candle> base;
+        {
             std::lock_guard<std::mutex> lk(g_candlesMutex);
-            g_candles.swap(merged);
+            if (g_candlesKey == key) {
+                if (!fetched.empty()) binancerj::core::mergeCandlesInto(g_candles, fetched);
+                if (ms_per == g_pyramid.baseIntervalMs()) base = g_candles;
+            }
         }
+        // A base-interval load doubles as the pyramid base: every coarser interval follows it
+        if (!base.empty()) g_pyramid.reset(symbol, std::move(base));
         g_chartLoading = false;
     }).detach();
 }
 
+// Loads the most recent `bars` base-interval candles into the pyramid (cache first) when the
+// chart shows a coarser interval, so its live tail and instant interval switches have a base.
+static void load_pyramid_base(const std::string& symbol, int bars) {
+    g_pyramid.expect(symbol); // live 1m bars received during the download are replayed by reset()
+    std::thread([symbol, bars]{
+        const long long ms_per = g_pyramid.baseIntervalMs();
+        const std::string iv = "1m";
+        long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        long long from = std::max(0LL, now_ms - (long long)bars * ms_per);
+        binancerj::core::BackfillPlanner planner(ms_per, 1500);
+        std::vector<Candle> base;
+        kline_cache_for(symbol, iv).read(planner.alignDown(from), now_ms, base);
+        planner.addCoverage(base);
+        std::vector<Candle> fetched = fetch_missing_klines(symbol, iv, planner, from, now_ms, now_ms);
+        binancerj::core::mergeCandlesInto(base, fetched);
+        g_pyramid.reset(symbol, std::move(base));
+        // Derived bars cover the recent end of the visible interval: fold them in
+        const long long ivMs = g_chartIntervalMs.load();
+        std::vector<Candle> derived;
+        if (g_pyramid.copyLevel(symbol, ivMs, derived)) {
+            std::lock_guard<std::mutex> lk(g_candlesMutex);
+            if (g_candlesKey == symbol + "_" + interval_from_ms(ivMs)) binancerj::core::mergeCandlesInto(g_candles, derived);
+        }
+    }).detach();
+}
+
+static void fetch_klines_parallel(const std::string& symbol, const std::string& iv, int candles) {
+    if (candles <= 0) return;
+    long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    long long start = std::max(0LL, now_ms - (long long)candles * interval_to_ms(iv));
+    backfill_klines(symbol, iv, start, now_ms, now_ms);
+}
+
+// Extends history to the left when the view scrolls before the oldest loaded candle
+static void extend_history_left(const std::string& symbol, const std::string& iv, long long viewT0, long long oldestT0) {
+    if (g_chartLoading || viewT0 >= oldestT0) return;
+    const long long ms_per = interval_to_ms(iv);
+    // Fetch at least one request worth so small pans do not trickle single bars
+    long long from = std::min(viewT0, oldestT0 - 1500 * ms_per);
+    backfill_klines(symbol, iv, std::max(0LL, from), oldestT0 - ms_per, oldestT0);
+}
+
+// Streams the pyramid's base interval; the displayed interval is derived from it, so
+// interval switches never resubscribe. A newer stream retires the previous one.
 static void StartOrRestartKlineStream(const std::string& symbolLower, const std::string& interval) {
     static std::string lastKey;
+    static std::atomic<int> generation{0};
     std::string key = symbolLower + "@kline_" + interval;
     if (g_chartStreamRunning.load() && key == lastKey) return;
     lastKey = key;
+    const int gen = ++generation;
     g_chartStreamRunning.store(true);
-    std::thread([key]{
+    std::string symbolUpper = symbolLower; std::transform(symbolUpper.begin(), symbolUpper.end(), symbolUpper.begin(), ::toupper);
+    std::thread([key, symbolUpper, interval, gen]{
         try {
-            WebSocket ws("fstream.binance.com", "443");
+            WebSocket ws(binancerj::net::Endpoints::get().streamHost, binancerj::net::Endpoints::get().streamPort);
             ws.connect();
             std::string sub = std::string("{\"method\":\"SUBSCRIBE\",\"params\":[\"") + key + "\"],\"id\":1234}";
             ws.send(sub);
-            for (;;) {
+            const long long streamMs = interval_to_ms(interval);
+            while (generation.load() == gen) {
                 std::string msg = ws.receive();
                 if (msg.empty()) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); continue; }
                 try {
@@ -1847,10 +2154,18 @@ static void StartOrRestartKlineStream(const std::string& symbolLower, const std:
                     double v = std::stod(k["v"].get<std::string>());
                     bool kx = k["x"].get<bool>(); // closed
                     Candle nc{t0,t1,o,h,l,c,v};
-                    {
+                    // O(1) per pyramid level; the chart takes the bar of the interval it shows
+                    g_pyramid.update(symbolUpper, nc);
+                    const long long ivMs = g_chartIntervalMs.load();
+                    Candle shown = nc;
+                    if (ivMs == streamMs || g_pyramid.latest(symbolUpper, ivMs, shown)) {
                         std::lock_guard<std::mutex> lk(g_candlesMutex);
-                        if (!g_candles.empty() && g_candles.back().t0 == t0) g_candles.back() = nc;
-                        else if (g_candles.empty() || g_candles.back().t0 < t0) g_candles.push_back(nc);
+                        if (g_candlesKey == symbolUpper + "_" + interval_from_ms(ivMs)) binancerj::core::upsertCandle(g_candles, shown);
+                    }
+                    if (kx) {
+                        // Append only when it extends the cached run without a hole
+                        auto& cache = kline_cache_for(symbolUpper, interval);
+                        if (!cache.empty() && cache.lastOpenTime() + streamMs == t0) cache.store(std::vector<Candle>{nc});
                     }
                 } catch (...) {}
             }
@@ -1869,7 +2184,7 @@ static void StartOrRestartAggTradeStream(const std::string& symbolLower)
     lastSym = symbolLower;
     std::thread([symbolLower]{
         try {
-            WebSocket ws("fstream.binance.com", "443");
+            WebSocket ws(binancerj::net::Endpoints::get().streamHost, binancerj::net::Endpoints::get().streamPort);
             ws.connect();
             std::string sub = std::string("{\"method\":\"SUBSCRIBE\",\"params\":[\"") + symbolLower + "@aggTrade\"],\"id\":2233}";
             ws.send(sub);
@@ -1917,21 +2232,56 @@ static void RenderChartWindow()
     static int histCandles = 10000;
     static bool showSMA = true; static int sma1=7,sma2=25,sma3=99; static bool showBB=false; static int bbLen=20; static float bbK=2.0f;
     static bool showVol = true; static bool showCross = true; static bool showRSI=false; static int rsiLen=14; static bool showMACD=false; static int macdFast=12, macdSlow=26, macdSig=9;
+    static bool showFootprint = false; static bool showProfile = false; static double fpBucket = 10.0; // price bucket width (quote units), tick-sized on Load
     ImGui::SetNextItemWidth(120);
     ImGui::InputText("Symbol", symBuf, sizeof(symBuf));
     ImGui::SameLine(); ImGui::SetNextItemWidth(100);
-    ImGui::Combo("Interval", &ivIdx, intervals, IM_ARRAYSIZE(intervals));
+    if (ImGui::Combo("Interval", &ivIdx, intervals, IM_ARRAYSIZE(intervals))) {
+        // Instant switch: derive from the loaded base, then backfill older history behind it
+        std::string sym; { std::lock_guard<std::mutex> lk(g_chartSymbolMutex); sym = g_chartSymbol; }
+        std::vector<Candle> derived;
+        const long long ivMs = interval_to_ms(intervals[ivIdx]);
+        if (!g_chartLoading && g_pyramid.copyLevel(sym, ivMs, derived)) {
+            g_chartInterval = intervals[ivIdx];
+            g_chartIntervalMs.store(ivMs);
+            g_footprint.reset(fpBucket, ivMs);
+            {
+                std::lock_guard<std::mutex> lk(g_candlesMutex);
+                g_candles.swap(derived);
+                g_candlesKey = sym + "_" + g_chartInterval;
+            }
+            fetch_klines_parallel(sym, g_chartInterval, std::max(100, histCandles));
+        } else {
+            // Refused (loading, or no base yet): keep the combo on the interval actually drawn
+            for (int i = 0; i < IM_ARRAYSIZE(intervals); ++i) if (g_chartInterval == intervals[i]) ivIdx = i;
+        }
+    }
     ImGui::SameLine(); ImGui::SetNextItemWidth(110); ImGui::InputInt("History", &histCandles); ImGui::SameLine(); ImGui::TextUnformatted("candles");
     if (ImGui::Button(g_chartLoading?"Loading...":"Load", ImVec2(120,0))) {
         if (!g_chartLoading) {
             {
                 std::lock_guard<std::mutex> lk(g_chartSymbolMutex);
                 g_chartSymbol = symBuf;
+                g_chartSymbolId.store(binancerj::core::SymbolTable::instance().intern(g_chartSymbol), std::memory_order_release);
             }
             g_chartInterval = intervals[ivIdx];
-            fetch_klines_parallel(g_chartSymbol, g_chartInterval, std::max(100, histCandles));
+            g_chartIntervalMs.store(interval_to_ms(g_chartInterval));
             std::string symLower = g_chartSymbol; std::transform(symLower.begin(), symLower.end(), symLower.begin(), ::tolower);
-            StartOrRestartKlineStream(symLower, g_chartInterval);
+            fpBucket = chart_filters().tick * kFootprintTicksPerBucket;
+            {
+                // Footprint, stats and tape follow the chart symbol's own trade stream
+                std::lock_guard<std::mutex> feed(g_tradeFeedMutex);
+                StartOrRestartTradeStream(symLower);
+                g_footprint.reset(fpBucket, interval_to_ms(g_chartInterval));
+                g_tradeStats.reset();
+                // Size quantiles restart too: the slot may hold a stale distribution from an earlier visit
+                const auto slot = g_chartSymbolId.load(std::memory_order_acquire);
+                if (slot != binancerj::core::kNoSymbol) g_sweeps.reset((std::uint16_t)slot);
+            }
+            fetch_klines_parallel(g_chartSymbol, g_chartInterval, std::max(100, histCandles));
+            // Coarser intervals need their own base load (a 1m load becomes the base itself)
+            if (g_chartIntervalMs.load() != g_pyramid.baseIntervalMs()) load_pyramid_base(g_chartSymbol, kPyramidBaseBars);
+            StartOrRestartKlineStream(symLower, "1m");
         }
     }
 
@@ -1949,8 +2299,21 @@ static void RenderChartWindow()
         ImGui::SameLine(); ImGui::SetNextItemWidth(60); ImGui::InputInt("BBn", &bbLen);
         ImGui::SameLine(); ImGui::SetNextItemWidth(60); ImGui::InputFloat("BBk", &bbK);
     }
-    // Big trade threshold (base asset qty) for 3s text overlay
-    static double uiBigTradeQty = 1.0; ImGui::SameLine(); ImGui::SetNextItemWidth(80); ImGui::InputDouble("BigQty", &uiBigTradeQty);
+    // Big trade / sweep overlay threshold is adaptive (p99 of taker order size)
+    { const auto slot = g_chartSymbolId.load(std::memory_order_acquire); double thr = slot != binancerj::core::kNoSymbol ? g_sweeps.threshold((std::uint16_t)slot) : 0.0; ImGui::SameLine(); if (thr > 0.0) ImGui::Text("Big>=%.3f (p99)", thr); else ImGui::TextUnformatted("Big: warming up"); }
+    static bool showVwap = false; ImGui::SameLine(); ImGui::Checkbox("VWAP", &showVwap);
+    if (showVwap) {
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Anchor")) {
+            g_tradeStats.anchor(binancerj::net::ClockSync::instance().serverTimeMs());
+        }
+        ImGui::SameLine(); if (ImGui::SmallButton("Session")) g_tradeStats.anchor(0);
+    }
+    ImGui::SameLine(); ImGui::Checkbox("Footprint", &showFootprint); ImGui::SameLine(); ImGui::Checkbox("VolProfile", &showProfile);
+    if (showFootprint || showProfile) {
+        ImGui::SameLine(); ImGui::SetNextItemWidth(80);
+        if (ImGui::InputDouble("FpBucket", &fpBucket) && fpBucket > 0.0) g_footprint.reset(fpBucket, interval_to_ms(g_chartInterval));
+    }
     // (A) button moved to chart overlay bottom-right
 
     // Chart area
@@ -1981,7 +2344,10 @@ static void RenderChartWindow()
         auto clamp_view = [&]{ if (viewT0 >= viewT1) { viewT1 = viewT0 + ms_per; } };
         clamp_view();
         auto t_to_x = [&](long long t){ double a = double(t - viewT0) / double(viewT1 - viewT0); return p0.x + (float)(a * (p1.x - p0.x)); };
-        auto price_minmax = [&](long long a, long long b){ double mn=1e300,mx=-1e300; for (auto& k:cs){ if (k.t1<a||k.t0>b) continue; mn=std::min(mn,k.l); mx=std::max(mx,k.h);} if (mx<mn){mn=0;mx=1;} return std::pair<double,double>(mn,mx); };
+        // LOD tree over the snapshot: O(log n) range queries, bounded bars per frame
+        static binancerj::core::CandleLod s_lod;
+        s_lod.sync(cs);
+        auto price_minmax = [&](long long a, long long b){ double mn=0, mx=1; if (!s_lod.priceRange(a, b, mn, mx)) { mn=0; mx=1; } return std::pair<double,double>(mn,mx); };
         auto [pmin,pmax] = price_minmax(viewT0, viewT1);
         double pad = (pmax - pmin) * 0.05; if (pad<=0) pad=1.0; pmin-=pad; pmax+=pad;
         if (!s_priceManual || s_viewPmax <= s_viewPmin) { s_viewPmin = pmin; s_viewPmax = pmax; }
@@ -2158,50 +2524,20 @@ static void RenderChartWindow()
             if ((io3.KeyShift && ImGui::IsMouseDown(ImGuiMouseButton_Left) && ImGui::IsMouseHoveringRect(p0, p1)) || s_chartSelEditing)
                 s_disableInteractions = true;
         }
-        static std::unique_ptr<BinanceRest> s_restChart(new BinanceRest("fapi.binance.com"));
+        static std::unique_ptr<BinanceRest> s_restChart(new BinanceRest(binancerj::net::Endpoints::get().restHost));
         if (s_restChart) s_restChart->setInsecureTLS(false);
-        // Helpers: refresh + lookup + wait for cancellation completion
-        auto refresh_open_orders = [&](){ if (s_disableInteractions) return; 
-            if (!s_restChart) return;
-            auto r2 = s_restChart->getOpenOrders(g_chartSymbol, 5000);
-            std::lock_guard<std::mutex> lk(g_ordersMx);
-            g_openOrdersBody = r2.body;
-            g_lastStatusOO.store(r2.status, std::memory_order_relaxed);
-        };
-        auto is_order_present = [&](long long oid)->bool{ if (s_disableInteractions) return false; 
-            std::string snapshot; { std::lock_guard<std::mutex> lk(g_ordersMx); snapshot = g_openOrdersBody; }
-            try{ using nlohmann::json; auto j=json::parse(snapshot,nullptr,false); if(j.is_array()){ for(auto &e:j){ if(e.contains("orderId") && e["orderId"].is_number_integer()){ long long id=e["orderId"].get<long long>(); if(id==oid) return true; } } } }catch(...){}
-            return false;
-        };
-        auto wait_cancelled = [&](long long oid,int timeoutMs)->bool{ if (s_disableInteractions) return false; 
-            using namespace std::chrono; auto t0=steady_clock::now();
-            for(;;){ refresh_open_orders(); if(!is_order_present(oid)) return true; std::this_thread::sleep_for(std::chrono::milliseconds(60)); if(duration_cast<milliseconds>(steady_clock::now()-t0).count()>timeoutMs) break; }
-            return false;
-        };
-        auto cancel_order_id = [&](long long oid)->bool{ if (s_disableInteractions) return false; 
-            if (!s_restChart || oid<=0) return false;
-            auto r = s_restChart->cancelOrder(g_chartSymbol, oid, "", 5000);
-            std::cout << "[REST] Cancel order #" << oid << ": status=" << r.status << " ok=" << (r.ok?"true":"false") << "\n" << r.body << std::endl;
-            refresh_open_orders();
-            return r.ok && r.status>=200 && r.status<300;
-        };
+        // Cancels go out on the client's I/O thread; the open orders follow from the user data stream
         auto async_cancel = [&](long long oid){ if (s_disableInteractions) return; 
-            std::thread([=]{
-                try {
-                    if (!s_restChart) return;
-                    auto r = s_restChart->cancelOrder(g_chartSymbol, oid, "", 5000);
-                    std::cout << "[REST] Cancel order #" << oid << ": status=" << r.status << " ok=" << (r.ok?"true":"false") << "\n" << r.body << std::endl;
-                    refresh_open_orders();
-                } catch(...){}
-            }).detach();
+            if (oid > 0) cancel_order_async(s_restChart.get(), g_chartSymbol, oid);
         };
         auto async_cancel_replace = [&](long long oid, const std::string side, double qty, double newPrice, const std::string posSide, bool reduceOnly){ if (s_disableInteractions) return; 
             std::thread([=]{
                 try {
                     if (!s_restChart) return;
                     // Round price to tick and qty to step for safety
-                    double tick = g_priceTick.load(std::memory_order_relaxed); if (tick <= 0.0) tick = 0.1;
-                    double step = g_qtyStep.load(std::memory_order_relaxed); if (step <= 0.0) step = 0.001;
+                    const ChartFilters filters = chart_filters();
+                    double tick = filters.tick;
+                    double step = filters.step;
                     double pRounded = std::floor((newPrice + 1e-12) / tick) * tick;
                     double qRounded = std::floor((qty + 1e-12) / step) * step;
                     if (qRounded <= 0.0) return;
@@ -2217,43 +2553,33 @@ static void RenderChartWindow()
                         reduceOnly,
                         posSide,
                         std::string("STOP_ON_FAILURE"),
-                        5000);
+                        order_recv_window());
                     std::cout << "[REST] CancelReplace #" << oid << ": status=" << r.status << " ok=" << (r.ok?"true":"false") << "\n" << r.body << std::endl;
                     if (!r.ok) {
                         // Fallback: cancel then place
-                        auto rc = s_restChart->cancelOrder(g_chartSymbol, oid, "", 5000);
+                        auto rc = s_restChart->cancelOrder(g_chartSymbol, oid, "", order_recv_window());
                         std::cout << "[REST] Fallback Cancel #" << oid << ": status=" << rc.status << " ok=" << (rc.ok?"true":"false") << "\n" << rc.body << std::endl;
                         if (rc.ok) {
-                            auto rp = s_restChart->placeOrder(g_chartSymbol, side, "LIMIT", qRounded, pRounded, "GTC", reduceOnly, false, 5000, posSide, 0.0, "MARK_PRICE");
-                            std::cout << "[REST] Fallback Place (" << side << ") status=" << rp.status << " ok=" << (rp.ok?"true":"false") << "\n" << rp.body << std::endl;
+                            BinanceRest::OrderRequest o;
+                            o.symbol = g_chartSymbol; o.side = side; o.type = "LIMIT"; o.quantity = qRounded; o.price = pRounded; o.timeInForce = "GTC";
+                            o.reduceOnly = reduceOnly; o.positionSide = posSide; o.workingType = "MARK_PRICE";
+                            std::cout << "[REST] Fallback Place (" << side << ") " << queue_order(o, kAckChart, "Fallback Place " + side + ": ") << std::endl;
                         }
                     }
-                    refresh_open_orders();
                 } catch(...) {}
             }).detach();
         };
-        // Parse open orders snapshot once per frame
+        // Open orders of the chart symbol from the OMS snapshot, once per frame. Pending orders
+        // have no exchange id yet and are left out of the interactive lines.
         struct OO { long long id; std::string clientId; std::string side,type,status,pside; double price,origQty,executedQty; bool reduceOnly; };
         std::vector<OO> oos;
         {
-            std::string snapshot; { std::lock_guard<std::mutex> lk(g_ordersMx); snapshot = g_openOrdersBody; }
-            try {
-                using nlohmann::json; auto j = json::parse(snapshot, nullptr, false);
-                if (j.is_array()) {
-                    for (auto &e : j) {
-                        OO x{}; x.id = e.value("orderId", 0LL); x.clientId = e.value("clientOrderId", std::string(""));
-                        x.side = e.value("side", ""); x.type = e.value("type", ""); x.status = e.value("status", "");
-                        x.pside = e.value("positionSide", ""); x.reduceOnly = e.value("reduceOnly", false);
-                        auto getd=[&](const nlohmann::json& v)->double{ if (v.is_string()) return std::stod(v.get<std::string>()); else if(v.is_number()) return v.get<double>(); else return 0.0; };
-                        x.price = e.contains("price")? getd(e["price"]) : 0.0;
-                        x.origQty = e.contains("origQty")? getd(e["origQty"]) : 0.0;
-                        x.executedQty = e.contains("executedQty")? getd(e["executedQty"]) : 0.0;
-                        // Only current symbol
-                        // Note: endpoint already filtered by current symbol in poller
-                        oos.push_back(x);
-                    }
-                }
-            } catch(...) {}
+            const auto table = order_manager().snapshot();
+            for (const auto& m : table->orders) {
+                const auto& o = m.order;
+                if (o.orderId <= 0 || o.symbol != g_chartSymbol) continue;
+                oos.push_back(OO{o.orderId, o.clientOrderId, o.side, o.type, binancerj::core::toString(m.phase), o.positionSide, o.price, o.origQty, o.executedQty, o.reduceOnly});
+            }
         }
         // Drag state for order lines
         static bool s_draggingOrder = false;
@@ -2309,6 +2635,14 @@ static void RenderChartWindow()
                 s_viewPmax = prMaxStart + dPrice;
             }
         }
+        // Scrolled/zoomed past the oldest candle: backfill only the missing history (once per edge)
+        {
+            static long long s_histReqOldest = 0;
+            if (viewT0 < cs.front().t0 && s_histReqOldest != cs.front().t0 && !g_chartLoading) {
+                s_histReqOldest = cs.front().t0;
+                extend_history_left(g_chartSymbol, g_chartInterval, viewT0, cs.front().t0);
+            }
+        }
 
         // Background grid removed (price grid still drawn by labels below)
 
@@ -2439,14 +2773,17 @@ static void RenderChartWindow()
 
         // Per-candle cumulative BUY/SELL overlay near most recent candle (right side)
         {
-            std::vector<PubTrade> tr2; { std::lock_guard<std::mutex> lk(tradesMutex); tr2 = g_trades; }
             long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::system_clock::now().time_since_epoch()).count();
             double buySum=0.0, sellSum=0.0;
             const Candle &lc = cs.back();
             long long cStart = lc.t0;
             long long cEnd   = std::min<long long>(now_ms, lc.t1);
-            for (auto &t : tr2) { if (t.ts >= cStart && t.ts <= cEnd) { if (t.isBuy) buySum += t.qty; else sellSum += t.qty; } }
+            // Prepared per-candle totals; scan the tape only if the aggregator is bucketed for another interval
+            if (!g_footprint.candleTotals(lc.t0, buySum, sellSum)) {
+                std::lock_guard<std::mutex> lk(tradesMutex);
+                for (auto &t : g_trades) { if (t.ts >= cStart && t.ts <= cEnd) { if (t.isBuy) buySum += t.qty; else sellSum += t.qty; } }
+            }
             float xLast = t_to_x((long long)((lc.t0 + lc.t1)/2));
             float yMid  = p_to_y((lc.h + lc.l) * 0.5);
             // compute overlay width using two lines
@@ -2509,12 +2846,13 @@ static void RenderChartWindow()
         float px_per_ms = (p1.x - p0.x) / (float)(viewT1 - viewT0);
         float barW = std::max(1.0f, (float)(ms_per * px_per_ms * 0.6f));
         ImU32 colUp = IM_COL32(40,200,140,255), colDn = IM_COL32(220,80,80,255);
-        // Draw candles in view (early exit when out of range)
-        for (auto& k: cs) {
-            if (k.t1 < viewT0) continue;
-            if (k.t0 > viewT1) break;
+        // Draw candles in view: at most one (aggregated) bar per pixel column
+        static std::vector<Candle> s_lodBars;
+        s_lod.decimate(viewT0, viewT1, (size_t)std::max(1.0f, p1.x - p0.x), s_lodBars);
+        for (auto& k: s_lodBars) {
             float x = t_to_x((long long)((k.t0 + k.t1)/2));
-            float x0 = x - barW*0.5f, x1 = x + barW*0.5f;
+            float w = std::max(1.0f, (float)((k.t1 - k.t0 + 1) * px_per_ms * 0.6f));
+            float x0 = x - w*0.5f, x1 = x + w*0.5f;
             float yO = p_to_y(k.o), yC = p_to_y(k.c), yH = p_to_y(k.h), yL = p_to_y(k.l);
             ImU32 col = (k.c >= k.o) ? colUp : colDn;
             // wick
@@ -2527,6 +2865,91 @@ static void RenderChartWindow()
             }
         }
 
+        // Footprint: per-candle buy (right) / sell (left) volume per price bucket
+        if (showFootprint && barW >= 6.0f) {
+            static std::vector<binancerj::core::FootprintAggregator::CandleFootprint> s_fp;
+            static std::uint64_t s_fpVer = 0; static long long s_fpT0 = 0, s_fpT1 = 0;
+            if (g_footprint.version() != s_fpVer || s_fpT0 != viewT0 || s_fpT1 != viewT1) {
+                s_fpVer = g_footprint.copyCandles(viewT0, viewT1, s_fp); s_fpT0 = viewT0; s_fpT1 = viewT1;
+            }
+            const double bsz = g_footprint.bucketSize();
+            const float halfW = barW * 0.5f + 2.0f;
+            for (auto& f : s_fp) {
+                if (f.maxBucketVolume <= 0.0) continue;
+                float x = t_to_x(f.t0 + ms_per / 2);
+                for (size_t i = 0; i < f.buy.size(); ++i) {
+                    double b = f.buy[i], sv = f.sell[i];
+                    if (b <= 0.0 && sv <= 0.0) continue;
+                    double lo = (double)(f.firstBucket + (long long)i) * bsz;
+                    float yTop = p_to_y(lo + bsz), yBot = p_to_y(lo);
+                    if (yBot < p0.y || yTop > p1.y) continue;
+                    if (yBot - yTop > 3.0f) { yTop += 0.5f; yBot -= 0.5f; }
+                    if (b > 0.0)  dl->AddRectFilled(ImVec2(x, yTop), ImVec2(x + halfW * (float)(b / f.maxBucketVolume), yBot), IM_COL32(40,200,140,110));
+                    if (sv > 0.0) dl->AddRectFilled(ImVec2(x - halfW * (float)(sv / f.maxBucketVolume), yTop), ImVec2(x, yBot), IM_COL32(220,80,80,110));
+                    if (barW >= 60.0f && yBot - yTop >= ImGui::GetFontSize()) {
+                        char fb[48]; snprintf(fb, sizeof(fb), "%.2f x %.2f", sv, b);
+                        ImVec2 tsz = ImGui::CalcTextSize(fb);
+                        dl->AddText(ImVec2(x - tsz.x * 0.5f, (yTop + yBot - tsz.y) * 0.5f), IM_COL32(230,230,230,200), fb);
+                    }
+                }
+            }
+        }
+
+        // Session volume profile (left edge) with POC line and value area band
+        if (showProfile) {
+            static binancerj::core::FootprintAggregator::SessionProfile s_vp;
+            static std::uint64_t s_vpVer = 0;
+            if (g_footprint.version() != s_vpVer) s_vpVer = g_footprint.copySession(s_vp);
+            if (s_vp.pocVolume > 0.0) {
+                const double bsz = g_footprint.bucketSize();
+                const float maxW = (p1.x - p0.x) * 0.18f;
+                float vaTop = p_to_y((double)(s_vp.valueAreaHigh + 1) * bsz), vaBot = p_to_y((double)s_vp.valueAreaLow * bsz);
+                dl->AddRectFilled(ImVec2(p0.x, vaTop), ImVec2(p0.x + maxW, vaBot), IM_COL32(120,120,200,28));
+                for (size_t i = 0; i < s_vp.buy.size(); ++i) {
+                    double b = s_vp.buy[i], sv = s_vp.sell[i];
+                    if (b + sv <= 0.0) continue;
+                    long long bucket = s_vp.firstBucket + (long long)i;
+                    float yTop = p_to_y((double)(bucket + 1) * bsz), yBot = p_to_y((double)bucket * bsz);
+                    if (yBot < p0.y || yTop > p1.y) continue;
+                    if (yBot - yTop > 3.0f) { yTop += 0.5f; yBot -= 0.5f; }
+                    bool inVa = bucket >= s_vp.valueAreaLow && bucket <= s_vp.valueAreaHigh;
+                    float wB = maxW * (float)(b / s_vp.pocVolume), wS = maxW * (float)(sv / s_vp.pocVolume);
+                    dl->AddRectFilled(ImVec2(p0.x, yTop), ImVec2(p0.x + wB, yBot), inVa ? IM_COL32(40,200,140,120) : IM_COL32(40,200,140,60));
+                    dl->AddRectFilled(ImVec2(p0.x + wB, yTop), ImVec2(p0.x + wB + wS, yBot), inVa ? IM_COL32(220,80,80,120) : IM_COL32(220,80,80,60));
+                }
+                float yPoc = p_to_y(((double)s_vp.pocBucket + 0.5) * bsz);
+                dl->AddLine(ImVec2(p0.x, yPoc), ImVec2(p1.x, yPoc), IM_COL32(255,200,0,160), 1.0f);
+                char pb[64]; snprintf(pb, sizeof(pb), "POC %.2f", ((double)s_vp.pocBucket + 0.5) * bsz);
+                dl->AddText(ImVec2(p0.x + 4.0f, yPoc - ImGui::GetFontSize() - 1.0f), IM_COL32(255,200,0,220), pb);
+            }
+        }
+
+        // VWAP with 1/2 sigma bands and tape stats panel (top-left)
+        if (showVwap) {
+            const auto st = g_tradeStats.snapshot(binancerj::net::ClockSync::instance().serverTimeMs()); // trade times are exchange time
+            if (st.volume > 0.0) {
+                auto hline = [&](double price, ImU32 col, float th){ float y = p_to_y(price); if (y >= p0.y && y <= p1.y) dl->AddLine(ImVec2(p0.x, y), ImVec2(p1.x, y), col, th); };
+                float yB2 = p_to_y(st.band(2.0)), yL2 = p_to_y(st.band(-2.0));
+                float yB1 = p_to_y(st.band(1.0)), yL1 = p_to_y(st.band(-1.0));
+                dl->AddRectFilled(ImVec2(p0.x, yB2), ImVec2(p1.x, yL2), IM_COL32(180,120,255,14));
+                dl->AddRectFilled(ImVec2(p0.x, yB1), ImVec2(p1.x, yL1), IM_COL32(180,120,255,18));
+                hline(st.band(2.0), IM_COL32(180,120,255,90), 1.0f); hline(st.band(-2.0), IM_COL32(180,120,255,90), 1.0f);
+                hline(st.band(1.0), IM_COL32(180,120,255,130), 1.0f); hline(st.band(-1.0), IM_COL32(180,120,255,130), 1.0f);
+                hline(st.vwap, IM_COL32(200,140,255,230), 1.8f);
+            }
+            char sb[256];
+            const auto& w1 = st.windows[0]; const auto& w10 = st.windows[1]; const auto& w60 = st.windows[2];
+            snprintf(sb, sizeof(sb), "VWAP %.2f  sd %.2f  CVD %+.3f\n1s  B %.3f / S %.3f  (%llu/%llu)\n10s B %.3f / S %.3f  (%llu/%llu)\n60s B %.3f / S %.3f  (%llu/%llu)",
+                st.vwap, st.stdev, st.cvd,
+                w1.buyVolume, w1.sellVolume, (unsigned long long)w1.buyCount, (unsigned long long)w1.sellCount,
+                w10.buyVolume, w10.sellVolume, (unsigned long long)w10.buyCount, (unsigned long long)w10.sellCount,
+                w60.buyVolume, w60.sellVolume, (unsigned long long)w60.buyCount, (unsigned long long)w60.sellCount);
+            ImVec2 tsz = ImGui::CalcTextSize(sb);
+            ImVec2 tp(p0.x + 8.0f, p0.y + 8.0f);
+            dl->AddRectFilled(ImVec2(tp.x - 4, tp.y - 3), ImVec2(tp.x + tsz.x + 4, tp.y + tsz.y + 3), IM_COL32(18,18,22,200), 3.0f);
+            dl->AddText(tp, st.cvd >= 0.0 ? IM_COL32(120,230,180,230) : IM_COL32(240,140,140,230), sb);
+        }
+
         // Draw my fills markers (triangles) on chart - improved visibility
         {
             std::vector<MyFill> my;
@@ -2666,8 +3089,10 @@ static void RenderChartWindow()
             static long long lastSeenFwTs = 0;
             struct Firework { long long ts; long long startMs; double price; double qty; bool isBuy; };
             static std::vector<Firework> fireworks;
-            struct BigOverlay { long long ts; long long startMs; double price; double qty; bool isBuy; };
+            struct BigOverlay { long long ts; long long startMs; double price; double qty; bool isBuy; unsigned levels; };
             static std::vector<BigOverlay> bigs;
+            static std::uint64_t sweepCursor = 0;
+            static std::vector<binancerj::core::SweepEvent> sweepEvents;
 
             std::vector<PubTrade> tr;
             { std::lock_guard<std::mutex> lk(tradesMutex); tr = g_trades; }
@@ -2677,13 +3102,19 @@ static void RenderChartWindow()
                 long long now_ms_enq = std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::system_clock::now().time_since_epoch()).count();
                 fireworks.push_back(Firework{t.ts, now_ms_enq, t.price, t.qty, t.isBuy});
-                if (t.qty >= uiBigTradeQty) bigs.push_back(BigOverlay{t.ts, now_ms_enq, t.price, t.qty, t.isBuy});
                 if (t.ts > mx) mx = t.ts;
             }
             if (mx > lastSeenFwTs) lastSeenFwTs = mx;
 
             long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::system_clock::now().time_since_epoch()).count();
+            // Detector events: outlier-sized taker orders and multi-level sweeps
+            g_sweeps.flush(lastSeenFwTs);
+            g_sweeps.readSince(sweepCursor, sweepEvents);
+            for (auto &ev : sweepEvents) {
+                if ((int)ev.slot != g_chartSymbolId.load(std::memory_order_acquire)) continue;
+                bigs.push_back(BigOverlay{ev.ts, now_ms, ev.lastPrice, ev.qty, ev.isBuy, (ev.flags & binancerj::core::SweepEvent::MultiLevel) ? ev.levels : 0u});
+            }
 
             // Draw fireworks (200ms lifespan)
             std::vector<Firework> keepFw; keepFw.reserve(fireworks.size());
@@ -2741,7 +3172,9 @@ static void RenderChartWindow()
                 // Preferred horizontal placement: outside the candle to avoid occlusion
                 float y = p_to_y(bo.price) + (bo.isBuy ? -2.0f : 2.0f);
 
-                char tb[32]; snprintf(tb, sizeof(tb), "%c%.3f", bo.isBuy?'+':'-', bo.qty);
+                char tb[48];
+                if (bo.levels > 1) snprintf(tb, sizeof(tb), "%c%.3f x%ulv", bo.isBuy?'+':'-', bo.qty, bo.levels);
+                else snprintf(tb, sizeof(tb), "%c%.3f", bo.isBuy?'+':'-', bo.qty);
                 ImVec2 tsz = ImGui::CalcTextSize(tb);
                 float txRight = xR + 6.0f;
                 float txLeft  = xL - tsz.x - 6.0f;
@@ -2780,7 +3213,7 @@ static void RenderChartWindow()
         // Orderbook depth heatmap (faint gray bars near right axis)
         if (showDepth) {
             // Simple faint overlay near right axis with coarse bins (previous version)
-            double tick = g_priceTick.load(std::memory_order_relaxed); if (tick <= 0.0) tick = 0.1;
+            double tick = chart_filters().tick;
             double viewMin = s_viewPmin, viewMax = s_viewPmax; if (viewMax <= viewMin) viewMax = viewMin + 1.0;
             double bin = std::max(tick, (viewMax - viewMin) / 240.0); // ~240 bins max
             std::map<double,double> binsAll, binsBid, binsAsk;
@@ -2903,12 +3336,12 @@ static void RenderChartWindow()
                 }
                 if (s_draggingOrder && s_dragOrderId == x.id && ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
                     float my = ImGui::GetIO().MousePos.y; double p = y_to_p(my);
-                    double tick = g_priceTick.load(std::memory_order_relaxed); if (tick <= 0.0) tick = 0.1;
+                    double tick = chart_filters().tick;
                     double n = std::floor((p + 1e-12) / tick); s_dragNewPrice = n * tick;
                 }
                 if (s_draggingOrder && s_dragOrderId == x.id && ImGui::IsMouseReleased(ImGuiMouseButton_Left)) {
                     s_draggingOrder = false;
-                    double tick = g_priceTick.load(std::memory_order_relaxed); if (tick <= 0.0) tick = 0.1;
+                    double tick = chart_filters().tick;
                     if (fabs(s_dragNewPrice - s_dragOrigPrice) >= tick * 0.5 && s_restChart && s_dragQty > 0.0) {
                         // Atomic cancel+replace to avoid UI blocking and duplication
                         async_cancel_replace(x.id, s_dragSide, s_dragQty, s_dragNewPrice, s_dragPosSide, s_dragReduceOnly);
@@ -2950,7 +3383,7 @@ static void RenderChartWindow()
                 bool hoveredPlus = ImGui::IsMouseHoveringRect(plusMin, plusMax, true);
                 if (hoveredPlus && ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
                     g_showOrderDialog = true; g_dialogFocusNext = true; g_dialogSideIdx = 0; g_dialogTypeIdx = 1; g_dialogTifIdx = 0; g_dialogReduceOnly = false; g_dialogPosSide[0] = 0; g_dialogQty = 0.001f;
-                    double tick = g_priceTick.load(std::memory_order_relaxed); if (tick <= 0.0) tick = 0.1;
+                    double tick = chart_filters().tick;
                     double p = priceAtMouse; double n = std::floor((p + 1e-12)/tick); g_dialogPrice = n * tick;
                 }
                 ImVec2 c = ImVec2(plusPos.x + plusSz*0.5f, plusPos.y + plusSz*0.5f);
@@ -3011,19 +3444,22 @@ static void RenderChartWindow()
                 ImVec2 bw(ImGui::GetContentRegionAvail().x*0.5f - 4.0f, 36.0f);
                 auto submit = [&](bool isBuy){
                     if (!s_restChart) { g_dialogResp = "REST not ready"; return; }
-                    double step = g_qtyStep.load(std::memory_order_relaxed); if (step<=0) step=0.000001;
-                    double minq = g_minQty.load(std::memory_order_relaxed);
+                    const ChartFilters filters = chart_filters();
+                    double step = filters.step;
+                    double minq = filters.minQty;
                     auto floor_step = [](double v, double st){ if (st<=0) return v; double n=floor((v+1e-12)/st); return n*st; };
                     double q = floor_step(g_dialogQty, step); if (q < minq) q = minq;
                     std::string side = isBuy?"BUY":"SELL";
                     std::string tif = (g_dialogTifIdx==1?"IOC":(g_dialogTifIdx==2?"FOK":"GTC"));
                     std::string pside = std::string(g_dialogPosSide);
-                    double tick = g_priceTick.load(std::memory_order_relaxed); if (tick<=0) tick=0.1;
+                    double tick = filters.tick;
                     double price = g_dialogTypeIdx==1 ? floor_step(g_dialogPrice, tick) : 0.0;
                     const char* type = (g_dialogTypeIdx==0?"MARKET":"LIMIT");
-                    auto r = s_restChart->placeOrder(g_chartSymbol, side, type, q, price, tif, g_dialogReduceOnly, false, 5000, pside, 0.0, "MARK_PRICE");
-                    char hdr[96]; snprintf(hdr,sizeof(hdr),"%s %s %.6f %s", g_chartSymbol.c_str(), side.c_str(), q, type);
-                    g_dialogResp = std::string(hdr) + ": " + (r.ok?"OK ":"ERR ") + std::to_string(r.status) + "\n" + r.body;
+                    BinanceRest::OrderRequest o;
+                    o.symbol = g_chartSymbol; o.side = side; o.type = type; o.quantity = q; o.price = price; o.timeInForce = tif;
+                    o.reduceOnly = g_dialogReduceOnly; o.positionSide = pside; o.workingType = "MARK_PRICE";
+                    char hdr[96]; snprintf(hdr,sizeof(hdr),"%s %s %.6f %s: ", g_chartSymbol.c_str(), side.c_str(), q, type);
+                    g_dialogResp = queue_order(o, kAckDialog, hdr);
                 };
                 ImGui::PushStyleColor(ImGuiCol_Button, IM_COL32(40,150,90,255));
                 ImGui::PushStyleColor(ImGuiCol_ButtonHovered, IM_COL32(60,180,110,255));
@@ -3096,9 +3532,10 @@ static void RenderChartWindow()
             ImVec2 v0 = ImVec2(p0.x, yBase + eachH * paneIdx);
             ImVec2 v1 = ImVec2(p1.x, yBase + eachH * (paneIdx+1) - 2.0f);
             draw_panel_frame("Volume", v0, v1);
-            double vmax=1.0; for (auto& k:cs){ if (k.t1<viewT0||k.t0>viewT1) continue; vmax=std::max(vmax,k.v);} 
-            for (auto& k: cs) {
-                if (k.t1<viewT0||k.t0>viewT1) continue; float x = t_to_x((k.t0+k.t1)/2); float x0=x-barW*0.5f, x1=x+barW*0.5f; float vh = (float)((k.v / vmax) * (v1.y - v0.y - 16.0f)); float y1 = v1.y-6.0f; float y0 = y1 - vh; ImU32 col = (k.c>=k.o)?IM_COL32(60,180,120,200):IM_COL32(200,80,80,200); dl->AddRectFilled(ImVec2(x0,y0),ImVec2(x1,y1),col);
+            // Same decimated columns as the candles (volume summed per column)
+            double vmax=1.0; for (auto& k:s_lodBars){ vmax=std::max(vmax,k.v);} 
+            for (auto& k: s_lodBars) {
+                float x = t_to_x((k.t0+k.t1)/2); float w = std::max(1.0f, (float)((k.t1 - k.t0 + 1) * px_per_ms * 0.6f)); float x0=x-w*0.5f, x1=x+w*0.5f; float vh = (float)((k.v / vmax) * (v1.y - v0.y - 16.0f)); float y1 = v1.y-6.0f; float y0 = y1 - vh; ImU32 col = (k.c>=k.o)?IM_COL32(60,180,120,200):IM_COL32(200,80,80,200); dl->AddRectFilled(ImVec2(x0,y0),ImVec2(x1,y1),col);
             }
             // Right-side axis labels: 0, vmax/2, vmax
             std::string s0 = "0"; auto s1 = fmt_units(vmax*0.5); auto s2 = fmt_units(vmax);
@@ -3228,8 +3665,8 @@ static void GuiMain()
     ImGui::StyleColorsDark();
     ImGui_ImplWin32_Init(hwnd);
     ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
-    // Start global pollers (orders/fills + BNBUSDT ticker) regardless of UI tabs
-    StartOrdersAndFillsPollerOnce();
+    // Start global workers (user data stream + BNBUSDT ticker) regardless of UI tabs
+    StartUserDataMirrorOnce();
     StartBnbTickerPollerOnce();
 
     // Main loop
@@ -3256,6 +3693,7 @@ static void GuiMain()
             tickStart = now;
             lastMessageCount.store(messageCount.exchange(0), std::memory_order_acq_rel);
             telemetry::logGauge("gui", "order_updates_per_second", static_cast<double>(lastMessageCount.load(std::memory_order_acquire)));
+            order_tracer().publish();
         }
 
         // Start frame
@@ -3263,6 +3701,7 @@ static void GuiMain()
         ImGui_ImplWin32_NewFrame();
         ImGui::NewFrame();
 
+        drain_order_acks();
         RenderOrderBookUI();
         RenderChartWindow();
 
@@ -3302,8 +3741,17 @@ int main() {
     try {
         telemetry::startSession("gui_app");
         telemetry::logEvent("gui", "entry");
-        const std::string host = "fstream.binance.com"; // futures
-        const std::string port = "443";
+        const std::string host = binancerj::net::Endpoints::get().streamHost; // futures
+        const std::string port = binancerj::net::Endpoints::get().streamPort;
+
+        // Exchange clock for signed request timestamps and latency gauges
+        binancerj::net::ClockSync::instance().start(binancerj::net::Endpoints::get().restHost);
+        // Symbol filters: warm start from disk, then one full exchangeInfo in the background
+        binancerj::core::SymbolTable::instance().load(kSymbolTablePath);
+        g_chartSymbolId.store(binancerj::core::SymbolTable::instance().intern(g_chartSymbol), std::memory_order_release);
+        std::thread([] {
+            try { BinanceRest rest(binancerj::net::Endpoints::get().restHost); refresh_symbol_table(rest); } catch (...) {}
+        }).detach();
 
         // Ensure console window is visible for API call results
         ::ShowWindow(::GetConsoleWindow(), SW_SHOW);
@@ -3314,12 +3762,19 @@ int main() {
             std::thread(receiveOrderBook, host, port, i + 1).detach();
             std::this_thread::sleep_for(std::chrono::milliseconds(5)); // ~50 ms total spread
         }
-        // Start public trades receiver for BTCUSDT
-        std::thread(receivePublicTrades, host, port, std::string("btcusdt")).detach();
+        // Start public trades receiver for the chart symbol (Load moves it)
+        {
+            std::string symLower = g_chartSymbol; std::transform(symLower.begin(), symLower.end(), symLower.begin(), ::tolower);
+            StartOrRestartTradeStream(symLower);
+        }
         GuiMain();
+        StopUserDataMirrors();
+        (void)order_tracer().writeReport(kOrderLatencyReportPath);
+        binancerj::net::ClockSync::instance().stop();
         telemetry::logEvent("gui", "exit");
     }
     catch (const std::exception& ex) {
+        StopUserDataMirrors();
         std::cerr << "Fatal error: " << ex.what() << std::endl;
         telemetry::logEvent("gui", std::string("fatal_error msg=") + ex.what());
         return 1;
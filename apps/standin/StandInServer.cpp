@@ -0,0 +1,1434 @@
+#if defined(BINANCE_RJ_ENABLE_STANDIN_SERVER)
+// Local stand-in for the Binance USD-M Futures REST API and market streams, for integration
+// and latency tests without the exchange. Build with BINANCE_RJ_ENABLE_STANDIN_SERVER defined
+// (and the GUI/console entries off).
+//
+// One TLS port serves both: HTTP/1.1 keep-alive for the REST subset BinanceRest uses, and
+// WebSocket upgrades on /ws (SUBSCRIBE/UNSUBSCRIBE like fstream) or /ws/<stream>. Streams are
+// replayed from <record-dir>/<stream>.jsonl when present, otherwise synthesized. /ws/<listenKey>
+// is the user data stream: order, account and leverage changes of the simulated account are
+// pushed as ORDER_TRADE_UPDATE / ACCOUNT_UPDATE / ACCOUNT_CONFIG_UPDATE. Point the clients at
+// it with
+//   BINANCE_RJ_REST_HOST=localhost:8443 BINANCE_RJ_STREAM_HOST=localhost:8443
+//   SSL_CERT_FILE=<cert-out>          (the generated self-signed certificate)
+//
+// Usage:
+//   standin [--port=8443] [--bind=127.0.0.1] [--threads=2] [--cert=pem --key=pem]
+//           [--cert-out=standin_cert.pem] [--latency-ms=0] [--jitter-ms=0] [--error-rate=0]
+//           [--weight-limit=2400] [--secret=...] [--record-dir=recordings]
+//           [--replay-speed=1] [--synthetic-rate=10]
+//   standin record <stream> <seconds> [--record-dir=recordings]   (from the live exchange)
+//
+// Recording format: one frame per line, "<ms since first frame>\t<payload>". --replay-speed
+// scales the recorded gaps (2 = twice as fast, 0 = as fast as the socket takes them).
+
+#include "binancerj/net/Endpoints.hpp"
+#include "binancerj/net/RateLimitGovernor.hpp"
+#include "binancerj/net/RequestSigner.hpp"
+#include "binancerj/net/WebSocket.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace asio = boost::asio;
+namespace ssl = boost::asio::ssl;
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace websocket = beast::websocket;
+namespace fs = std::filesystem;
+using tcp = asio::ip::tcp;
+
+struct Options {
+    std::string bind{"127.0.0.1"};
+    unsigned short port{8443};
+    int threads{2};
+    std::string certFile;                       // empty: generate a self-signed pair
+    std::string keyFile;
+    std::string certOut{"standin_cert.pem"};    // generated certificate, for SSL_CERT_FILE
+    int latencyMs{0};                           // added to every REST response
+    int jitterMs{0};                            // plus uniform 0..jitter
+    double errorRate{0.0};                      // share of REST calls answered 503
+    int weightLimit{2400};                      // 429 above this request weight per minute
+    std::string secret;                         // verify signatures when set
+    std::string recordDir{"recordings"};
+    double replaySpeed{1.0};
+    int syntheticRate{10};                      // frames/s per synthesized stream
+};
+
+long long nowMs() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+std::string fixed(double v, int decimals) {
+    char buf[64];
+    auto res = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::fixed, decimals);
+    return std::string(buf, res.ptr);
+}
+
+std::string urlDecode(std::string_view s) {
+    std::string out;
+    out.reserve(s.size());
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '%' && i + 2 < s.size()) {
+            int v = 0;
+            std::from_chars(s.data() + i + 1, s.data() + i + 3, v, 16);
+            out.push_back(static_cast<char>(v));
+            i += 2;
+        } else {
+            out.push_back(s[i] == '+' ? ' ' : s[i]);
+        }
+    }
+    return out;
+}
+
+using Params = std::map<std::string, std::string>;
+
+void parseQuery(std::string_view q, Params& out) {
+    while (!q.empty()) {
+        const std::size_t amp = q.find('&');
+        const std::string_view pair = q.substr(0, amp);
+        const std::size_t eq = pair.find('=');
+        if (eq != std::string_view::npos) out[std::string(pair.substr(0, eq))] = urlDecode(pair.substr(eq + 1));
+        if (amp == std::string_view::npos) break;
+        q.remove_prefix(amp + 1);
+    }
+}
+
+// Members of one flat JSON object (batchOrders entries, ws-fapi params): strings unquoted,
+// numbers and literals as written.
+Params jsonFields(std::string_view obj) {
+    Params out;
+    std::size_t pos = 0;
+    while ((pos = obj.find('"', pos)) != std::string_view::npos) {
+        const std::size_t keyEnd = obj.find('"', pos + 1);
+        std::size_t valStart = keyEnd == std::string_view::npos ? keyEnd : obj.find(':', keyEnd + 1);
+        if (valStart == std::string_view::npos) break;
+        valStart = obj.find_first_not_of(" \t\r\n", valStart + 1);
+        if (valStart == std::string_view::npos) break;
+        const std::string key(obj.substr(pos + 1, keyEnd - pos - 1));
+        if (obj[valStart] == '"') {
+            const std::size_t valEnd = obj.find('"', valStart + 1);
+            if (valEnd == std::string_view::npos) break;
+            out[key] = std::string(obj.substr(valStart + 1, valEnd - valStart - 1));
+            pos = valEnd + 1;
+        } else {
+            const std::size_t valEnd = std::min(obj.find_first_of(",}", valStart), obj.size());
+            out[key] = std::string(obj.substr(valStart, valEnd - valStart));
+            pos = valEnd;
+        }
+    }
+    return out;
+}
+
+double toDouble(const std::string& s, double fallback = 0.0) {
+    double v = fallback;
+    std::from_chars(s.data(), s.data() + s.size(), v);
+    return v;
+}
+
+long long toInt(const std::string& s, long long fallback = 0) {
+    long long v = fallback;
+    std::from_chars(s.data(), s.data() + s.size(), v);
+    return v;
+}
+
+long long intervalMs(const std::string& iv) {
+    if (iv.size() < 2) return 60000;
+    const long long n = toInt(iv.substr(0, iv.size() - 1), 1);
+    switch (iv.back()) {
+    case 'm': return n * 60000;
+    case 'h': return n * 3600000;
+    case 'd': return n * 86400000;
+    case 'w': return n * 7 * 86400000;
+    default: return 60000;
+    }
+}
+
+// ---- Self-signed certificate ----
+
+struct CertPair {
+    std::string certPem;
+    std::string keyPem;
+};
+
+std::string bioString(BIO* bio) {
+    char* data = nullptr;
+    const long len = BIO_get_mem_data(bio, &data);
+    return std::string(data, static_cast<std::size_t>(len));
+}
+
+// P-256 key and a one-year certificate for localhost / 127.0.0.1.
+CertPair makeSelfSigned() {
+    CertPair out;
+    EVP_PKEY* key = EVP_EC_gen("P-256");
+    X509* cert = X509_new();
+    if (!key || !cert) throw std::runtime_error("self-signed: key/cert allocation failed");
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), static_cast<long>(nowMs() / 1000));
+    X509_gmtime_adj(X509_getm_notBefore(cert), -3600);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 365L * 24 * 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_NAME_add_entry_by_txt(name, "O", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("BinanceRJTech stand-in"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509V3_CTX ctx;
+    X509V3_set_ctx_nodb(&ctx);
+    X509V3_set_ctx(&ctx, cert, cert, nullptr, nullptr, 0);
+    for (auto [nid, value] : {std::pair{NID_subject_alt_name, "DNS:localhost,IP:127.0.0.1"}, std::pair{NID_basic_constraints, "critical,CA:TRUE"}}) {
+        if (X509_EXTENSION* ext = X509V3_EXT_conf_nid(nullptr, &ctx, nid, value)) {
+            X509_add_ext(cert, ext, -1);
+            X509_EXTENSION_free(ext);
+        }
+    }
+    if (!X509_sign(cert, key, EVP_sha256())) throw std::runtime_error("self-signed: signing failed");
+
+    BIO* certBio = BIO_new(BIO_s_mem());
+    BIO* keyBio = BIO_new(BIO_s_mem());
+    PEM_write_bio_X509(certBio, cert);
+    PEM_write_bio_PrivateKey(keyBio, key, nullptr, nullptr, 0, nullptr, nullptr);
+    out.certPem = bioString(certBio);
+    out.keyPem = bioString(keyBio);
+    BIO_free(certBio);
+    BIO_free(keyBio);
+    X509_free(cert);
+    EVP_PKEY_free(key);
+    return out;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// ---- Simulated market and account ----
+
+// Random-walk mid price per symbol, shared by REST snapshots and synthesized streams.
+class Market {
+public:
+    double mid(const std::string& symbol) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = mids_.find(symbol);
+        if (it == mids_.end()) it = mids_.emplace(symbol, basePrice(symbol)).first;
+        std::normal_distribution<double> step(0.0, it->second * 0.00005);
+        it->second = std::max(it->second * 0.5, it->second + step(rng_));
+        return it->second;
+    }
+
+    double tick(const std::string& symbol) const { return basePrice(symbol) >= 1000 ? 0.1 : 0.01; }
+
+    double uniform(double lo, double hi) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::uniform_real_distribution<double>(lo, hi)(rng_);
+    }
+
+    long long nextUpdateId() { return ++updateId_; }
+    long long nextTradeId() { return ++tradeId_; }
+
+private:
+    static double basePrice(const std::string& symbol) {
+        if (symbol.rfind("BTC", 0) == 0) return 65000.0;
+        if (symbol.rfind("ETH", 0) == 0) return 3200.0;
+        if (symbol.rfind("BNB", 0) == 0) return 580.0;
+        return 100.0;
+    }
+
+    std::mutex mutex_;
+    std::mt19937_64 rng_{42};
+    std::map<std::string, double> mids_;
+    std::atomic<long long> updateId_{1000000};
+    std::atomic<long long> tradeId_{5000000};
+};
+
+struct Response {
+    http::status status{http::status::ok};
+    std::string body;
+    int retryAfter{0};
+};
+
+Response apiError(http::status status, int code, const std::string& msg) {
+    return Response{status, "{\"code\":" + std::to_string(code) + ",\"msg\":\"" + msg + "\"}"};
+}
+
+// The REST subset BinanceRest uses. Orders are acknowledged and kept as open (LIMIT/STOP) or
+// filled at once (MARKET); there is no matching.
+class Exchange {
+public:
+    Exchange(const Options& options, Market& market) : options_(options), market_(market) {
+        if (!options.secret.empty()) signer_.setSecret(options.secret);
+    }
+
+    // Request weight and order counts per window, with the exchange's response headers.
+    struct Usage {
+        int weight1m;
+        int orders10s;
+        int orders1m;
+    };
+
+    Response handle(const std::string& method, const std::string& target, const std::string& body, const std::string& apiKey, Usage& usage) {
+        Response r = route(method, target, body, apiKey, usage);
+        std::vector<std::string> events;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            events.swap(outbox_);
+        }
+        if (!events.empty()) publish(events);
+        return r;
+    }
+
+    // User data stream subscribers; fn runs on the thread that changed the account.
+    using Listener = std::function<void(const std::string& event)>;
+    int addListener(Listener fn) {
+        std::lock_guard<std::mutex> lock(listenersMutex_);
+        listeners_[++nextListener_] = std::move(fn);
+        return nextListener_;
+    }
+    void removeListener(int id) {
+        std::lock_guard<std::mutex> lock(listenersMutex_);
+        listeners_.erase(id);
+    }
+    static bool isListenKey(const std::string& stream) {
+        return stream.rfind("standin", 0) == 0;
+    }
+
+private:
+    Response route(const std::string& method, const std::string& target, const std::string& body, const std::string& apiKey, Usage& usage) {
+        const auto cost = binancerj::net::RateLimitGovernor::classify(method, target);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const long long now = nowMs();
+            if (now / 60000 != minute_) { minute_ = now / 60000; weight_ = 0; orders1m_ = 0; }
+            if (now / 10000 != tenSec_) { tenSec_ = now / 10000; orders10s_ = 0; }
+            weight_ += cost.weight;
+            orders10s_ += cost.orders; orders1m_ += cost.orders;
+            usage = Usage{weight_, orders10s_, orders1m_};
+            if (weight_ > options_.weightLimit) {
+                Response r = apiError(http::status::too_many_requests, -1003, "Too many requests; current limit is " + std::to_string(options_.weightLimit) + " request weight per 1 MINUTE.");
+                r.retryAfter = static_cast<int>(60 - (now / 1000) % 60);
+                return r;
+            }
+        }
+
+        const std::size_t q = target.find('?');
+        const std::string path = target.substr(0, q);
+        Params p;
+        if (q != std::string::npos) parseQuery(std::string_view(target).substr(q + 1), p);
+        parseQuery(body, p);
+
+        if (method == "GET") {
+            if (path == "/fapi/v1/ping") return Response{http::status::ok, "{}"};
+            if (path == "/fapi/v1/time") return Response{http::status::ok, "{\"serverTime\":" + std::to_string(nowMs()) + "}"};
+            if (path == "/fapi/v1/exchangeInfo") return exchangeInfo(p);
+            if (path == "/fapi/v1/depth") return depth(p);
+            if (path == "/fapi/v1/klines") return klines(p);
+            if (path == "/fapi/v1/ticker/price") return tickerPrice(p);
+        }
+        if (path == "/fapi/v1/listenKey") {
+            if (apiKey.empty()) return apiError(http::status::unauthorized, -2015, "Invalid API-key, IP, or permissions for action.");
+            return Response{http::status::ok, "{\"listenKey\":\"standin" + std::to_string(std::hash<std::string>{}(apiKey)) + "\"}"};
+        }
+
+        // Everything else is signed.
+        if (Response err; !checkSigned(target, q, p, apiKey, err)) return err;
+        if (method == "GET") {
+            if (path == "/fapi/v2/account") return account();
+            if (path == "/fapi/v2/positionRisk") return Response{http::status::ok, "[]"};
+            if (path == "/fapi/v1/openOrders") return openOrders(p);
+            if (path == "/fapi/v1/order") return queryOrder(p);
+            if (path == "/fapi/v1/userTrades") return userTrades(p);
+        } else if (method == "POST") {
+            if (path == "/fapi/v1/order/test") return Response{http::status::ok, "{}"};
+            if (path == "/fapi/v1/order") return placeOrder(p);
+            if (path == "/fapi/v1/batchOrders") return placeBatch(p);
+            if (path == "/fapi/v1/order/cancelReplace") return cancelReplace(p);
+            if (path == "/fapi/v1/leverage") return setLeverage(p);
+            if (path == "/fapi/v1/marginType" || path == "/fapi/v1/positionSide/dual") return Response{http::status::ok, "{\"code\":200,\"msg\":\"success\"}"};
+        } else if (method == "PUT") {
+            if (path == "/fapi/v1/order") return modifyOrder(p);
+        } else if (method == "DELETE") {
+            if (path == "/fapi/v1/order") return cancelOrder(p);
+            if (path == "/fapi/v1/allOpenOrders") return cancelAll(p);
+            if (path == "/fapi/v1/batchOrders") return cancelBatch(p);
+        }
+        return apiError(http::status::not_found, -5000, "Path " + path + ", Method " + method + " is invalid");
+    }
+
+    struct Order {
+        long long orderId;
+        std::string symbol, side, type, timeInForce, positionSide, clientOrderId, status;
+        double price, stopPrice, origQty, executedQty;
+        bool reduceOnly;
+        long long updateTime;
+    };
+
+    // One-way mode positions, simulated from MARKET fills at the mid price.
+    struct Position {
+        double amount{0.0};
+        double entryPrice{0.0};
+        int leverage{20};
+        long long updateTime{0};
+    };
+
+    struct Trade {
+        long long id, orderId;
+        std::string symbol, side;
+        double price, qty, commission, realizedPnl;
+        long long time;
+    };
+
+    static constexpr double kTakerRate = 0.0005;
+
+    bool checkSigned(const std::string& target, std::size_t q, const Params& p, const std::string& apiKey, Response& err) {
+        if (apiKey.empty()) {
+            err = apiError(http::status::unauthorized, -2015, "Invalid API-key, IP, or permissions for action.");
+            return false;
+        }
+        auto ts = p.find("timestamp");
+        auto sig = p.find("signature");
+        if (ts == p.end() || sig == p.end()) {
+            err = apiError(http::status::bad_request, -1102, "Mandatory parameter 'timestamp' or 'signature' was not sent.");
+            return false;
+        }
+        auto rw = p.find("recvWindow");
+        const long long window = rw == p.end() ? 5000 : toInt(rw->second, 5000);
+        const long long skew = nowMs() - toInt(ts->second);
+        if (skew > window || skew < -1000) {
+            err = apiError(http::status::bad_request, -1021, "Timestamp for this request is outside of the recvWindow.");
+            return false;
+        }
+        if (!options_.secret.empty()) {
+            // Signed over the query string up to "&signature=".
+            const std::string query = target.substr(q + 1);
+            const std::size_t at = query.find("&signature=");
+            char hex[binancerj::net::RequestSigner::kHexLength];
+            signer_.sign(std::string_view(query).substr(0, at), hex);
+            if (sig->second != std::string(hex, sizeof(hex))) {
+                err = apiError(http::status::bad_request, -1022, "Signature for this request is not valid.");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Response exchangeInfo(Params& p) {
+        static const char* kSymbols[] = {"BTCUSDT", "ETHUSDT", "BNBUSDT"};
+        std::string out = "{\"timezone\":\"UTC\",\"serverTime\":" + std::to_string(nowMs()) + ",\"rateLimits\":[],\"exchangeFilters\":[],\"symbols\":[";
+        bool first = true;
+        for (const char* s : kSymbols) {
+            if (!p["symbol"].empty() && p["symbol"] != s) continue;
+            const std::string sym = s;
+            const double tick = market_.tick(sym);
+            const bool btc = sym == "BTCUSDT";
+            if (!first) out += ',';
+            first = false;
+            out += "{\"symbol\":\"" + sym + "\",\"pair\":\"" + sym + "\",\"contractType\":\"PERPETUAL\",\"status\":\"TRADING\",";
+            out += "\"baseAsset\":\"" + sym.substr(0, 3) + "\",\"quoteAsset\":\"USDT\",\"marginAsset\":\"USDT\",";
+            out += std::string("\"pricePrecision\":") + (tick < 0.1 ? "2" : "1") + ",\"quantityPrecision\":" + (btc ? "3" : "2") + ",\"filters\":[";
+            out += "{\"filterType\":\"PRICE_FILTER\",\"minPrice\":\"0.01\",\"maxPrice\":\"1000000\",\"tickSize\":\"" + fixed(tick, 2) + "\"},";
+            out += std::string("{\"filterType\":\"LOT_SIZE\",\"stepSize\":\"") + (btc ? "0.001" : "0.01") + "\",\"minQty\":\"" + (btc ? "0.001" : "0.01") + "\",\"maxQty\":\"1000\"},";
+            out += std::string("{\"filterType\":\"MARKET_LOT_SIZE\",\"stepSize\":\"") + (btc ? "0.001" : "0.01") + "\",\"minQty\":\"" + (btc ? "0.001" : "0.01") + "\",\"maxQty\":\"120\"},";
+            out += "{\"filterType\":\"MIN_NOTIONAL\",\"notional\":\"" + std::string(btc ? "100" : "20") + "\"}]}";
+        }
+        out += "]}";
+        return Response{http::status::ok, std::move(out)};
+    }
+
+    Response depth(Params& p) {
+        const std::string sym = p["symbol"];
+        const int limit = std::clamp(static_cast<int>(toInt(p["limit"], 500)), 5, 1000);
+        const double mid = market_.mid(sym), tick = market_.tick(sym);
+        const long long now = nowMs();
+        std::string out = "{\"lastUpdateId\":" + std::to_string(market_.nextUpdateId()) + ",\"E\":" + std::to_string(now) + ",\"T\":" + std::to_string(now);
+        for (int side = 0; side < 2; ++side) {
+            out += side == 0 ? ",\"bids\":[" : ",\"asks\":[";
+            const double best = side == 0 ? std::floor(mid / tick) * tick : std::ceil(mid / tick) * tick + tick;
+            for (int i = 0; i < limit; ++i) {
+                if (i) out += ',';
+                const double price = side == 0 ? best - i * tick : best + i * tick;
+                out += "[\"" + fixed(price, 2) + "\",\"" + fixed(market_.uniform(0.001, 5.0), 3) + "\"]";
+            }
+            out += ']';
+        }
+        out += '}';
+        return Response{http::status::ok, std::move(out)};
+    }
+
+    Response klines(Params& p) {
+        const std::string sym = p["symbol"];
+        const long long step = intervalMs(p["interval"].empty() ? "1m" : p["interval"]);
+        const int limit = std::clamp(static_cast<int>(toInt(p["limit"], 500)), 1, 1500);
+        long long end = toInt(p["endTime"], nowMs());
+        long long start = toInt(p["startTime"], 0);
+        end = end / step * step;
+        if (start <= 0) start = end - (limit - 1) * step;
+        start = (start + step - 1) / step * step;
+        // Deterministic walk per open time so repeated and overlapping fetches agree.
+        double price = 65000.0 * (sym.rfind("BTC", 0) == 0 ? 1.0 : 0.05);
+        std::string out = "[";
+        int n = 0;
+        for (long long t = start; t <= end && n < limit; t += step, ++n) {
+            std::mt19937_64 rng(static_cast<unsigned long long>(t / step));
+            std::normal_distribution<double> d(0.0, price * 0.001);
+            const double o = price * (1.0 + std::sin(static_cast<double>(t / step) * 0.01) * 0.02);
+            const double c = o + d(rng);
+            const double h = std::max(o, c) + std::abs(d(rng)) * 0.5;
+            const double l = std::min(o, c) - std::abs(d(rng)) * 0.5;
+            const double v = 10.0 + std::abs(d(rng));
+            if (n) out += ',';
+            out += "[" + std::to_string(t) + ",\"" + fixed(o, 2) + "\",\"" + fixed(h, 2) + "\",\"" + fixed(l, 2) + "\",\"" + fixed(c, 2) + "\",\"" + fixed(v, 3)
+                + "\"," + std::to_string(t + step - 1) + ",\"" + fixed(v * c, 2) + "\",100,\"" + fixed(v / 2, 3) + "\",\"" + fixed(v * c / 2, 2) + "\",\"0\"]";
+        }
+        out += ']';
+        return Response{http::status::ok, std::move(out)};
+    }
+
+    Response tickerPrice(Params& p) {
+        const std::string sym = p["symbol"].empty() ? "BTCUSDT" : p["symbol"];
+        return Response{http::status::ok, "{\"symbol\":\"" + sym + "\",\"price\":\"" + fixed(market_.mid(sym), 2) + "\",\"time\":" + std::to_string(nowMs()) + "}"};
+    }
+
+    // Unrealized PnL is not simulated: margin balance == wallet balance.
+    Response account() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double used = 0.0;
+        std::string positions;
+        for (const auto& [sym, pos] : positions_) {
+            used += std::abs(pos.amount) * pos.entryPrice / std::max(1, pos.leverage);
+            if (!positions.empty()) positions += ',';
+            positions += "{\"symbol\":\"" + sym + "\",\"positionAmt\":\"" + fixed(pos.amount, 8) + "\",\"entryPrice\":\"" + fixed(pos.entryPrice, 8)
+                + "\",\"unrealizedProfit\":\"0.00000000\",\"leverage\":\"" + std::to_string(pos.leverage)
+                + "\",\"isolated\":false,\"positionSide\":\"BOTH\",\"updateTime\":" + std::to_string(pos.updateTime) + "}";
+        }
+        const std::string wallet = fixed(wallet_, 8), available = fixed(wallet_ - used, 8);
+        return Response{http::status::ok,
+            "{\"feeTier\":0,\"canTrade\":true,\"totalWalletBalance\":\"" + wallet + "\",\"totalMarginBalance\":\"" + wallet + "\",\"availableBalance\":\""
+            + available + "\",\"assets\":[{\"asset\":\"USDT\",\"walletBalance\":\"" + wallet + "\",\"crossWalletBalance\":\"" + wallet
+            + "\",\"marginBalance\":\"" + wallet + "\",\"availableBalance\":\"" + available + "\",\"unrealizedProfit\":\"0.00000000\",\"updateTime\":"
+            + std::to_string(walletTime_) + "}],\"positions\":[" + positions + "]}"};
+    }
+
+    Response userTrades(Params& p) {
+        const std::size_t limit = static_cast<std::size_t>(std::clamp<long long>(toInt(p["limit"], 500), 1, 1000));
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<const Trade*> picked;
+        for (auto it = trades_.rbegin(); it != trades_.rend() && picked.size() < limit; ++it) {
+            if (it->symbol == p["symbol"]) picked.push_back(&*it);
+        }
+        std::string out = "[";
+        for (auto it = picked.rbegin(); it != picked.rend(); ++it) {
+            const Trade& t = **it;
+            if (out.size() > 1) out += ',';
+            out += "{\"symbol\":\"" + t.symbol + "\",\"id\":" + std::to_string(t.id) + ",\"orderId\":" + std::to_string(t.orderId) + ",\"side\":\"" + t.side
+                + "\",\"price\":\"" + fixed(t.price, 8) + "\",\"qty\":\"" + fixed(t.qty, 8) + "\",\"realizedPnl\":\"" + fixed(t.realizedPnl, 8)
+                + "\",\"quoteQty\":\"" + fixed(t.price * t.qty, 8) + "\",\"commission\":\"" + fixed(t.commission, 8) + "\",\"commissionAsset\":\"USDT\",\"time\":"
+                + std::to_string(t.time) + ",\"positionSide\":\"BOTH\",\"buyer\":" + (t.side == "BUY" ? "true" : "false") + ",\"maker\":false}";
+        }
+        out += ']';
+        return Response{http::status::ok, std::move(out)};
+    }
+
+    Response setLeverage(Params& p) {
+        const int leverage = static_cast<int>(std::clamp<long long>(toInt(p["leverage"], 20), 1, 125));
+        std::lock_guard<std::mutex> lock(mutex_);
+        positions_[p["symbol"]].leverage = leverage;
+        notifyLocked("{\"e\":\"ACCOUNT_CONFIG_UPDATE\",\"E\":" + std::to_string(nowMs()) + ",\"T\":" + std::to_string(nowMs()) + ",\"ac\":{\"s\":\"" + p["symbol"]
+            + "\",\"l\":" + std::to_string(leverage) + "}}");
+        return Response{http::status::ok, "{\"leverage\":" + std::to_string(leverage) + ",\"maxNotionalValue\":\"1000000\",\"symbol\":\"" + p["symbol"] + "\"}"};
+    }
+
+    // ---- User data stream ----
+
+    void notifyLocked(std::string event) {
+        outbox_.push_back(std::move(event));
+    }
+
+    void publish(const std::vector<std::string>& events) {
+        std::vector<Listener> targets;
+        {
+            std::lock_guard<std::mutex> lock(listenersMutex_);
+            for (const auto& [id, fn] : listeners_) targets.push_back(fn);
+        }
+        for (const auto& e : events) {
+            for (const auto& fn : targets) fn(e);
+        }
+    }
+
+    void orderEventLocked(const Order& o, const char* execType, const Trade* t = nullptr) {
+        const long long now = nowMs();
+        notifyLocked("{\"e\":\"ORDER_TRADE_UPDATE\",\"E\":" + std::to_string(now) + ",\"T\":" + std::to_string(o.updateTime) + ",\"o\":{\"s\":\"" + o.symbol
+            + "\",\"c\":\"" + o.clientOrderId + "\",\"S\":\"" + o.side + "\",\"o\":\"" + o.type + "\",\"f\":\"" + o.timeInForce + "\",\"q\":\"" + fixed(o.origQty, 8)
+            + "\",\"p\":\"" + fixed(o.type == "MARKET" ? 0.0 : o.price, 8) + "\",\"ap\":\"" + fixed(o.executedQty > 0 ? o.price : 0.0, 8) + "\",\"sp\":\"" + fixed(o.stopPrice, 8)
+            + "\",\"x\":\"" + execType + "\",\"X\":\"" + o.status + "\",\"i\":" + std::to_string(o.orderId) + ",\"l\":\"" + fixed(t ? t->qty : 0.0, 8)
+            + "\",\"z\":\"" + fixed(o.executedQty, 8) + "\",\"L\":\"" + fixed(t ? t->price : 0.0, 8) + "\",\"N\":\"USDT\",\"n\":\"" + fixed(t ? t->commission : 0.0, 8)
+            + "\",\"T\":" + std::to_string(o.updateTime) + ",\"t\":" + std::to_string(t ? t->id : 0) + ",\"m\":false,\"R\":" + (o.reduceOnly ? "true" : "false")
+            + ",\"wt\":\"CONTRACT_PRICE\",\"ot\":\"" + o.type + "\",\"ps\":\"" + (o.positionSide.empty() ? "BOTH" : o.positionSide)
+            + "\",\"cp\":false,\"rp\":\"" + fixed(t ? t->realizedPnl : 0.0, 8) + "\"}}");
+    }
+
+    // Executes o in full at o.price: position, wallet and trade history, plus the events.
+    void fillLocked(Order& o) {
+        Position& pos = positions_[o.symbol];
+        const double delta = o.side == "BUY" ? o.origQty : -o.origQty;
+        double realized = 0.0;
+        if (pos.amount == 0.0 || (pos.amount > 0.0) == (delta > 0.0)) {
+            const double total = std::abs(pos.amount) + o.origQty;
+            pos.entryPrice = (std::abs(pos.amount) * pos.entryPrice + o.origQty * o.price) / total;
+        } else {
+            const double closing = std::min(std::abs(delta), std::abs(pos.amount));
+            realized = closing * (o.price - pos.entryPrice) * (pos.amount > 0.0 ? 1.0 : -1.0);
+            if (std::abs(delta) > std::abs(pos.amount)) pos.entryPrice = o.price;  // flipped
+        }
+        pos.amount += delta;
+        if (std::abs(pos.amount) < 1e-12) { pos.amount = 0.0; pos.entryPrice = 0.0; }
+        pos.updateTime = o.updateTime;
+
+        Trade t{++nextTradeId_, o.orderId, o.symbol, o.side, o.price, o.origQty, o.origQty * o.price * kTakerRate, realized, o.updateTime};
+        wallet_ += realized - t.commission;
+        walletTime_ = o.updateTime;
+        trades_.push_back(t);
+        if (trades_.size() > 10000) trades_.erase(trades_.begin());
+
+        o.status = "FILLED";
+        o.executedQty = o.origQty;
+        orderEventLocked(o, "TRADE", &t);
+        notifyLocked("{\"e\":\"ACCOUNT_UPDATE\",\"E\":" + std::to_string(nowMs()) + ",\"T\":" + std::to_string(o.updateTime) + ",\"a\":{\"m\":\"ORDER\",\"B\":[{\"a\":\"USDT\",\"wb\":\""
+            + fixed(wallet_, 8) + "\",\"cw\":\"" + fixed(wallet_, 8) + "\",\"bc\":\"0\"}],\"P\":[{\"s\":\"" + o.symbol + "\",\"pa\":\"" + fixed(pos.amount, 8)
+            + "\",\"ep\":\"" + fixed(pos.entryPrice, 8) + "\",\"bep\":\"0\",\"cr\":\"0\",\"up\":\"0\",\"mt\":\"cross\",\"iw\":\"0\",\"ps\":\"BOTH\"}]}}");
+    }
+
+    static std::string orderJson(const Order& o) {
+        return "{\"orderId\":" + std::to_string(o.orderId) + ",\"symbol\":\"" + o.symbol + "\",\"status\":\"" + o.status + "\",\"clientOrderId\":\"" + o.clientOrderId
+            + "\",\"price\":\"" + fixed(o.price, 8) + "\",\"avgPrice\":\"" + fixed(o.executedQty > 0 ? o.price : 0.0, 8) + "\",\"origQty\":\"" + fixed(o.origQty, 8)
+            + "\",\"executedQty\":\"" + fixed(o.executedQty, 8) + "\",\"cumQuote\":\"" + fixed(o.executedQty * o.price, 8) + "\",\"timeInForce\":\"" + o.timeInForce
+            + "\",\"type\":\"" + o.type + "\",\"origType\":\"" + o.type + "\",\"reduceOnly\":" + (o.reduceOnly ? "true" : "false") + ",\"side\":\"" + o.side
+            + "\",\"positionSide\":\"" + (o.positionSide.empty() ? "BOTH" : o.positionSide) + "\",\"stopPrice\":\"" + fixed(o.stopPrice, 8)
+            + "\",\"updateTime\":" + std::to_string(o.updateTime) + "}";
+    }
+
+    // Validates and books one order; false with err filled on rejection.
+    bool book(Params& p, Order& out, Response& err) {
+        if (p["symbol"].empty() || p["side"].empty() || p["type"].empty()) {
+            err = apiError(http::status::bad_request, -1102, "Mandatory parameter 'symbol', 'side' or 'type' was not sent.");
+            return false;
+        }
+        Order o{};
+        o.symbol = p["symbol"]; o.side = p["side"]; o.type = p["type"];
+        o.timeInForce = p["timeInForce"].empty() ? "GTC" : p["timeInForce"];
+        o.positionSide = p["positionSide"];
+        o.price = toDouble(p["price"]);
+        o.stopPrice = toDouble(p["stopPrice"]);
+        o.origQty = toDouble(p["quantity"]);
+        o.reduceOnly = p["reduceOnly"] == "true";
+        o.updateTime = nowMs();
+        if (o.origQty <= 0.0) {
+            err = apiError(http::status::bad_request, -4003, "Quantity less than or equal to zero.");
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        o.orderId = ++nextOrderId_;
+        o.clientOrderId = p["newClientOrderId"].empty() ? "standin" + std::to_string(o.orderId) : p["newClientOrderId"];
+        o.status = "NEW";
+        orderEventLocked(o, "NEW");
+        if (o.type == "MARKET") {
+            o.price = market_.mid(o.symbol);
+            fillLocked(o);
+            retireLocked(o);
+        } else {
+            open_[o.orderId] = o;
+        }
+        out = o;
+        return true;
+    }
+
+    Response placeOrder(Params& p) {
+        Order o;
+        Response err;
+        if (!book(p, o, err)) return err;
+        return Response{http::status::ok, orderJson(o)};
+    }
+
+    Response placeBatch(Params& p) {
+        const std::string& list = p["batchOrders"];
+        std::string out = "[";
+        std::size_t pos = 0;
+        int n = 0;
+        while ((pos = list.find('{', pos)) != std::string::npos) {
+            const std::size_t end = list.find('}', pos);
+            if (end == std::string::npos) break;
+            Params fields = jsonFields(std::string_view(list).substr(pos, end - pos + 1));
+            Order o;
+            Response err;
+            if (n++) out += ',';
+            out += book(fields, o, err) ? orderJson(o) : err.body;
+            pos = end + 1;
+        }
+        out += ']';
+        return Response{http::status::ok, std::move(out)};
+    }
+
+    bool cancelOne(const std::string& symbol, long long orderId, const std::string& clientId, std::string& json) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = open_.begin(); it != open_.end(); ++it) {
+            const Order& o = it->second;
+            if (o.symbol != symbol || (orderId > 0 ? o.orderId != orderId : o.clientOrderId != clientId)) continue;
+            Order done = o;
+            done.status = "CANCELED";
+            done.updateTime = nowMs();
+            open_.erase(it);
+            retireLocked(done);
+            orderEventLocked(done, "CANCELED");
+            json = orderJson(done);
+            return true;
+        }
+        json = "{\"code\":-2011,\"msg\":\"Unknown order sent.\"}";
+        return false;
+    }
+
+    Response cancelOrder(Params& p) {
+        std::string json;
+        const bool ok = cancelOne(p["symbol"], toInt(p["orderId"]), p["origClientOrderId"], json);
+        return Response{ok ? http::status::ok : http::status::bad_request, json};
+    }
+
+    Response cancelBatch(Params& p) {
+        std::string ids = p["orderIdList"];
+        std::string out = "[";
+        int n = 0;
+        std::size_t pos = 0;
+        while (pos < ids.size()) {
+            pos = ids.find_first_of("0123456789", pos);
+            if (pos == std::string::npos) break;
+            const std::size_t end = ids.find_first_not_of("0123456789", pos);
+            const long long id = toInt(ids.substr(pos, end - pos));
+            std::string json;
+            cancelOne(p["symbol"], id, {}, json);
+            if (n++) out += ',';
+            out += json;
+            pos = end == std::string::npos ? ids.size() : end;
+        }
+        out += ']';
+        return Response{http::status::ok, std::move(out)};
+    }
+
+    Response cancelAll(Params& p) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = open_.begin(); it != open_.end();) {
+            if (it->second.symbol != p["symbol"]) { ++it; continue; }
+            it->second.status = "CANCELED";
+            it->second.updateTime = nowMs();
+            retireLocked(it->second);
+            orderEventLocked(it->second, "CANCELED");
+            it = open_.erase(it);
+        }
+        return Response{http::status::ok, "{\"code\":200,\"msg\":\"The operation of cancel all open order is done.\"}"};
+    }
+
+    Response cancelReplace(Params& p) {
+        std::string cancelJson;
+        const bool cancelled = cancelOne(p["symbol"], toInt(p["cancelOrderId"]), p["cancelOrigClientOrderId"], cancelJson);
+        if (!cancelled && p["cancelReplaceMode"] != "ALLOW_FAILURE") {
+            return Response{http::status::bad_request, "{\"code\":-2022,\"msg\":\"Order cancel-replace failed.\",\"data\":{\"cancelResult\":\"FAILURE\",\"newOrderResult\":\"NOT_ATTEMPTED\",\"cancelResponse\":" + cancelJson + ",\"newOrderResponse\":null}}"};
+        }
+        Order o;
+        Response err;
+        const bool placed = book(p, o, err);
+        return Response{placed ? http::status::ok : http::status::bad_request,
+            std::string("{\"cancelResult\":\"") + (cancelled ? "SUCCESS" : "FAILURE") + "\",\"newOrderResult\":\"" + (placed ? "SUCCESS" : "FAILURE")
+            + "\",\"cancelResponse\":" + cancelJson + ",\"newOrderResponse\":" + (placed ? orderJson(o) : err.body) + "}"};
+    }
+
+    Response modifyOrder(Params& p) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [id, o] : open_) {
+            if (o.symbol != p["symbol"] || (toInt(p["orderId"]) > 0 ? id != toInt(p["orderId"]) : o.clientOrderId != p["origClientOrderId"])) continue;
+            if (!p["price"].empty()) o.price = toDouble(p["price"]);
+            if (!p["quantity"].empty()) o.origQty = toDouble(p["quantity"]);
+            o.updateTime = nowMs();
+            orderEventLocked(o, "AMENDMENT");
+            return Response{http::status::ok, orderJson(o)};
+        }
+        return apiError(http::status::bad_request, -2013, "Order does not exist.");
+    }
+
+    Response queryOrder(Params& p) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto* book : {&open_, &closed_}) {
+            for (const auto& [id, o] : *book) {
+                if (o.symbol == p["symbol"] && (toInt(p["orderId"]) > 0 ? id == toInt(p["orderId"]) : o.clientOrderId == p["origClientOrderId"])) {
+                    return Response{http::status::ok, orderJson(o)};
+                }
+            }
+        }
+        return apiError(http::status::bad_request, -2013, "Order does not exist.");
+    }
+
+    // Filled and canceled orders stay queryable for a while.
+    void retireLocked(const Order& o) {
+        closed_[o.orderId] = o;
+        if (closed_.size() > 10000) closed_.erase(closed_.begin());
+    }
+
+    Response openOrders(Params& p) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string out = "[";
+        for (const auto& [id, o] : open_) {
+            if (!p["symbol"].empty() && o.symbol != p["symbol"]) continue;
+            if (out.size() > 1) out += ',';
+            out += orderJson(o);
+        }
+        out += ']';
+        return Response{http::status::ok, std::move(out)};
+    }
+
+    const Options& options_;
+    Market& market_;
+    binancerj::net::RequestSigner signer_;
+    std::mutex mutex_;
+    long long nextOrderId_{1000};
+    std::map<long long, Order> open_;
+    std::map<long long, Order> closed_;
+    std::map<std::string, Position> positions_;
+    std::vector<Trade> trades_;
+    long long nextTradeId_{5000};
+    double wallet_{10000.0};
+    long long walletTime_{0};
+    std::vector<std::string> outbox_;  // events of the request being handled
+    std::mutex listenersMutex_;
+    std::map<int, Listener> listeners_;
+    int nextListener_{0};
+    long long minute_{0}, tenSec_{0};
+    int weight_{0}, orders10s_{0}, orders1m_{0};
+};
+
+// ---- Stream sources ----
+
+struct Frame {
+    long long offsetMs;
+    std::string payload;
+};
+
+// Recordings, loaded once per stream name.
+class Recordings {
+public:
+    explicit Recordings(std::string dir) : dir_(std::move(dir)) {}
+
+    std::shared_ptr<const std::vector<Frame>> find(const std::string& stream) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cache_.find(stream);
+        if (it != cache_.end()) return it->second;
+        std::shared_ptr<std::vector<Frame>> frames;
+        std::ifstream in(fs::path(dir_) / (stream + ".jsonl"), std::ios::binary);
+        if (in) {
+            frames = std::make_shared<std::vector<Frame>>();
+            std::string line;
+            while (std::getline(in, line)) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (line.empty()) continue;
+                const std::size_t tab = line.find('\t');
+                if (tab != std::string::npos && line[0] != '{') {
+                    frames->push_back(Frame{toInt(line.substr(0, tab)), line.substr(tab + 1)});
+                } else {
+                    frames->push_back(Frame{-1, line});  // untimed: spaced at the synthetic rate
+                }
+            }
+            telemetry::logEvent("standin", "recording stream=" + stream + " frames=" + std::to_string(frames->size()));
+        }
+        cache_[stream] = frames;
+        return frames;
+    }
+
+private:
+    std::string dir_;
+    std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<const std::vector<Frame>>> cache_;
+};
+
+// Next frame of a synthesized stream, by stream type (<symbol>@trade, @aggTrade, @depth..., @kline_<iv>).
+std::string synthesize(const std::string& stream, Market& market) {
+    const std::size_t at = stream.find('@');
+    std::string sym = stream.substr(0, at);
+    std::transform(sym.begin(), sym.end(), sym.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    const std::string kind = at == std::string::npos ? std::string("trade") : stream.substr(at + 1);
+    const double mid = market.mid(sym), tick = market.tick(sym);
+    const long long now = nowMs();
+    if (kind.rfind("depth", 0) == 0) {
+        const long long first = market.nextUpdateId();
+        const long long last = first + static_cast<long long>(market.uniform(1, 20));
+        for (long long i = first; i < last; ++i) market.nextUpdateId();
+        std::string out = "{\"e\":\"depthUpdate\",\"E\":" + std::to_string(now) + ",\"T\":" + std::to_string(now) + ",\"s\":\"" + sym
+            + "\",\"U\":" + std::to_string(first) + ",\"u\":" + std::to_string(last) + ",\"pu\":" + std::to_string(first - 1) + ",\"b\":[";
+        for (int i = 0; i < 5; ++i) out += std::string(i ? "," : "") + "[\"" + fixed(std::floor(mid / tick) * tick - i * tick, 2) + "\",\"" + fixed(market.uniform(0.0, 3.0), 3) + "\"]";
+        out += "],\"a\":[";
+        for (int i = 0; i < 5; ++i) out += std::string(i ? "," : "") + "[\"" + fixed(std::ceil(mid / tick) * tick + (i + 1) * tick, 2) + "\",\"" + fixed(market.uniform(0.0, 3.0), 3) + "\"]";
+        return out + "]}";
+    }
+    if (kind.rfind("kline_", 0) == 0) {
+        const std::string iv = kind.substr(6);
+        const long long step = intervalMs(iv);
+        const long long t0 = now / step * step;
+        return "{\"e\":\"kline\",\"E\":" + std::to_string(now) + ",\"s\":\"" + sym + "\",\"k\":{\"t\":" + std::to_string(t0) + ",\"T\":" + std::to_string(t0 + step - 1)
+            + ",\"s\":\"" + sym + "\",\"i\":\"" + iv + "\",\"o\":\"" + fixed(mid, 2) + "\",\"c\":\"" + fixed(mid, 2) + "\",\"h\":\"" + fixed(mid + tick, 2)
+            + "\",\"l\":\"" + fixed(mid - tick, 2) + "\",\"v\":\"" + fixed(market.uniform(1, 50), 3) + "\",\"n\":10,\"x\":false,\"q\":\"0\",\"V\":\"0\",\"Q\":\"0\"}}";
+    }
+    const bool buyerMaker = market.uniform(0, 1) < 0.5;
+    const std::string event = kind == "aggTrade" ? "aggTrade" : "trade";
+    return "{\"e\":\"" + event + "\",\"E\":" + std::to_string(now) + ",\"T\":" + std::to_string(now) + ",\"s\":\"" + sym + "\",\"" + (event == "aggTrade" ? "a" : "t")
+        + "\":" + std::to_string(market.nextTradeId()) + ",\"p\":\"" + fixed(std::round(mid / tick) * tick, 2) + "\",\"q\":\"" + fixed(market.uniform(0.001, 2.0), 3)
+        + "\",\"X\":\"MARKET\",\"m\":" + (buyerMaker ? "true" : "false") + "}";
+}
+
+struct Shared {
+    Options options;
+    Market market;
+    Exchange exchange;
+    Recordings recordings;
+    std::atomic<long long> restCalls{0};
+    std::atomic<long long> framesSent{0};
+
+    explicit Shared(Options o) : options(std::move(o)), exchange(options, market), recordings(options.recordDir) {}
+};
+
+// ---- WebSocket session ----
+
+using TlsStream = beast::ssl_stream<beast::tcp_stream>;
+
+class WsSession : public std::enable_shared_from_this<WsSession> {
+public:
+    WsSession(TlsStream&& stream, Shared& shared) : ws_(std::move(stream)), shared_(shared) {}
+
+    void run(http::request<http::string_body> req) {
+        // /ws/<stream> subscribes right away, like the raw stream endpoint.
+        const std::string target(req.target());
+        if (target.rfind("/ws/", 0) == 0 && target.size() > 4) initial_ = target.substr(4);
+        ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::server));
+        ws_.async_accept(req, [self = shared_from_this()](beast::error_code ec) {
+            if (ec) return;
+            telemetry::logCounter("standin", "ws_sessions", 1);
+            if (Exchange::isListenKey(self->initial_)) self->attachUserData();
+            else if (!self->initial_.empty()) self->subscribe(self->initial_);
+            self->read();
+        });
+    }
+
+private:
+    struct Feed {
+        std::string stream;
+        std::shared_ptr<const std::vector<Frame>> frames;
+        std::size_t next{0};
+        asio::steady_timer timer;
+        bool active{true};
+        explicit Feed(asio::any_io_executor ex) : timer(ex) {}
+    };
+
+    void read() {
+        ws_.async_read(buffer_, [self = shared_from_this()](beast::error_code ec, std::size_t) {
+            if (ec) return self->stop();
+            self->onMessage(beast::buffers_to_string(self->buffer_.data()));
+            self->buffer_.consume(self->buffer_.size());
+            self->read();
+        });
+    }
+
+    // {"method":"SUBSCRIBE","params":["btcusdt@trade"],"id":1}
+    void onMessage(const std::string& text) {
+        const bool sub = text.find("\"SUBSCRIBE\"") != std::string::npos;
+        const bool unsub = text.find("\"UNSUBSCRIBE\"") != std::string::npos;
+        std::string id = "null";
+        const std::size_t idPos = text.find("\"id\"");
+        if (idPos != std::string::npos) {
+            const std::size_t start = text.find_first_of("0123456789", idPos);
+            if (start != std::string::npos) id = text.substr(start, text.find_first_not_of("0123456789", start) - start);
+        }
+        const std::size_t open = text.find('['), close = text.find(']');
+        if ((sub || unsub) && open != std::string::npos && close != std::string::npos) {
+            std::size_t pos = open;
+            while ((pos = text.find('"', pos + 1)) != std::string::npos && pos < close) {
+                const std::size_t end = text.find('"', pos + 1);
+                const std::string stream = text.substr(pos + 1, end - pos - 1);
+                if (sub) subscribe(stream); else unsubscribe(stream);
+                pos = end;
+            }
+        }
+        send("{\"result\":null,\"id\":" + id + "}");
+    }
+
+    // Account events come from whichever session's thread changed the account.
+    void attachUserData() {
+        std::weak_ptr<WsSession> weak = shared_from_this();
+        auto executor = ws_.get_executor();
+        listenerId_ = shared_.exchange.addListener([weak, executor](const std::string& event) {
+            asio::post(executor, [weak, event]() {
+                if (auto self = weak.lock(); self && !self->closed_) self->send(event);
+            });
+        });
+    }
+
+    void subscribe(const std::string& stream) {
+        for (auto& f : feeds_) if (f->stream == stream && f->active) return;
+        auto feed = std::make_shared<Feed>(ws_.get_executor());
+        feed->stream = stream;
+        feed->frames = shared_.recordings.find(stream);
+        feeds_.push_back(feed);
+        schedule(feed, 0);
+    }
+
+    void unsubscribe(const std::string& stream) {
+        for (auto& f : feeds_) {
+            if (f->stream == stream) {
+                f->active = false;
+                f->timer.cancel();
+            }
+        }
+        feeds_.erase(std::remove_if(feeds_.begin(), feeds_.end(), [](const std::shared_ptr<Feed>& f) { return !f->active; }), feeds_.end());
+    }
+
+    // Next frame after the recorded gap (scaled by --replay-speed) or the synthetic period.
+    void schedule(const std::shared_ptr<Feed>& feed, long long delayMs) {
+        feed->timer.expires_after(std::chrono::milliseconds(std::max(0LL, delayMs)));
+        feed->timer.async_wait([self = shared_from_this(), feed](beast::error_code ec) {
+            if (ec || !feed->active || self->closed_) return;
+            self->emit(feed);
+        });
+    }
+
+    void emit(const std::shared_ptr<Feed>& feed) {
+        const Options& o = shared_.options;
+        const long long period = 1000 / std::max(1, o.syntheticRate);
+        if (!feed->frames || feed->frames->empty()) {
+            send(synthesize(feed->stream, shared_.market));
+            return schedule(feed, period);
+        }
+        const auto& frames = *feed->frames;
+        const Frame& frame = frames[feed->next];
+        send(frame.payload);
+        const std::size_t following = (feed->next + 1) % frames.size();  // loop the recording
+        long long gap = period;
+        if (frame.offsetMs >= 0 && frames[following].offsetMs >= 0) {
+            gap = following == 0 ? period : frames[following].offsetMs - frame.offsetMs;
+            gap = o.replaySpeed <= 0.0 ? 0 : static_cast<long long>(static_cast<double>(gap) / o.replaySpeed);
+        }
+        feed->next = following;
+        schedule(feed, gap);
+    }
+
+    void send(std::string text) {
+        constexpr std::size_t kMaxQueued = 4096;  // slow reader: drop the oldest frames
+        if (queue_.size() >= kMaxQueued) {
+            queue_.pop_front();
+            telemetry::logCounter("standin", "ws_dropped", 1);
+        }
+        queue_.push_back(std::move(text));
+        if (queue_.size() == 1) write();
+    }
+
+    void write() {
+        ws_.text(true);
+        ws_.async_write(asio::buffer(queue_.front()), [self = shared_from_this()](beast::error_code ec, std::size_t) {
+            if (ec) return self->stop();
+            self->shared_.framesSent.fetch_add(1, std::memory_order_relaxed);
+            self->queue_.pop_front();
+            if (!self->queue_.empty()) self->write();
+        });
+    }
+
+    void stop() {
+        if (closed_) return;
+        closed_ = true;
+        if (listenerId_) shared_.exchange.removeListener(listenerId_);
+        for (auto& f : feeds_) {
+            f->active = false;
+            f->timer.cancel();
+        }
+    }
+
+    websocket::stream<TlsStream> ws_;
+    Shared& shared_;
+    beast::flat_buffer buffer_;
+    std::deque<std::string> queue_;
+    std::vector<std::shared_ptr<Feed>> feeds_;
+    std::string initial_;
+    int listenerId_{0};
+    bool closed_{false};
+};
+
+// ---- WebSocket trading API session (/ws-fapi/v1) ----
+
+// Maps ws-fapi requests onto the REST handlers: {"id":..,"method":"order.place","params":{..}}
+// answers {"id":..,"status":..,"result":..|"error":..,"rateLimits":[..]}. The signature covers
+// the params sorted by key, which is exactly the REST query the handler verifies.
+class WsApiSession : public std::enable_shared_from_this<WsApiSession> {
+public:
+    WsApiSession(TlsStream&& stream, Shared& shared) : ws_(std::move(stream)), shared_(shared) {}
+
+    void run(http::request<http::string_body> req) {
+        ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::server));
+        ws_.async_accept(req, [self = shared_from_this()](beast::error_code ec) {
+            if (ec) return;
+            telemetry::logCounter("standin", "ws_api_sessions", 1);
+            self->read();
+        });
+    }
+
+private:
+    void read() {
+        ws_.async_read(buffer_, [self = shared_from_this()](beast::error_code ec, std::size_t) {
+            if (ec) return;
+            const std::string text = beast::buffers_to_string(self->buffer_.data());
+            self->buffer_.consume(self->buffer_.size());
+            self->onRequest(text);
+            self->read();
+        });
+    }
+
+    void onRequest(const std::string& text) {
+        std::string id = "null";
+        const std::size_t idPos = text.find("\"id\"");
+        if (idPos != std::string::npos) {
+            const std::size_t start = text.find_first_not_of(" :", idPos + 4);
+            const std::size_t end = text[start] == '"' ? text.find('"', start + 1) + 1 : text.find_first_of(",}", start);
+            id = text.substr(start, end - start);
+        }
+        const std::size_t methodPos = text.find("\"method\"");
+        const std::size_t methodStart = methodPos == std::string::npos ? methodPos : text.find('"', text.find(':', methodPos) + 1);
+        const std::string method = methodStart == std::string::npos ? std::string() : text.substr(methodStart + 1, text.find('"', methodStart + 1) - methodStart - 1);
+        const std::size_t paramsPos = text.find("\"params\"");
+        Params params = paramsPos == std::string::npos ? Params{} : jsonFields(std::string_view(text).substr(text.find('{', paramsPos)));
+
+        static const std::map<std::string, std::pair<const char*, const char*>> kRoutes = {
+            {"order.place", {"POST", "/fapi/v1/order"}},
+            {"order.cancel", {"DELETE", "/fapi/v1/order"}},
+            {"order.modify", {"PUT", "/fapi/v1/order"}},
+            {"order.status", {"GET", "/fapi/v1/order"}},
+            {"account.status", {"GET", "/fapi/v2/account"}},
+            {"account.position", {"GET", "/fapi/v2/positionRisk"}},
+        };
+        Exchange::Usage usage{};
+        Response r;
+        auto route = kRoutes.find(method);
+        if (route == kRoutes.end()) {
+            r = apiError(http::status::bad_request, -1100, "Unknown method '" + method + "'.");
+        } else {
+            std::string target = std::string(route->second.second) + "?";
+            std::string signature;
+            bool first = true;
+            for (const auto& [key, value] : params) {  // std::map: sorted by key
+                if (key == "signature") { signature = value; continue; }
+                if (!first) target += '&';
+                first = false;
+                target.append(key).append(1, '=').append(value);
+            }
+            if (!signature.empty()) target.append("&signature=").append(signature);
+            r = shared_.exchange.handle(route->second.first, target, {}, params["apiKey"], usage);
+        }
+
+        const int status = static_cast<int>(r.status);
+        std::string out = "{\"id\":" + id + ",\"status\":" + std::to_string(status) + (status < 300 ? ",\"result\":" : ",\"error\":") + r.body;
+        out += ",\"rateLimits\":[{\"rateLimitType\":\"REQUEST_WEIGHT\",\"interval\":\"MINUTE\",\"intervalNum\":1,\"limit\":" + std::to_string(shared_.options.weightLimit)
+            + ",\"count\":" + std::to_string(usage.weight1m) + "},{\"rateLimitType\":\"ORDERS\",\"interval\":\"SECOND\",\"intervalNum\":10,\"limit\":300,\"count\":"
+            + std::to_string(usage.orders10s) + "},{\"rateLimitType\":\"ORDERS\",\"interval\":\"MINUTE\",\"intervalNum\":1,\"limit\":1200,\"count\":"
+            + std::to_string(usage.orders1m) + "}]}";
+        shared_.restCalls.fetch_add(1, std::memory_order_relaxed);
+
+        const Options& o = shared_.options;
+        long long delay = o.latencyMs;
+        if (o.jitterMs > 0) delay += static_cast<long long>(shared_.market.uniform(0.0, static_cast<double>(o.jitterMs)));
+        if (delay <= 0) return send(std::move(out));
+        // Answers may overtake each other, as on the exchange.
+        auto timer = std::make_shared<asio::steady_timer>(ws_.get_executor(), std::chrono::milliseconds(delay));
+        timer->async_wait([self = shared_from_this(), timer, out = std::move(out)](beast::error_code ec) mutable {
+            if (!ec) self->send(std::move(out));
+        });
+    }
+
+    void send(std::string text) {
+        queue_.push_back(std::move(text));
+        if (queue_.size() == 1) write();
+    }
+
+    void write() {
+        ws_.text(true);
+        ws_.async_write(asio::buffer(queue_.front()), [self = shared_from_this()](beast::error_code ec, std::size_t) {
+            if (ec) return;
+            self->queue_.pop_front();
+            if (!self->queue_.empty()) self->write();
+        });
+    }
+
+    websocket::stream<TlsStream> ws_;
+    Shared& shared_;
+    beast::flat_buffer buffer_;
+    std::deque<std::string> queue_;
+};
+
+// ---- HTTP session ----
+
+class HttpSession : public std::enable_shared_from_this<HttpSession> {
+public:
+    HttpSession(tcp::socket&& socket, ssl::context& ctx, Shared& shared)
+        : stream_(std::move(socket), ctx), delay_(stream_.get_executor()), shared_(shared) {}
+
+    void run() {
+        beast::get_lowest_layer(stream_).expires_after(std::chrono::seconds(30));
+        stream_.async_handshake(ssl::stream_base::server, [self = shared_from_this()](beast::error_code ec) {
+            if (ec) return;
+            self->read();
+        });
+    }
+
+private:
+    void read() {
+        req_ = {};
+        beast::get_lowest_layer(stream_).expires_after(std::chrono::seconds(60));  // idle keep-alive
+        http::async_read(stream_, buffer_, req_, [self = shared_from_this()](beast::error_code ec, std::size_t) {
+            if (ec) return self->close();
+            self->onRequest();
+        });
+    }
+
+    void onRequest() {
+        if (websocket::is_upgrade(req_)) {
+            beast::get_lowest_layer(stream_).expires_never();
+            if (req_.target().starts_with("/ws-fapi")) {
+                std::make_shared<WsApiSession>(std::move(stream_), shared_)->run(std::move(req_));
+            } else {
+                std::make_shared<WsSession>(std::move(stream_), shared_)->run(std::move(req_));
+            }
+            return;
+        }
+        const Options& o = shared_.options;
+        shared_.restCalls.fetch_add(1, std::memory_order_relaxed);
+        Exchange::Usage usage{};
+        Response r;
+        if (o.errorRate > 0.0 && shared_.market.uniform(0.0, 1.0) < o.errorRate) {
+            r = apiError(http::status::service_unavailable, -1001, "Internal error; unable to process your request. Please try again.");
+        } else {
+            const std::string apiKey(req_["X-MBX-APIKEY"]);
+            r = shared_.exchange.handle(std::string(req_.method_string()), std::string(req_.target()), req_.body(), apiKey, usage);
+        }
+
+        res_ = {};
+        res_.version(11);
+        res_.result(r.status);
+        res_.set(http::field::server, "BinanceRJTech-standin");
+        res_.set(http::field::content_type, "application/json");
+        res_.set("X-MBX-USED-WEIGHT-1M", std::to_string(usage.weight1m));
+        if (usage.orders10s > 0) {
+            res_.set("X-MBX-ORDER-COUNT-10S", std::to_string(usage.orders10s));
+            res_.set("X-MBX-ORDER-COUNT-1M", std::to_string(usage.orders1m));
+        }
+        if (r.retryAfter > 0) res_.set(http::field::retry_after, std::to_string(r.retryAfter));
+        res_.keep_alive(req_.keep_alive());
+        res_.body() = std::move(r.body);
+        res_.prepare_payload();
+
+        long long delay = o.latencyMs;
+        if (o.jitterMs > 0) delay += static_cast<long long>(shared_.market.uniform(0.0, static_cast<double>(o.jitterMs)));
+        if (delay <= 0) return write();
+        delay_.expires_after(std::chrono::milliseconds(delay));
+        delay_.async_wait([self = shared_from_this()](beast::error_code ec) {
+            if (!ec) self->write();
+        });
+    }
+
+    void write() {
+        http::async_write(stream_, res_, [self = shared_from_this()](beast::error_code ec, std::size_t) {
+            if (ec || !self->res_.keep_alive()) return self->close();
+            self->read();
+        });
+    }
+
+    void close() {
+        beast::get_lowest_layer(stream_).expires_after(std::chrono::seconds(5));
+        stream_.async_shutdown([self = shared_from_this()](beast::error_code) {
+            beast::get_lowest_layer(self->stream_).close();
+        });
+    }
+
+    TlsStream stream_;
+    asio::steady_timer delay_;
+    Shared& shared_;
+    beast::flat_buffer buffer_;
+    http::request<http::string_body> req_;
+    http::response<http::string_body> res_;
+};
+
+class Listener : public std::enable_shared_from_this<Listener> {
+public:
+    Listener(asio::io_context& ioc, ssl::context& ctx, const tcp::endpoint& endpoint, Shared& shared)
+        : ioc_(ioc), ctx_(ctx), acceptor_(asio::make_strand(ioc)), shared_(shared) {
+        acceptor_.open(endpoint.protocol());
+        acceptor_.set_option(asio::socket_base::reuse_address(true));
+        acceptor_.bind(endpoint);
+        acceptor_.listen(asio::socket_base::max_listen_connections);
+    }
+
+    void accept() {
+        // Each connection gets its own strand: handlers of one session never run concurrently.
+        acceptor_.async_accept(asio::make_strand(ioc_), [self = shared_from_this()](beast::error_code ec, tcp::socket socket) {
+            if (!ec) {
+                socket.set_option(tcp::no_delay(true));
+                std::make_shared<HttpSession>(std::move(socket), self->ctx_, self->shared_)->run();
+            }
+            self->accept();
+        });
+    }
+
+private:
+    asio::io_context& ioc_;
+    ssl::context& ctx_;
+    tcp::acceptor acceptor_;
+    Shared& shared_;
+};
+
+bool parseArgs(int argc, char** argv, Options& o, std::vector<std::string>& positional) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            positional.push_back(arg);
+            continue;
+        }
+        const std::size_t eq = arg.find('=');
+        const std::string key = arg.substr(2, eq == std::string::npos ? std::string::npos : eq - 2);
+        const std::string value = eq == std::string::npos ? std::string() : arg.substr(eq + 1);
+        if (key == "bind") o.bind = value;
+        else if (key == "port") o.port = static_cast<unsigned short>(toInt(value, 8443));
+        else if (key == "threads") o.threads = std::max(1, static_cast<int>(toInt(value, 2)));
+        else if (key == "cert") o.certFile = value;
+        else if (key == "key") o.keyFile = value;
+        else if (key == "cert-out") o.certOut = value;
+        else if (key == "latency-ms") o.latencyMs = static_cast<int>(toInt(value));
+        else if (key == "jitter-ms") o.jitterMs = static_cast<int>(toInt(value));
+        else if (key == "error-rate") o.errorRate = toDouble(value);
+        else if (key == "weight-limit") o.weightLimit = static_cast<int>(toInt(value, 2400));
+        else if (key == "secret") o.secret = value;
+        else if (key == "record-dir") o.recordDir = value;
+        else if (key == "replay-speed") o.replaySpeed = toDouble(value, 1.0);
+        else if (key == "synthetic-rate") o.syntheticRate = static_cast<int>(toInt(value, 10));
+        else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Records a live stream for later replay: "<ms since first frame>\t<payload>" per line.
+int record(const Options& o, const std::string& stream, int seconds) {
+    const auto& endpoints = binancerj::net::Endpoints::get();
+    std::error_code ec;
+    fs::create_directories(o.recordDir, ec);
+    const fs::path path = fs::path(o.recordDir) / (stream + ".jsonl");
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "cannot write " << path.string() << std::endl;
+        return 1;
+    }
+    WebSocket ws(endpoints.streamHost, endpoints.streamPort);
+    ws.connect();
+    ws.send("{\"method\":\"SUBSCRIBE\",\"params\":[\"" + stream + "\"],\"id\":1}");
+    const auto until = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    long long first = -1;
+    std::size_t frames = 0;
+    while (std::chrono::steady_clock::now() < until) {
+        const std::string msg = ws.receive();
+        if (msg.empty()) break;
+        if (msg.find("\"result\"") != std::string::npos && msg.find("\"id\"") != std::string::npos) continue;  // subscription ack
+        const long long now = nowMs();
+        if (first < 0) first = now;
+        out << (now - first) << '\t' << msg << '\n';
+        ++frames;
+    }
+    std::cout << "recorded " << frames << " frames to " << path.string() << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::vector<std::string> positional;
+    if (!parseArgs(argc, argv, options, positional)) return 2;
+    telemetry::startSession("standin");
+
+    try {
+        if (!positional.empty() && positional[0] == "record") {
+            if (positional.size() < 3) {
+                std::cerr << "usage: standin record <stream> <seconds> [--record-dir=dir]" << std::endl;
+                return 2;
+            }
+            return record(options, positional[1], static_cast<int>(toInt(positional[2], 60)));
+        }
+
+        ssl::context ctx(ssl::context::tls_server);
+        SSL_CTX_set_min_proto_version(ctx.native_handle(), TLS1_2_VERSION);
+        CertPair pair;
+        if (!options.certFile.empty()) {
+            pair.certPem = readFile(options.certFile);
+            pair.keyPem = readFile(options.keyFile.empty() ? options.certFile : options.keyFile);
+        } else {
+            pair = makeSelfSigned();
+            std::ofstream(options.certOut, std::ios::binary | std::ios::trunc) << pair.certPem;
+            std::cout << "self-signed certificate written to " << options.certOut << " (use as SSL_CERT_FILE)" << std::endl;
+        }
+        ctx.use_certificate_chain(asio::buffer(pair.certPem));
+        ctx.use_private_key(asio::buffer(pair.keyPem), ssl::context::pem);
+        // Let clients resume sessions, as the exchange does.
+        SSL_CTX_set_session_cache_mode(ctx.native_handle(), SSL_SESS_CACHE_SERVER);
+        SSL_CTX_set_session_id_context(ctx.native_handle(), reinterpret_cast<const unsigned char*>("standin"), 7);
+
+        Shared shared(options);
+        asio::io_context ioc(options.threads);
+        const tcp::endpoint endpoint(asio::ip::make_address(options.bind), options.port);
+        std::make_shared<Listener>(ioc, ctx, endpoint, shared)->accept();
+
+        asio::signal_set signals(ioc, SIGINT, SIGTERM);
+        signals.async_wait([&ioc](beast::error_code, int) { ioc.stop(); });
+
+        std::cout << "stand-in listening on " << options.bind << ":" << options.port << " (latency " << options.latencyMs << "+" << options.jitterMs
+                  << " ms, error rate " << options.errorRate << ", weight limit " << options.weightLimit << ")" << std::endl;
+        std::vector<std::thread> threads;
+        for (int i = 1; i < options.threads; ++i) threads.emplace_back([&ioc] { ioc.run(); });
+        ioc.run();
+        for (auto& t : threads) t.join();
+        std::cout << "served " << shared.restCalls.load() << " REST calls, " << shared.framesSent.load() << " stream frames" << std::endl;
+        telemetry::logCounter("standin", "rest_calls", shared.restCalls.load());
+        telemetry::logCounter("standin", "ws_frames", shared.framesSent.load());
+    } catch (const std::exception& ex) {
+        std::cerr << "stand-in error: " << ex.what() << std::endl;
+        return 1;
+    }
+    telemetry::flush();
+    return 0;
+}
+
+#endif // BINANCE_RJ_ENABLE_STANDIN_SERVER
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace binancerj::core {
+
+// One asset of the futures wallet.
+struct BalanceState {
+    std::string asset;
+    double walletBalance{0.0};
+    double crossWalletBalance{0.0};
+    // REST only: the stream does not carry them. Between reconciles they move with the
+    // wallet balance.
+    double availableBalance{0.0};
+    double marginBalance{0.0};
+    long long updateTimeMs{0};
+};
+
+// One position (symbol + positionSide). Closed positions stay with amount 0.
+struct PositionState {
+    std::string symbol;
+    std::string positionSide;   // BOTH, LONG or SHORT
+    double amount{0.0};         // signed
+    double entryPrice{0.0};
+    double unrealizedPnl{0.0};
+    double markPrice{0.0};      // REST and MARGIN_CALL only
+    double isolatedWallet{0.0};
+    std::string marginType;     // "cross" or "isolated"
+    int leverage{0};
+    long long updateTimeMs{0};
+};
+
+struct OrderState {
+    long long orderId{0};
+    std::string clientOrderId;
+    std::string symbol;
+    std::string side;
+    std::string type;
+    std::string timeInForce;
+    std::string positionSide;
+    std::string status;         // NEW, PARTIALLY_FILLED, FILLED, CANCELED, EXPIRED, ...
+    double price{0.0};
+    double stopPrice{0.0};
+    double origQty{0.0};
+    double executedQty{0.0};
+    double avgPrice{0.0};
+    bool reduceOnly{false};
+    long long updateTimeMs{0};
+
+    bool isOpen() const { return status == "NEW" || status == "PARTIALLY_FILLED"; }
+};
+
+// One execution of one of our orders.
+struct FillState {
+    long long tradeId{0};
+    long long orderId{0};
+    std::string symbol;
+    std::string side;           // BUY or SELL
+    double price{0.0};
+    double qty{0.0};
+    double commission{0.0};
+    std::string commissionAsset;
+    double realizedPnl{0.0};
+    bool maker{false};
+    long long timeMs{0};
+};
+
+// Fill history of a snapshot, oldest first, in immutable chunks shared between snapshots:
+// publishing a new version copies at most the last chunk, not the whole history. Every chunk
+// but the last is full.
+class FillHistory {
+public:
+    static constexpr std::size_t kChunk = 64;
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const FillState& operator[](std::size_t i) const { return (*chunks_[i / kChunk])[i % kChunk]; }
+    const FillState& back() const { return chunks_.back()->back(); }
+
+    // Writer side (AccountState).
+    void append(const FillState& fill);
+    void assign(const std::vector<FillState>& fills);
+    std::vector<FillState> flatten() const;
+    // Removes the oldest chunk while the rest still holds at least `keep` fills; the removed
+    // fills are appended to `dropped`.
+    void trimTo(std::size_t keep, std::vector<FillState>& dropped);
+
+private:
+    std::vector<std::shared_ptr<const std::vector<FillState>>> chunks_;
+    std::size_t size_{0};
+};
+
+// Immutable view of the account at one version.
+struct AccountSnapshot {
+    std::uint64_t version{0};
+    long long updateTimeMs{0};          // exchange time of the newest change
+    double takerRate{0.0005};           // REST only
+    double makerRate{0.0002};
+    bool marginCall{false};             // set by MARGIN_CALL, cleared by the next reconcile
+    std::vector<BalanceState> balances;
+    std::vector<PositionState> positions;
+    std::vector<OrderState> openOrders;
+    FillHistory fills;                  // oldest first, the newest kMaxFills (plus up to a chunk)
+
+    static constexpr std::size_t kMaxFills = 2000;
+
+    const BalanceState* balance(const std::string& asset) const;
+    // Net amount over both position sides; 0 when flat or unknown.
+    double positionAmount(const std::string& symbol) const;
+};
+
+// Account state kept incrementally from user data stream events and periodically reconciled
+// against REST. Writers (the stream) apply changes in place; every change publishes a new
+// immutable snapshot, so readers take a consistent copy with one shared_ptr copy and never
+// see a half-applied event. Any thread.
+class AccountState {
+public:
+    AccountState();
+
+    AccountState(const AccountState&) = delete;
+    AccountState& operator=(const AccountState&) = delete;
+
+    std::shared_ptr<const AccountSnapshot> snapshot() const;
+    std::uint64_t version() const;
+    // Blocks until the version differs from seen or the timeout passes; returns the version.
+    std::uint64_t waitForChange(std::uint64_t seen, std::chrono::milliseconds timeout) const;
+
+    // ---- Stream events ----
+    // ORDER_TRADE_UPDATE: the order's new state, plus the execution when it traded.
+    void applyOrderUpdate(const OrderState& order, const FillState* fill);
+    // ACCOUNT_UPDATE: only the balances and positions that changed.
+    void applyAccountUpdate(const std::vector<BalanceState>& balances, const std::vector<PositionState>& positions, long long eventTimeMs);
+    // ACCOUNT_CONFIG_UPDATE
+    void applyLeverage(const std::string& symbol, int leverage, long long eventTimeMs);
+    // MARGIN_CALL: mark price and unrealized PnL of the positions at risk.
+    void applyMarginCall(const std::vector<PositionState>& positions, long long eventTimeMs);
+
+    // ---- REST reconcile ----
+    // Full replacements fetched at exchange time fetchStartMs. Entries an event touched since
+    // then are newer than the REST answer and are kept; everything else takes the REST value.
+    // Return how many entries REST corrected (missed or wrong events).
+    std::size_t reconcileAccount(const std::vector<BalanceState>& balances, const std::vector<PositionState>& positions, double takerRate, double makerRate, long long fetchStartMs);
+    std::size_t reconcileOpenOrders(const std::vector<OrderState>& orders, long long fetchStartMs);
+    // Recent trades of one symbol (REST backfill); merged by trade id.
+    std::size_t mergeFills(const std::vector<FillState>& fills);
+
+private:
+    void publishLocked(long long timeMs);
+    PositionState& positionLocked(const std::string& symbol, const std::string& positionSide);
+    bool addFillLocked(const FillState& fill);  // false when already known
+    void trimFillsLocked();
+
+    struct FillKey {  // trade ids are per symbol
+        std::string symbol;
+        long long tradeId;
+        bool operator==(const FillKey& o) const { return tradeId == o.tradeId && symbol == o.symbol; }
+    };
+    struct FillKeyHash {
+        std::size_t operator()(const FillKey& k) const { return std::hash<std::string>{}(k.symbol) ^ (std::hash<long long>{}(k.tradeId) * 31); }
+    };
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable changed_;
+    AccountSnapshot working_;
+    std::shared_ptr<const AccountSnapshot> published_;
+    // Orders seen closed, by id -> exchange time, so a reconcile that raced the close does not
+    // bring them back. Pruned by age.
+    std::unordered_map<long long, long long> closedAt_;
+    std::unordered_set<FillKey, FillKeyHash> fillKeys_;  // of working_.fills
+};
+
+} // namespace binancerj::core
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "binancerj/core/Candle.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace binancerj::core {
+
+class KlineCache;
+
+// Inclusive open-time range [from, to] aligned to the interval grid.
+struct TimeRange {
+    long long from;
+    long long to;
+};
+
+// Collects which open times are already present (memory, on-disk cache) and turns a wanted
+// range into the minimal list of klines requests, each covering at most maxPerRequest bars.
+class BackfillPlanner {
+public:
+    explicit BackfillPlanner(long long intervalMs, std::size_t maxPerRequest = 1500);
+
+    // Registers candles sorted by t0; consecutive open times collapse into one covered run.
+    void addCoverage(const std::vector<Candle>& sorted);
+    void addCoverage(const KlineCache& cache, long long from, long long to);
+
+    // Missing open-time ranges inside [from, to].
+    std::vector<TimeRange> missing(long long from, long long to) const;
+    // Missing ranges split into request-sized segments, newest first so the visible end lands first.
+    std::vector<TimeRange> plan(long long from, long long to) const;
+
+    const std::vector<TimeRange>& coverage() const { return runs_; }
+    long long alignDown(long long t) const;
+
+private:
+    void addRun(long long from, long long to);
+
+    long long intervalMs_;
+    std::size_t maxPerRequest_;
+    std::vector<TimeRange> runs_;   // sorted, non-overlapping, non-adjacent
+};
+
+} // namespace binancerj::core
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace binancerj::core {
+
+// One OHLCV bar as returned by /fapi/v1/klines (t0 = open time, t1 = close time, ms).
+struct Candle {
+    long long t0;
+    long long t1;
+    double o;
+    double h;
+    double l;
+    double c;
+    double v;
+};
+
+} // namespace binancerj::core
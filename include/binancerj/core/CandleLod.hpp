@@ -0,0 +1,47 @@
+#pragma once
+
+#include "binancerj/core/Candle.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace binancerj::core {
+
+// Level-of-detail view over a sorted candle series: a segment tree of OHLCV aggregates so the
+// chart can ask for the price range of any window in O(log n) and draw at most one bar per
+// pixel column regardless of how much history is loaded.
+class CandleLod {
+public:
+    // Rebuilds the tree from scratch (O(n)).
+    void build(const std::vector<Candle>& series);
+    // Cheap follow-up for a series that only changed at its end (live bar updates, appends):
+    // O(k log n) for k touched bars. Falls back to build() when history moved.
+    void sync(const std::vector<Candle>& series);
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Index range [first, last) of bars overlapping the open-time window [t0, t1].
+    std::pair<std::size_t, std::size_t> indexRange(long long t0, long long t1) const;
+    // Aggregate of bars [first, last): open of the first, close of the last, high/low/volume
+    // over the range. False when the range is empty.
+    bool aggregate(std::size_t first, std::size_t last, Candle& out) const;
+    // Lowest low / highest high of the bars overlapping [t0, t1].
+    bool priceRange(long long t0, long long t1, double& low, double& high) const;
+
+    // Bars overlapping [t0, t1], merged into groups so that at most `columns` remain. Groups
+    // are aligned to absolute indices so panning does not make bars flicker.
+    void decimate(long long t0, long long t1, std::size_t columns, std::vector<Candle>& out) const;
+
+private:
+    static Candle combine(const Candle& a, const Candle& b);
+    void set(std::size_t index, const Candle& bar);
+    const Candle& leaf(std::size_t index) const { return tree_[capacity_ + index]; }
+
+    std::size_t size_{0};
+    std::size_t capacity_{0};   // leaf count, power of two
+    std::vector<Candle> tree_;  // 1-based heap layout; leaves at [capacity_, 2 * capacity_)
+};
+
+} // namespace binancerj::core
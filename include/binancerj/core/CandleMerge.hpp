@@ -0,0 +1,23 @@
+#pragma once
+
+#include "binancerj/core/Candle.hpp"
+
+#include <vector>
+
+namespace binancerj::core {
+
+// Merges runs that are each sorted by t0 into dest (cleared, reserved once) with a single
+// k-way pass. Duplicate open times keep the candle from the later run, so pass older data
+// first and fresher downloads last.
+void mergeSortedRuns(const std::vector<const std::vector<Candle>*>& runs, std::vector<Candle>& dest);
+
+// Merges parts into base (all sorted by t0; unsorted parts are sorted first). Parts win on
+// duplicate open times. base keeps its capacity when nothing needs to move.
+void mergeCandlesInto(std::vector<Candle>& base, std::vector<std::vector<Candle>>& parts);
+void mergeCandlesInto(std::vector<Candle>& base, std::vector<Candle>& part);
+
+// Live kline path: replaces the bar with the same open time or appends a newer one in place.
+// Returns false when the candle is older than the series and not present (caller backfills).
+bool upsertCandle(std::vector<Candle>& series, const Candle& candle);
+
+} // namespace binancerj::core
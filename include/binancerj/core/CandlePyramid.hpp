@@ -0,0 +1,66 @@
+#pragma once
+
+#include "binancerj/core/Candle.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace binancerj::core {
+
+// Keeps the finest loaded interval for one symbol and derives every coarser interval from
+// it: a parallel reduction on bulk load, then O(1) per level for each live base update.
+// All levels come from the same base bars, so timeframes never disagree.
+class CandlePyramid {
+public:
+    explicit CandlePyramid(long long baseIntervalMs = 60000,
+                           std::vector<long long> levelIntervalsMs = defaultLevels());
+
+    CandlePyramid(const CandlePyramid&) = delete;
+    CandlePyramid& operator=(const CandlePyramid&) = delete;
+
+    // 3m, 5m, 15m, 30m, 1h, 2h, 4h, 6h, 12h, 1d
+    static std::vector<long long> defaultLevels();
+
+    // Replaces the base series (sorted by t0) and rebuilds all levels, then replays the live
+    // bars buffered for symbol since expect().
+    void reset(const std::string& symbol, std::vector<Candle> base);
+    // Starts buffering live bars of symbol for the next reset() with it: a base load started
+    // now does not lose the updates that arrive while it downloads.
+    void expect(const std::string& symbol);
+    // Applies one live base bar (new or updated). False when symbol is neither the loaded one
+    // nor the expected one.
+    bool update(const std::string& symbol, const Candle& baseBar);
+
+    bool supports(long long intervalMs) const;
+    // Copies the series for intervalMs (base or derived). False when unavailable.
+    bool copyLevel(const std::string& symbol, long long intervalMs, std::vector<Candle>& out) const;
+    // Newest bar of intervalMs. False when unavailable.
+    bool latest(const std::string& symbol, long long intervalMs, Candle& out) const;
+
+    std::string symbol() const;
+    std::size_t baseSize() const;
+    long long baseIntervalMs() const { return baseMs_; }
+
+private:
+    struct Level {
+        long long intervalMs;
+        std::vector<Candle> bars;
+    };
+
+    static void reduce(const std::vector<Candle>& base, long long baseMs, Level& level);
+    void updateLocked(const Candle& baseBar);
+    void rebuildBucket(Level& level, long long bucketT0);
+    const std::vector<Candle>* seriesLocked(long long intervalMs) const;
+
+    long long baseMs_;
+    mutable std::mutex mutex_;
+    std::string symbol_;
+    std::vector<Candle> base_;
+    std::vector<Level> levels_;
+    std::string expected_;          // symbol whose live bars are buffered until its reset()
+    std::vector<Candle> buffered_;  // by t0, newest state of each bar
+};
+
+} // namespace binancerj::core
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace binancerj::core {
+
+// Price-volume distribution built incrementally from the public trade tape.
+// Prices are binned into fixed-width buckets. Every candle keeps flat buy/sell arrays
+// (footprint) and the session keeps one profile with POC and value area, so readers
+// only copy prepared buckets and never aggregate raw trades.
+class FootprintAggregator {
+public:
+    struct CandleFootprint {
+        long long t0{0};
+        long long firstBucket{0};      // absolute bucket index of buy[0]/sell[0]
+        std::vector<double> buy;
+        std::vector<double> sell;
+        double buyTotal{0.0};
+        double sellTotal{0.0};
+        double maxBucketVolume{0.0};   // buy+sell of the heaviest bucket (render scale)
+        std::uint64_t version{0};      // aggregator version of its last trade
+    };
+
+    struct SessionProfile {
+        long long sessionStartMs{0};
+        long long firstBucket{0};
+        std::vector<double> buy;
+        std::vector<double> sell;
+        double totalVolume{0.0};
+        long long pocBucket{0};
+        double pocVolume{0.0};
+        long long valueAreaLow{0};     // inclusive bucket range holding valueAreaShare of volume
+        long long valueAreaHigh{0};
+    };
+
+    FootprintAggregator(double bucketSize, long long intervalMs, std::size_t maxCandles = 1440);
+
+    FootprintAggregator(const FootprintAggregator&) = delete;
+    FootprintAggregator& operator=(const FootprintAggregator&) = delete;
+
+    // Drops all state. sessionStartMs <= 0 anchors the session at the current UTC day; a
+    // session lasts kSessionMs, then the next one starts empty.
+    void reset(double bucketSize, long long intervalMs, long long sessionStartMs = 0);
+
+    void addTrade(long long ts, double price, double qty, bool isBuy);
+
+    // Copies candles overlapping [t0, t1] into out, reusing its storage; an entry of out that
+    // already holds the same candle at the same version is left as is. Returns the version.
+    std::uint64_t copyCandles(long long t0, long long t1, std::vector<CandleFootprint>& out) const;
+    // Copies the session profile (value area is prepared lazily here, once per change).
+    std::uint64_t copySession(SessionProfile& out) const;
+    // Buy/sell totals for the candle opening at candleT0; false when the candle is unknown.
+    bool candleTotals(long long candleT0, double& buy, double& sell) const;
+
+    std::uint64_t version() const;
+    double bucketSize() const;
+    long long intervalMs() const;
+    double bucketPrice(long long bucket) const;
+
+    static constexpr double kValueAreaShare = 0.70;
+    static constexpr long long kSessionMs = 24LL * 60 * 60 * 1000;
+
+private:
+    CandleFootprint& candleFor(long long candleT0);
+    void startSessionLocked(long long sessionStartMs);
+    static void addToBuckets(long long bucket, double qty, bool isBuy,
+                             long long& firstBucket, std::vector<double>& buy, std::vector<double>& sell);
+    void prepareValueArea() const;
+
+    mutable std::mutex mutex_;
+    double bucketSize_;
+    long long intervalMs_;
+    std::size_t maxCandles_;
+    std::deque<CandleFootprint> candles_;
+    std::vector<CandleFootprint> spare_;   // recycled candle storage
+    mutable SessionProfile session_;
+    mutable bool valueAreaDirty_{false};
+    std::uint64_t version_{0};
+};
+
+} // namespace binancerj::core
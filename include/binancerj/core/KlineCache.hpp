@@ -0,0 +1,70 @@
+#pragma once
+
+#include "binancerj/core/Candle.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace binancerj::core {
+
+// On-disk kline store for one symbol/interval: one fixed-width column file per field
+// (<root>/<SYMBOL>_<interval>/{t0,t1,o,h,l,c,v}[.<generation>].bin), memory-mapped read-only
+// and indexed by open time. New closed candles are buffered and appended in batches; older
+// history rewrites the set into the next generation, which the manifest file then names.
+class KlineCache {
+public:
+    KlineCache(std::string rootDir, std::string symbol, std::string interval);
+    ~KlineCache();
+
+    KlineCache(const KlineCache&) = delete;
+    KlineCache& operator=(const KlineCache&) = delete;
+
+    // Creates the directory if needed and maps existing columns. False on I/O failure.
+    bool open();
+
+    std::size_t size() const;
+    bool empty() const { return size() == 0; }
+    long long firstOpenTime() const;   // 0 when empty
+    long long lastOpenTime() const;    // 0 when empty
+
+    // Index of the first candle with t0 >= openTime (binary search on the mapped column).
+    std::size_t lowerBound(long long openTime) const;
+    Candle at(std::size_t index) const;
+    // Appends candles with fromT0 <= t0 <= toT0 to out in open-time order. Returns the count.
+    std::size_t read(long long fromT0, long long toT0, std::vector<Candle>& out) const;
+    // Appends the newest maxCount candles to out.
+    std::size_t readTail(std::size_t maxCount, std::vector<Candle>& out) const;
+
+    // Stores closed candles (sorted by t0). Candles newer than the cache are appended (readable
+    // at once, written when the batch fills); anything overlapping or older triggers a merged
+    // rewrite of all columns.
+    bool store(const std::vector<Candle>& closed);
+    // Writes buffered appends now (also done by the destructor).
+    bool flush();
+
+    const std::string& directory() const { return dir_; }
+
+private:
+    struct Impl;
+
+    bool appendLocked(const Candle* first, std::size_t count);
+    bool flushLocked();
+    bool rewriteLocked(const std::vector<Candle>& all);
+    bool remapLocked();
+    void setGenerationLocked(std::uint64_t generation);
+    std::uint64_t readManifestLocked() const;
+    bool writeManifestLocked(std::uint64_t generation);
+    void removeStaleColumnsLocked() const;
+    Candle atLocked(std::size_t index) const;
+    std::size_t lowerBoundLocked(long long openTime) const;
+
+    std::string dir_;
+    mutable std::mutex mutex_;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace binancerj::core
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "binancerj/core/AccountState.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace binancerj::core {
+
+// Lifecycle of one order. Phases only move forward; the last four are terminal.
+enum class OrderPhase : std::uint8_t {
+    PendingNew,       // sent, no answer yet
+    Acked,            // resting (NEW)
+    PartiallyFilled,
+    Filled,
+    Canceled,
+    Rejected,         // refused by the exchange, or never answered
+    Expired,
+};
+
+const char* toString(OrderPhase phase);
+inline bool isTerminal(OrderPhase phase) { return phase >= OrderPhase::Filled; }
+// Exchange status ("NEW", "PARTIALLY_FILLED", ...) -> phase; PendingNew when unknown.
+OrderPhase phaseFromStatus(const std::string& status);
+
+struct ManagedOrder {
+    std::uint32_t slot{0};      // index in the order table, stable while the order is tracked
+    std::uint64_t sequence{0};  // order of first sight
+    OrderPhase phase{OrderPhase::PendingNew};
+    OrderState order;           // last known state; clientOrderId always set
+    long long submitTimeMs{0};  // 0 for orders placed elsewhere (seen in events or REST first)
+    std::string rejectReason;
+
+    bool isOpen() const { return !isTerminal(phase); }
+};
+
+// Open and pending orders at one version, indexed by exchange and client order id.
+struct OrderTableSnapshot {
+    std::uint64_t version{0};
+    std::vector<ManagedOrder> orders;   // submission order
+    std::unordered_map<long long, std::uint32_t> byOrderId;       // -> index in orders
+    std::unordered_map<std::string, std::uint32_t> byClientId;    // -> index in orders
+
+    const ManagedOrder* find(long long orderId) const;
+    const ManagedOrder* findClient(const std::string& clientOrderId) const;
+};
+
+// Order management: assigns newClientOrderIds and tracks every order through its phases from
+// placement answers (REST or WebSocket), user data stream events and periodic REST open-order
+// lists, whichever arrives first. Orders live in a flat slot table with O(1) lookup by either
+// id; every change publishes an immutable snapshot of the open ones, like AccountState. Any
+// thread.
+class OrderManager {
+public:
+    // prefix starts every generated client order id (at most 36 chars in total).
+    explicit OrderManager(std::string prefix = "rj");
+
+    OrderManager(const OrderManager&) = delete;
+    OrderManager& operator=(const OrderManager&) = delete;
+
+    // "<prefix><session>-<sequence>": unique across restarts without any shared state.
+    std::string newClientOrderId();
+
+    // Records an order about to be sent (PendingNew). Assigns order.clientOrderId when empty
+    // and returns it; pass it to the exchange as newClientOrderId.
+    std::string submit(OrderState order, long long nowMs);
+    // Placement answer: the exchange's order object, or the error text.
+    void onAck(const std::string& clientOrderId, const OrderState& ack);
+    void onReject(const std::string& clientOrderId, const std::string& reason, long long nowMs);
+
+    // ORDER_TRADE_UPDATE. Orders placed elsewhere are picked up on their first open event.
+    void applyUpdate(const OrderState& order);
+    // All open orders from REST, fetched at exchange time fetchStartMs. Open orders missing from
+    // it and untouched since are closed (Filled when fully executed, Canceled otherwise). Pending
+    // ones unanswered after kAckTimeoutMs stay pending and are listed in `unanswered`: an IOC or
+    // MARKET order has usually filled already, so query each by clientOrderId, then
+    // applyUpdate() the answer, or onReject() on -2013. Returns how many it corrected.
+    std::size_t reconcile(const std::vector<OrderState>& openOrders, long long fetchStartMs, std::vector<OrderState>* unanswered = nullptr);
+
+    std::shared_ptr<const OrderTableSnapshot> snapshot() const;
+    std::uint64_t version() const;
+    // Blocks until the version differs from seen or the timeout passes; returns the version.
+    std::uint64_t waitForChange(std::uint64_t seen, std::chrono::milliseconds timeout) const;
+
+    // Any tracked order, terminal ones included while retained. False when unknown.
+    bool find(long long orderId, ManagedOrder& out) const;
+    bool findClient(const std::string& clientOrderId, ManagedOrder& out) const;
+
+    static constexpr std::size_t kRetainTerminal = 512;   // closed orders kept for late events
+    static constexpr long long kAckTimeoutMs = 30000;
+
+private:
+    std::uint32_t allocLocked();
+    ManagedOrder* lookupLocked(long long orderId, const std::string& clientOrderId);
+    // Applies an exchange state; false when it is stale or the order already closed.
+    bool advanceLocked(ManagedOrder& m, const OrderState& update);
+    void indexLocked(ManagedOrder& m);
+    void closeLocked(ManagedOrder& m, OrderPhase phase);
+    void publishLocked();
+
+    const std::string prefix_;
+    const std::string session_;
+    std::atomic<std::uint64_t> sequence_{0};
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable changed_;
+    std::vector<ManagedOrder> slots_;
+    std::vector<bool> used_;
+    std::vector<std::uint32_t> free_;
+    std::unordered_map<long long, std::uint32_t> byOrderId_;
+    std::unordered_map<std::string, std::uint32_t> byClientId_;
+    std::deque<std::uint32_t> retired_;   // terminal slots, oldest first
+    std::uint64_t nextSequence_{0};
+    std::uint64_t version_{0};
+    std::shared_ptr<const OrderTableSnapshot> published_;
+};
+
+} // namespace binancerj::core
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace binancerj::core {
+
+// Points an order passes on its way out and back, in pipeline order.
+enum class OrderStage : std::uint8_t {
+    Intent,     // submitted to the order gateway
+    Signed,     // signed and handed over, stamped by the transport (REST: before the I/O thread
+                // sees it; ws-fapi: right before the write)
+    Written,    // request fully written to the socket
+    Acked,      // placement answer received
+    NewEvent,   // user data stream ORDER_TRADE_UPDATE with status NEW
+    FirstFill,  // first TRADE execution event
+};
+constexpr std::size_t kOrderStageCount = 6;
+const char* toString(OrderStage stage);
+
+// Latency histogram in microseconds with four log-spaced buckets per power of two (each about
+// 19% wide), from 1 us to about 70 minutes. Quantiles report the upper edge of their bucket.
+class LatencyHistogram {
+public:
+    static constexpr std::size_t kBuckets = 128;
+
+    void add(double us);
+
+    std::uint64_t count() const { return count_; }
+    double mean() const { return count_ ? sum_ / static_cast<double>(count_) : 0.0; }
+    double min() const { return count_ ? min_ : 0.0; }
+    double max() const { return max_; }
+    double quantile(double q) const;   // q in [0, 1]; 0 when empty
+    const std::array<std::uint64_t, kBuckets>& buckets() const { return buckets_; }
+    static double bucketUpperUs(std::size_t i);
+
+private:
+    std::array<std::uint64_t, kBuckets> buckets_{};
+    std::uint64_t count_{0};
+    double sum_{0.0};
+    double min_{0.0};
+    double max_{0.0};
+};
+
+// End-to-end order latency: every traced order gets a trace id and a timestamp per stage;
+// each stamp closes the spans it ends (queue_sign, write, ack, new_event, first_fill, intent_to_ack)
+// into per-order-type histograms. Stamps may arrive in any order and from any thread; the
+// first stamp of a stage wins. The last `capacity` traces are kept; older ones are dropped.
+class OrderTracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Span {
+        const char* name;
+        OrderStage from;
+        OrderStage to;
+    };
+    static constexpr std::size_t kSpanCount = 6;
+    static const std::array<Span, kSpanCount>& spans();
+
+    // One histogram row of the report.
+    struct SpanStats {
+        std::string orderType;
+        const char* span{""};
+        LatencyHistogram histogram;
+    };
+
+    explicit OrderTracer(std::size_t capacity = 1024);
+
+    OrderTracer(const OrderTracer&) = delete;
+    OrderTracer& operator=(const OrderTracer&) = delete;
+
+    // Starts a trace stamped Intent at `at`; returns its trace id (never 0).
+    std::uint64_t begin(const std::string& clientOrderId, const std::string& orderType, Clock::time_point at);
+    // Stamps a stage; unknown or dropped traces are ignored.
+    void mark(std::uint64_t traceId, OrderStage stage, Clock::time_point at = Clock::now());
+    void mark(const std::string& clientOrderId, OrderStage stage, Clock::time_point at = Clock::now());
+
+    std::vector<SpanStats> stats() const;
+    // Logs count/p50/p99 of every span that gained samples since the last call ("order_trace").
+    void publish();
+    // count, mean, min, p50, p90, p99, max (us) per order type and span.
+    std::string reportCsv() const;
+    // The same plus the non-empty histogram buckets.
+    std::string reportJson() const;
+    // Writes <basePath>.csv and <basePath>.json; false when either fails.
+    bool writeReport(const std::string& basePath) const;
+
+private:
+    struct Trace {
+        std::uint64_t id{0};
+        std::string clientOrderId;
+        std::string orderType;
+        std::array<Clock::time_point, kOrderStageCount> at{};
+        std::uint8_t stamped{0};   // bit per stage
+    };
+    struct TypeStats {
+        std::array<LatencyHistogram, kSpanCount> spans;
+        std::array<std::uint64_t, kSpanCount> published{};
+    };
+
+    void markLocked(Trace& t, OrderStage stage, Clock::time_point at);
+
+    mutable std::mutex mutex_;
+    std::vector<Trace> traces_;   // ring, slot = id % capacity
+    std::unordered_map<std::string, std::uint64_t> byClientId_;
+    std::uint64_t nextId_{0};
+    std::map<std::string, TypeStats> byType_;
+};
+
+} // namespace binancerj::core
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace binancerj::core {
+
+// Streaming quantile estimate (Jain & Chlamtac P-square): five markers, O(1) per sample,
+// no sample storage.
+class P2Quantile {
+public:
+    explicit P2Quantile(double quantile = 0.99)
+        : p_(std::clamp(quantile, 0.001, 0.999)) {
+        reset();
+    }
+
+    void reset() {
+        count_ = 0;
+        q_.fill(0.0);
+        n_ = {0, 1, 2, 3, 4};
+        np_ = {0.0, 2.0 * p_, 4.0 * p_, 2.0 + 2.0 * p_, 4.0};
+        dn_ = {0.0, p_ / 2.0, p_, (1.0 + p_) / 2.0, 1.0};
+    }
+
+    void add(double x) {
+        if (count_ < 5) {
+            q_[count_++] = x;
+            if (count_ == 5) {
+                std::sort(q_.begin(), q_.end());
+            }
+            return;
+        }
+        ++count_;
+
+        int k;
+        if (x < q_[0]) {
+            q_[0] = x;
+            k = 0;
+        } else if (x >= q_[4]) {
+            q_[4] = std::max(q_[4], x);
+            k = 3;
+        } else {
+            k = 0;
+            while (k < 3 && x >= q_[k + 1]) {
+                ++k;
+            }
+        }
+        for (int i = k + 1; i < 5; ++i) {
+            ++n_[i];
+        }
+        for (int i = 0; i < 5; ++i) {
+            np_[i] += dn_[i];
+        }
+
+        for (int i = 1; i <= 3; ++i) {
+            const double d = np_[i] - static_cast<double>(n_[i]);
+            if ((d >= 1.0 && n_[i + 1] - n_[i] > 1) || (d <= -1.0 && n_[i - 1] - n_[i] < -1)) {
+                const int s = d >= 0.0 ? 1 : -1;
+                const double candidate = parabolic(i, s);
+                if (q_[i - 1] < candidate && candidate < q_[i + 1]) {
+                    q_[i] = candidate;
+                } else {
+                    q_[i] = linear(i, s);
+                }
+                n_[i] += s;
+            }
+        }
+    }
+
+    // Estimate; exact order statistic while fewer than five samples have been seen.
+    double value() const {
+        if (count_ == 0) {
+            return 0.0;
+        }
+        if (count_ < 5) {
+            std::array<double, 5> tmp = q_;
+            std::sort(tmp.begin(), tmp.begin() + static_cast<std::ptrdiff_t>(count_));
+            const auto idx = static_cast<std::size_t>(std::lround(p_ * static_cast<double>(count_ - 1)));
+            return tmp[idx];
+        }
+        return q_[2];
+    }
+
+    std::uint64_t count() const { return count_; }
+    double quantile() const { return p_; }
+
+private:
+    double parabolic(int i, int s) const {
+        const double d = static_cast<double>(s);
+        const double ni = static_cast<double>(n_[i]);
+        const double nm = static_cast<double>(n_[i - 1]);
+        const double np = static_cast<double>(n_[i + 1]);
+        return q_[i] + d / (np - nm) *
+            ((ni - nm + d) * (q_[i + 1] - q_[i]) / (np - ni) +
+             (np - ni - d) * (q_[i] - q_[i - 1]) / (ni - nm));
+    }
+
+    double linear(int i, int s) const {
+        return q_[i] + static_cast<double>(s) * (q_[i + s] - q_[i]) /
+            static_cast<double>(n_[i + s] - n_[i]);
+    }
+
+    double p_;
+    std::uint64_t count_{0};
+    std::array<double, 5> q_{};
+    std::array<long long, 5> n_{};
+    std::array<double, 5> np_{};
+    std::array<double, 5> dn_{};
+};
+
+} // namespace binancerj::core
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "binancerj/core/P2Quantile.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace binancerj::core {
+
+struct SweepEvent {
+    enum Flags : std::uint8_t {
+        MultiLevel = 1 << 0,   // taker order walked at least minLevels price levels
+        Outlier = 1 << 1,      // size above the adaptive per-symbol threshold
+    };
+
+    std::uint64_t seq{0};
+    std::uint16_t slot{0};     // caller-assigned symbol slot
+    std::uint8_t flags{0};
+    bool isBuy{true};
+    long long ts{0};
+    double firstPrice{0.0};
+    double lastPrice{0.0};
+    double vwap{0.0};
+    double qty{0.0};
+    double notional{0.0};
+    std::uint32_t trades{0};
+    std::uint32_t levels{0};
+    double threshold{0.0};     // outlier threshold in effect when the event was classified
+};
+
+// Groups trades sharing a timestamp and side (one aggressive order) into sweeps, counts the
+// levels they consumed, and flags outliers against a streaming size quantile per symbol.
+// State is sized at construction; onTrade() never allocates.
+class SweepDetector {
+public:
+    // Copies up to maxLevels resting prices on the side a taker of the given direction consumes,
+    // from fromPrice outward (asks ascending for buys, bids descending for sells). Returns the
+    // count, or -1 when the book of that slot is unavailable. Called when a group opens, before
+    // the sweep has taken the levels out of the book.
+    using LevelProbe = int (*)(void* context, std::uint16_t slot, double fromPrice, bool isBuy,
+                               double* prices, int maxLevels);
+    static constexpr int kProbeLevels = 32;
+
+    SweepDetector(std::size_t maxSymbols = 64, std::size_t eventCapacity = 4096,
+                  double quantile = 0.99, std::uint64_t warmupSamples = 200);
+
+    SweepDetector(const SweepDetector&) = delete;
+    SweepDetector& operator=(const SweepDetector&) = delete;
+
+    void setLevelProbe(LevelProbe probe, void* context);
+    void setMinLevels(std::uint32_t levels);
+
+    void onTrade(std::uint16_t slot, long long ts, double price, double qty, bool isBuy);
+    // Forgets a slot's open group and size distribution (symbol switch).
+    void reset(std::uint16_t slot);
+    // Closes groups whose timestamp is older than nowMs - graceMs (no more fills can join them).
+    void flush(long long nowMs, long long graceMs = 50);
+
+    // Copies events with seq >= cursor into out and advances cursor. Events overwritten by
+    // the ring before being read are skipped. Returns the number copied.
+    std::size_t readSince(std::uint64_t& cursor, std::vector<SweepEvent>& out) const;
+
+    double threshold(std::uint16_t slot) const;
+    std::uint64_t published() const;
+
+private:
+    struct Pending {
+        bool open{false};
+        bool isBuy{true};
+        long long ts{0};
+        double firstPrice{0.0};
+        double lastPrice{0.0};
+        double qty{0.0};
+        double notional{0.0};
+        std::uint32_t trades{0};
+        std::uint32_t distinctPrices{0};
+        int bookLevels{-1};                              // -1 until the open-time snapshot lands
+        std::array<double, kProbeLevels> bookPrices{};
+    };
+
+    struct SymbolState {
+        Pending pending;
+        P2Quantile sizes;
+    };
+
+    // Classifies a group already detached from its slot; called without mutex_ held.
+    void closeGroup(std::uint16_t slot, const Pending& g);
+    // Levels of the open-time snapshot the group's price range covers.
+    static std::uint32_t sweptLevels(const Pending& g);
+    double thresholdLocked(const SymbolState& state) const;
+
+    mutable std::mutex mutex_;
+    std::vector<SymbolState> symbols_;
+    std::vector<SweepEvent> ring_;
+    std::uint64_t nextSeq_{0};
+    double quantile_;
+    std::uint64_t warmupSamples_;
+    std::uint32_t minLevels_{2};
+    LevelProbe probe_{nullptr};
+    void* probeContext_{nullptr};
+};
+
+} // namespace binancerj::core
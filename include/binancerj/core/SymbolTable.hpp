@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace binancerj::core {
+
+using SymbolId = std::int32_t;
+constexpr SymbolId kNoSymbol = -1;
+
+enum class ContractType : std::uint8_t { Perpetual, CurrentQuarter, NextQuarter, Other };
+
+// Trading rules of one futures symbol, from /fapi/v1/exchangeInfo.
+struct SymbolInfo {
+    std::string symbol;
+    ContractType contractType{ContractType::Other};
+    bool trading{false};           // status == TRADING
+    double tickSize{0.0};          // PRICE_FILTER
+    double stepSize{0.0};          // LOT_SIZE
+    double minQty{0.0};
+    double marketStepSize{0.0};    // MARKET_LOT_SIZE (falls back to LOT_SIZE)
+    double marketMinQty{0.0};
+    double minNotional{0.0};       // MIN_NOTIONAL.notional
+    int pricePrecision{0};
+    int quantityPrecision{0};
+
+    // Rounding to the exchange grid; a non-positive increment leaves the value as is.
+    double floorPrice(double price) const;
+    double ceilPrice(double price) const;
+    double floorQty(double qty, bool market = false) const;
+};
+
+// Every symbol's trading rules in a flat array indexed by an interned SymbolId. Built from one
+// full exchangeInfo call and persisted for warm starts. Ids are stable for the process
+// lifetime; info(id) is a single atomic load, so order and book paths can look filters up
+// without locks. A reload publishes new immutable entries only for symbols whose rules changed;
+// replaced entries are kept alive so pointers handed out earlier stay valid.
+class SymbolTable {
+public:
+    static constexpr std::size_t kMaxSymbols = 2048;
+
+    static SymbolTable& instance();
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // Id for a symbol name, allocating one if it is new (kNoSymbol when the table is full).
+    SymbolId intern(std::string_view symbol);
+    // Id of a known symbol, or kNoSymbol. Resolve once per symbol, then use info(id).
+    SymbolId find(std::string_view symbol) const;
+    // Rules of a symbol, or null until loaded.
+    const SymbolInfo* info(SymbolId id) const {
+        return id >= 0 && static_cast<std::size_t>(id) < kMaxSymbols ? slots_[static_cast<std::size_t>(id)].load(std::memory_order_acquire) : nullptr;
+    }
+    const SymbolInfo* info(std::string_view symbol) const { return info(find(symbol)); }
+
+    // Parses a full (or single-symbol) exchangeInfo body. Returns the number of symbols read.
+    std::size_t loadExchangeInfo(std::string_view json);
+    // Compact tab-separated snapshot (one symbol per line).
+    bool save(const std::string& path) const;
+    std::size_t load(const std::string& path);
+
+    std::size_t size() const { return count_.load(std::memory_order_acquire); }
+    // Exchange time of the data (exchangeInfo serverTime), 0 when never loaded.
+    long long updatedMs() const { return updatedMs_.load(std::memory_order_relaxed); }
+
+private:
+    SymbolTable() = default;
+
+    SymbolId internLocked(std::string_view symbol);
+    void publishLocked(SymbolInfo info);
+
+    std::array<std::atomic<const SymbolInfo*>, kMaxSymbols> slots_{};
+    std::atomic<std::size_t> count_{0};
+    std::atomic<long long> updatedMs_{0};
+
+    mutable std::mutex mutex_;  // interning and loads
+    std::unordered_map<std::string, SymbolId> ids_;
+    std::vector<std::unique_ptr<const SymbolInfo>> storage_;  // every entry ever published
+};
+
+} // namespace binancerj::core
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace binancerj::core {
+
+// Sliding time window over a bucketed ring. Expired slots are subtracted from the running
+// sums as the head advances, so both add() and reads are O(1) amortized.
+class RollingVolumeWindow {
+public:
+    struct Totals {
+        double buyVolume{0.0};
+        double sellVolume{0.0};
+        std::uint64_t buyCount{0};
+        std::uint64_t sellCount{0};
+    };
+
+    RollingVolumeWindow(long long spanMs, std::size_t slots);
+
+    void add(long long ts, double qty, bool isBuy);
+    void advanceTo(long long ts);
+    const Totals& totals() const { return totals_; }
+    long long spanMs() const { return spanMs_; }
+    void clear();
+
+private:
+    long long slotMs_;
+    long long spanMs_;
+    long long headSlot_{0};     // absolute slot number (ts / slotMs_) of the newest slot
+    std::vector<Totals> ring_;
+    Totals totals_;
+};
+
+// Streaming trade-tape statistics: anchored VWAP with standard-deviation bands,
+// cumulative volume delta (aggressor buy - sell) and rolling 1s/10s/60s aggressor windows.
+class TradeStats {
+public:
+    static constexpr std::size_t kWindowCount = 3;
+    static constexpr std::array<long long, kWindowCount> kWindowSpansMs{{1000, 10000, 60000}};
+
+    struct Snapshot {
+        long long anchorMs{0};
+        double vwap{0.0};
+        double stdev{0.0};             // volume-weighted price standard deviation around vwap
+        double volume{0.0};            // since anchor
+        double cvd{0.0};               // buy - sell volume since anchor
+        double lastPrice{0.0};
+        long long lastTs{0};
+        std::uint64_t tradeCount{0};
+        std::array<RollingVolumeWindow::Totals, kWindowCount> windows{};
+
+        double band(double k) const { return vwap + k * stdev; }
+    };
+
+    // anchorMs <= 0 anchors at the current UTC day (session VWAP).
+    explicit TradeStats(long long anchorMs = 0);
+
+    TradeStats(const TradeStats&) = delete;
+    TradeStats& operator=(const TradeStats&) = delete;
+
+    // Restarts VWAP and CVD accumulation from anchorMs; rolling windows are kept.
+    void anchor(long long anchorMs);
+    // Drops everything, rolling windows and last trade included (symbol switch), then anchors.
+    void reset(long long anchorMs = 0);
+    void addTrade(long long ts, double price, double qty, bool isBuy);
+    // Rolling windows are evaluated at nowMs so idle periods decay. Pass the exchange clock:
+    // trades carry exchange timestamps. nowMs <= 0 falls back to the local wall clock.
+    Snapshot snapshot(long long nowMs = 0) const;
+
+private:
+    mutable std::mutex mutex_;
+    long long anchorMs_{0};
+    double refPrice_{0.0};             // first price after the anchor; sums are kept relative to it
+    double sumV_{0.0};
+    double sumDV_{0.0};
+    double sumD2V_{0.0};
+    double cvd_{0.0};
+    double lastPrice_{0.0};
+    long long lastTs_{0};
+    std::uint64_t tradeCount_{0};
+    mutable std::array<RollingVolumeWindow, kWindowCount> windows_;
+};
+
+} // namespace binancerj::core
@@ -1,21 +1,76 @@
 #pragma once
 
+#include <functional>
+#include <future>
 #include <string>
 #include <memory>
+#include <vector>
 
-// Minimal Binance Futures REST client (sync) for placing orders
+// Minimal Binance Futures REST client for placing orders
 // Uses HTTPS (Boost.Beast + OpenSSL). API key/secret read from env:
 //   BINANCE_API_KEY, BINANCE_API_SECRET
+// Every call passes the process-wide RateLimitGovernor first: polling and market data are
+// delayed or shed as the request-weight budget fills, order traffic keeps its headroom.
+// Read-only endpoints go through ResponseCache: served from cache within their TTL, and
+// identical calls in flight are coalesced into one.
+// Every endpoint has a blocking form and an *Async form. Async calls run on an io_context
+// owned by the client (one I/O thread, started on first use) and never block the caller.
 
 class BinanceRest {
+    struct AsyncOp;  // one in-flight async call
 public:
     struct Result {
         bool ok{false};
-        int status{0};
+        int status{0};     // HTTP status; -1 transport error/timeout, -2 cancelled, -3 held back by the rate-limit governor
         std::string body;  // JSON or error text
+        int usedWeight1m{-1};   // X-MBX-USED-WEIGHT-1M (-1 when absent)
+        int orderCount10s{-1};  // X-MBX-ORDER-COUNT-10S (-1 when absent)
+        int orderCount1m{-1};   // X-MBX-ORDER-COUNT-1M (-1 when absent)
+        int retryAfterSec{0};   // Retry-After on 418/429
     };
 
-    // baseHost: e.g., "fapi.binance.com" or "testnet.binancefuture.com"
+    struct AsyncOptions {
+        AsyncOptions() : timeoutMs(10000) {}  // explicit: usable as a default argument below
+        int timeoutMs;                                  // whole request; status -1 on expiry
+        std::function<void(const Result&)> onComplete;  // optional; runs on the client's I/O thread
+                                                        // (cache hits and coalesced reads too)
+        std::function<void()> onSigned;                 // optional; once the request is signed and
+                                                        // handed over, always before onWritten (REST:
+                                                        // calling thread; ws-fapi: I/O thread)
+        std::function<void()> onWritten;                // optional; I/O thread, once the request is
+                                                        // fully written (never for cache hits)
+    };
+
+    // Handle to an in-flight async call.
+    class AsyncRequest {
+    public:
+        std::future<Result> result;
+        // Aborts the call if it is still in flight; the result becomes status -2. Any thread.
+        void cancel() const;
+    private:
+        friend class BinanceRest;
+        std::weak_ptr<AsyncOp> op_;
+    };
+
+    // One order of a batch (same fields as placeOrder).
+    struct OrderRequest {
+        std::string symbol;
+        std::string side;
+        std::string type;
+        double quantity{0.0};
+        double price{0.0};
+        std::string timeInForce;    // LIMIT only; "GTC" when empty
+        bool reduceOnly{false};
+        std::string positionSide;
+        double stopPrice{0.0};
+        std::string workingType;
+        std::string newClientOrderId;  // optional
+    };
+    static constexpr std::size_t kMaxBatchOrders = 5;    // per /fapi/v1/batchOrders call
+    static constexpr std::size_t kMaxBatchCancels = 10;  // per DELETE /fapi/v1/batchOrders call
+
+    // baseHost: e.g., "fapi.binance.com" or "testnet.binancefuture.com"; "host:port" for a
+    // non-443 server such as the local stand-in (see binancerj::net::Endpoints)
     explicit BinanceRest(const std::string& baseHost);
     ~BinanceRest();
 
@@ -35,10 +90,31 @@ public:
         const std::string& workingType = ""   // "MARK_PRICE" or "CONTRACT_PRICE"
     );
 
+    // Same, from an OrderRequest (also sends newClientOrderId when set)
+    Result placeOrder(const OrderRequest& order, bool testOnly = true, int recvWindowMs = 5000);
+    // PUT /fapi/v1/order: new price/quantity for an open LIMIT order, keeping its id
+    Result modifyOrder(
+        const std::string& symbol,
+        long long orderId,
+        const std::string& origClientOrderId,  // used when orderId is 0
+        const std::string& side,
+        double quantity,
+        double price,
+        int recvWindowMs = 5000);
+    // GET /fapi/v1/order: status of one order by id or client order id
+    Result queryOrder(const std::string& symbol, long long orderId = 0, const std::string& origClientOrderId = "", int recvWindowMs = 5000);
+
+    // POST /fapi/v1/batchOrders: up to kMaxBatchOrders orders, encoded and signed once. The
+    // body is a JSON array with one order or {"code","msg"} per entry, in request order;
+    // entries succeed or fail independently.
+    Result placeBatchOrders(const std::vector<OrderRequest>& orders, int recvWindowMs = 5000);
+    // DELETE /fapi/v1/batchOrders: up to kMaxBatchCancels orders of one symbol.
+    Result cancelBatchOrders(const std::string& symbol, const std::vector<long long>& orderIds, int recvWindowMs = 5000);
+
     // Optional: ping server time to compute diff
     Result getServerTime();
     Result getAccountInfo(int recvWindowMs = 5000);
-    Result getExchangeInfo(const std::string& symbol); // GET /fapi/v1/exchangeInfo?symbol=BTCUSDT
+    Result getExchangeInfo(const std::string& symbol = ""); // GET /fapi/v1/exchangeInfo?symbol=BTCUSDT; all symbols when empty
     // GET /fapi/v1/klines?symbol=BTCUSDT&interval=1m&startTime=...&endTime=...&limit=1500
     Result getKlines(
         const std::string& symbol,
@@ -48,11 +124,17 @@ public:
         int limit = 500);
 
     // Orders/Fills
-    Result getOpenOrders(const std::string& symbol, int recvWindowMs = 5000);
+    Result getOpenOrders(const std::string& symbol, int recvWindowMs = 5000);  // all symbols when empty (weight 40)
     Result getUserTrades(const std::string& symbol, int limit = 50, int recvWindowMs = 5000);
     // Public ticker price (e.g., "BNBUSDT")
     Result getTickerPrice(const std::string& symbol);
 
+    // User data stream listenKey (one per account; API key only, unsigned). POST returns
+    // {"listenKey":".."}, the existing key when one is active; PUT extends it by 60 minutes.
+    Result startUserDataStream();      // POST /fapi/v1/listenKey
+    Result keepAliveUserDataStream();  // PUT /fapi/v1/listenKey
+    Result closeUserDataStream();      // DELETE /fapi/v1/listenKey
+
     // Cancel orders
     Result cancelOrder(
         const std::string& symbol,
@@ -88,6 +170,80 @@ public:
     Result setMarginType(const std::string& symbol, const std::string& marginType); // CROSS/ISOLATED
     Result setDualPosition(bool enable);                                     // POST /fapi/v1/positionSide/dual
 
+    // Async variants (same parameters, plus options)
+    AsyncRequest placeOrderAsync(
+        const std::string& symbol,
+        const std::string& side,
+        const std::string& type,
+        double quantity,
+        double price = 0.0,
+        const std::string& timeInForce = "GTC",
+        bool reduceOnly = false,
+        bool testOnly = true,
+        int recvWindowMs = 5000,
+        const std::string& positionSide = "",
+        double stopPrice = 0.0,
+        const std::string& workingType = "",
+        AsyncOptions options = {});
+    AsyncRequest placeOrderAsync(const OrderRequest& order, bool testOnly = true, int recvWindowMs = 5000, AsyncOptions options = {});
+    // Live order params serialized ahead of time: recvWindow included, newClientOrderId,
+    // timestamp and signature left out, so placing it only stamps, signs and writes.
+    static std::string serializeOrder(const OrderRequest& order, int recvWindowMs = 5000);
+    // POST /fapi/v1/order with params from serializeOrder(); clientOrderId may be empty.
+    AsyncRequest placeSerializedOrderAsync(const std::string& params, const std::string& clientOrderId, AsyncOptions options = {});
+    AsyncRequest modifyOrderAsync(
+        const std::string& symbol,
+        long long orderId,
+        const std::string& origClientOrderId,
+        const std::string& side,
+        double quantity,
+        double price,
+        int recvWindowMs = 5000,
+        AsyncOptions options = {});
+    AsyncRequest queryOrderAsync(const std::string& symbol, long long orderId = 0, const std::string& origClientOrderId = "", int recvWindowMs = 5000, AsyncOptions options = {});
+    AsyncRequest placeBatchOrdersAsync(const std::vector<OrderRequest>& orders, int recvWindowMs = 5000, AsyncOptions options = {});
+    AsyncRequest cancelBatchOrdersAsync(const std::string& symbol, const std::vector<long long>& orderIds, int recvWindowMs = 5000, AsyncOptions options = {});
+    AsyncRequest getServerTimeAsync(AsyncOptions options = {});
+    AsyncRequest getAccountInfoAsync(int recvWindowMs = 5000, AsyncOptions options = {});
+    AsyncRequest getExchangeInfoAsync(const std::string& symbol = "", AsyncOptions options = {});
+    AsyncRequest getKlinesAsync(
+        const std::string& symbol,
+        const std::string& interval,
+        long long startTime = 0,
+        long long endTime = 0,
+        int limit = 500,
+        AsyncOptions options = {});
+    AsyncRequest getOpenOrdersAsync(const std::string& symbol, int recvWindowMs = 5000, AsyncOptions options = {});
+    AsyncRequest getUserTradesAsync(const std::string& symbol, int limit = 50, int recvWindowMs = 5000, AsyncOptions options = {});
+    AsyncRequest getTickerPriceAsync(const std::string& symbol, AsyncOptions options = {});
+    AsyncRequest startUserDataStreamAsync(AsyncOptions options = {});
+    AsyncRequest keepAliveUserDataStreamAsync(AsyncOptions options = {});
+    AsyncRequest closeUserDataStreamAsync(AsyncOptions options = {});
+    AsyncRequest cancelOrderAsync(
+        const std::string& symbol,
+        long long orderId = 0,
+        const std::string& origClientOrderId = "",
+        int recvWindowMs = 5000,
+        AsyncOptions options = {});
+    AsyncRequest cancelAllOpenOrdersAsync(const std::string& symbol, int recvWindowMs = 5000, AsyncOptions options = {});
+    AsyncRequest getDepthAsync(const std::string& symbol, int limit = 500, AsyncOptions options = {});
+    AsyncRequest cancelReplaceOrderAsync(
+        const std::string& symbol,
+        long long cancelOrderId,
+        const std::string& side,
+        const std::string& type,
+        double quantity,
+        double price,
+        const std::string& timeInForce = "GTC",
+        bool reduceOnly = false,
+        const std::string& positionSide = "",
+        const std::string& cancelReplaceMode = "STOP_ON_FAILURE",
+        int recvWindowMs = 5000,
+        AsyncOptions options = {});
+    AsyncRequest setLeverageAsync(const std::string& symbol, int leverage, AsyncOptions options = {});
+    AsyncRequest setMarginTypeAsync(const std::string& symbol, const std::string& marginType, AsyncOptions options = {});
+    AsyncRequest setDualPositionAsync(bool enable, AsyncOptions options = {});
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
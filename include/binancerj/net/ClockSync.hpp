@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace binancerj::net {
+
+// Estimates the exchange clock from /fapi/v1/time. Each round takes a short burst of samples
+// and keeps the one with the lowest round trip (its midpoint has the smallest error); as in
+// NTP's clock filter the published offset comes from the lowest-delay round of the last
+// few, and a line fitted over recent rounds gives the drift used to extrapolate from it.
+// Readers (request timestamps, latency telemetry) never block: the estimate is published
+// through a seqlock.
+class ClockSync {
+public:
+    static ClockSync& instance();
+
+    ClockSync(const ClockSync&) = delete;
+    ClockSync& operator=(const ClockSync&) = delete;
+    ~ClockSync();
+
+    // Samples once immediately, then every `interval` on a background thread.
+    void start(const std::string& host = "fapi.binance.com", std::chrono::milliseconds interval = std::chrono::seconds(30));
+    void stop();
+    // One sampling round on the calling thread; false if no usable sample was taken.
+    bool sampleNow();
+
+    bool synced() const { return synced_.load(std::memory_order_acquire); }
+    // Exchange minus local clock, extrapolated to now. 0 until the first round succeeds.
+    long long offsetUs() const;
+    long long offsetMs() const { return offsetUs() / 1000; }
+    // Local wall clock corrected to exchange time.
+    long long serverTimeMs() const;
+    // serverTimeMs() when host ("host[:port]") is the one being sampled, the plain local wall
+    // clock for any other: a client of testnet or the stand-in must not use this offset.
+    long long serverTimeMsFor(const std::string& host) const;
+    bool samples(const std::string& host) const;
+    double driftPpm() const;
+    long long rttUs() const { return rttUs_.load(std::memory_order_relaxed); }
+
+    // Exchange event time -> local receive latency, in exchange time.
+    long long exchangeLatencyMs(long long eventTimeMs) const { return serverTimeMs() - eventTimeMs; }
+    // recvWindow that covers the measured round trip plus margin, capped at fallbackMs;
+    // fallbackMs itself until synced.
+    int recvWindowMs(int fallbackMs = 5000) const;
+
+private:
+    struct Point {
+        long long localUs;
+        long long offsetUs;
+        long long rttUs;
+    };
+
+    ClockSync() = default;
+
+    void run(std::chrono::milliseconds interval);
+    void publish(long long refLocalUs, long long offsetUs, double driftPpm);
+    double fitDriftPpm() const;
+
+    // Seqlock-published estimate: offset at refLocalUs plus drift since then.
+    std::atomic<unsigned> seq_{0};
+    std::atomic<long long> refLocalUs_{0};
+    std::atomic<long long> estOffsetUs_{0};
+    std::atomic<double> driftPpm_{0.0};
+    std::atomic<long long> rttUs_{0};
+    std::atomic<bool> synced_{false};
+    std::atomic<std::size_t> hostKey_{std::hash<std::string>{}("fapi.binance.com")};  // of host_, for lock-free samples()
+
+    std::mutex sampleMutex_;  // one sampling round at a time; guards host_ and history_
+    std::string host_{"fapi.binance.com"};
+    std::deque<Point> history_;  // best sample of each recent round
+
+    std::mutex runMutex_;
+    std::condition_variable wake_;
+    bool running_{false};
+    std::thread thread_;
+};
+
+} // namespace binancerj::net
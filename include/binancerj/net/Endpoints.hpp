@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+namespace binancerj::net {
+
+// Exchange hosts the apps connect to. Defaults are the production USD-M futures hosts;
+// BINANCE_RJ_REST_HOST, BINANCE_RJ_STREAM_HOST and BINANCE_RJ_WS_API_HOST ("host" or
+// "host:port") point every client at another server instead, e.g. the local stand-in
+// (apps/standin) for offline tests. BINANCE_RJ_ORDER_TRANSPORT=ws sends orders over the
+// WebSocket trading API instead of REST.
+struct Endpoints {
+    std::string restHost;    // BinanceRest base host, "host[:port]"
+    std::string streamHost;  // market data WebSocket
+    std::string streamPort;
+    std::string wsApiHost;   // WebSocket trading API (WsOrderClient), "host[:port]"
+    bool wsOrderEntry{false}; // order entry over wsApiHost instead of REST
+
+    // Read from the environment once per process.
+    static const Endpoints& get();
+};
+
+// Splits "host[:port]"; port is defaultPort when absent.
+void splitHostPort(const std::string& authority, std::string& host, std::string& port, const char* defaultPort = "443");
+
+} // namespace binancerj::net
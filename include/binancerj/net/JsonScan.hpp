@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace binancerj::net {
+
+// Minimal readers over raw exchange JSON (WebSocket frames, small REST bodies) for the paths
+// that only need a few fields: no DOM, no allocation, values are views into the text.
+// Strings are returned without unescaping; exchange ids, symbols and numbers carry no escapes.
+
+// Index just past the value starting at i (string, object, array or bare literal).
+std::size_t jsonSkipValue(std::string_view s, std::size_t i);
+
+// Raw text of a member of the object starting at (or after) the first '{': quotes included
+// for strings. Empty when absent. Only the top level of that object is searched.
+std::string_view jsonMember(std::string_view object, std::string_view key);
+
+// Calls fn(elementText) for each element of the array starting at (or after) the first '['.
+template <class Fn>
+void jsonForEach(std::string_view array, Fn&& fn) {
+    std::size_t i = array.find('[');
+    if (i == std::string_view::npos) return;
+    ++i;
+    while (i < array.size()) {
+        while (i < array.size() && (array[i] == ',' || array[i] == ' ' || array[i] == '\n' || array[i] == '\r' || array[i] == '\t')) ++i;
+        if (i >= array.size() || array[i] == ']') return;
+        const std::size_t end = jsonSkipValue(array, i);
+        if (end == i) return;
+        fn(array.substr(i, end - i));
+        i = end;
+    }
+}
+
+// Scalar conversions of a member's raw text; quoted numbers ("0.001") are accepted.
+std::string_view jsonUnquote(std::string_view v);
+std::string jsonString(std::string_view v);
+long long jsonLong(std::string_view v, long long fallback = 0);
+double jsonDouble(std::string_view v, double fallback = 0.0);
+bool jsonBool(std::string_view v, bool fallback = false);
+
+} // namespace binancerj::net
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "binancerj/net/BinanceRest.hpp"
+
+#include <string>
+
+namespace binancerj::net {
+
+// Order entry independent of transport: RestOrderEntry (HTTPS) or WsOrderClient (WebSocket
+// trading API). Both take the same requests and return BinanceRest results: HTTP-style status,
+// the exchange's order JSON (or {"code","msg"}) in body, and the rate-limit counters. Orders
+// placed here are live; test orders stay on BinanceRest::placeOrder.
+class OrderEntry {
+public:
+    using Result = BinanceRest::Result;
+    using AsyncRequest = BinanceRest::AsyncRequest;
+    using AsyncOptions = BinanceRest::AsyncOptions;
+    using OrderRequest = BinanceRest::OrderRequest;
+
+    // An order prepared ahead of time: rounded request plus whatever the transport can
+    // serialize before the send (params is empty when it serializes nothing early).
+    struct StagedOrder {
+        OrderRequest order;         // newClientOrderId empty; one is stamped per placement
+        int recvWindowMs{5000};
+        std::string params;
+    };
+
+    virtual ~OrderEntry() = default;
+
+    virtual AsyncRequest placeOrderAsync(const OrderRequest& order, int recvWindowMs = 5000, AsyncOptions options = {}) = 0;
+    // By orderId, or by origClientOrderId when orderId is 0.
+    virtual AsyncRequest cancelOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId = "", int recvWindowMs = 5000, AsyncOptions options = {}) = 0;
+    // New price/quantity for an open LIMIT order.
+    virtual AsyncRequest modifyOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, const std::string& side, double quantity, double price, int recvWindowMs = 5000, AsyncOptions options = {}) = 0;
+    virtual AsyncRequest queryOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId = "", int recvWindowMs = 5000, AsyncOptions options = {}) = 0;
+
+    // Staging runs off the hot path; placeStagedAsync then only stamps the client order id,
+    // timestamp and signature. The defaults serialize at send time like placeOrderAsync.
+    virtual StagedOrder stageOrder(const OrderRequest& order, int recvWindowMs = 5000) const {
+        StagedOrder staged;
+        staged.order = order;
+        staged.order.newClientOrderId.clear();
+        staged.recvWindowMs = recvWindowMs;
+        return staged;
+    }
+    virtual AsyncRequest placeStagedAsync(const StagedOrder& staged, const std::string& clientOrderId, AsyncOptions options = {}) {
+        OrderRequest order = staged.order;
+        order.newClientOrderId = clientOrderId;
+        return placeOrderAsync(order, staged.recvWindowMs, std::move(options));
+    }
+
+    // "rest" or "ws", for telemetry labels.
+    virtual const char* transport() const = 0;
+
+    // Blocking forms.
+    Result placeOrder(const OrderRequest& order, int recvWindowMs = 5000) {
+        return placeOrderAsync(order, recvWindowMs).result.get();
+    }
+    Result cancelOrder(const std::string& symbol, long long orderId, const std::string& origClientOrderId = "", int recvWindowMs = 5000) {
+        return cancelOrderAsync(symbol, orderId, origClientOrderId, recvWindowMs).result.get();
+    }
+    Result modifyOrder(const std::string& symbol, long long orderId, const std::string& origClientOrderId, const std::string& side, double quantity, double price, int recvWindowMs = 5000) {
+        return modifyOrderAsync(symbol, orderId, origClientOrderId, side, quantity, price, recvWindowMs).result.get();
+    }
+    Result queryOrder(const std::string& symbol, long long orderId, const std::string& origClientOrderId = "", int recvWindowMs = 5000) {
+        return queryOrderAsync(symbol, orderId, origClientOrderId, recvWindowMs).result.get();
+    }
+};
+
+// OrderEntry over an existing BinanceRest client (which must outlive it).
+class RestOrderEntry : public OrderEntry {
+public:
+    explicit RestOrderEntry(BinanceRest& rest) : rest_(rest) {}
+
+    AsyncRequest placeOrderAsync(const OrderRequest& order, int recvWindowMs = 5000, AsyncOptions options = {}) override {
+        return rest_.placeOrderAsync(order, false, recvWindowMs, std::move(options));
+    }
+    AsyncRequest cancelOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId = "", int recvWindowMs = 5000, AsyncOptions options = {}) override {
+        return rest_.cancelOrderAsync(symbol, orderId, origClientOrderId, recvWindowMs, std::move(options));
+    }
+    AsyncRequest modifyOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, const std::string& side, double quantity, double price, int recvWindowMs = 5000, AsyncOptions options = {}) override {
+        return rest_.modifyOrderAsync(symbol, orderId, origClientOrderId, side, quantity, price, recvWindowMs, std::move(options));
+    }
+    AsyncRequest queryOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId = "", int recvWindowMs = 5000, AsyncOptions options = {}) override {
+        return rest_.queryOrderAsync(symbol, orderId, origClientOrderId, recvWindowMs, std::move(options));
+    }
+    StagedOrder stageOrder(const OrderRequest& order, int recvWindowMs = 5000) const override {
+        StagedOrder staged = OrderEntry::stageOrder(order, recvWindowMs);
+        staged.params = BinanceRest::serializeOrder(staged.order, recvWindowMs);
+        return staged;
+    }
+    AsyncRequest placeStagedAsync(const StagedOrder& staged, const std::string& clientOrderId, AsyncOptions options = {}) override {
+        return rest_.placeSerializedOrderAsync(staged.params, clientOrderId, std::move(options));
+    }
+    const char* transport() const override { return "rest"; }
+
+private:
+    BinanceRest& rest_;
+};
+
+} // namespace binancerj::net
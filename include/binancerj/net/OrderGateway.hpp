@@ -0,0 +1,84 @@
+#pragma once
+
+#include "binancerj/core/OrderManager.hpp"
+#include "binancerj/core/OrderTracer.hpp"
+#include "binancerj/net/OrderEntry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace binancerj::net {
+
+struct OrderAck;
+
+// One order to place. The gateway assigns newClientOrderId from the OMS when it is empty.
+struct OrderIntent {
+    BinanceRest::OrderRequest order;
+    int recvWindowMs{5000};
+    // Optional: a payload staged by the gateway's transport (OrderStager). When set it is sent
+    // as is and order carries only the client order id.
+    std::shared_ptr<const OrderEntry::StagedOrder> staged;
+    int source{0};          // caller's routing key, echoed in the ack (e.g. which panel sent it)
+    std::string tag;        // caller's label, echoed in the ack
+    // Optional: runs on the transport's I/O thread once the OMS has the answer. Keep it short;
+    // submitting follow-up orders from here is fine.
+    std::function<void(const OrderAck&)> then;
+};
+
+struct OrderAck {
+    std::string clientOrderId;
+    std::uint64_t traceId{0};   // OrderTracer id; 0 when not traced
+    int source{0};
+    std::string tag;
+    BinanceRest::OrderRequest order;
+    BinanceRest::Result result;
+    core::OrderPhase phase{core::OrderPhase::PendingNew};  // OMS phase after the answer
+    double queueUs{0.0};    // submit() -> handed to the transport
+    double ackMs{0.0};      // handed to the transport -> answer
+};
+
+// Order placement off the caller's thread. submit() only pushes the intent onto a lock-free
+// ring and returns; a dedicated submission thread registers it with the OMS (PendingNew) and
+// hands it to the OrderEntry transport, whose async call signs and writes it. Answers settle
+// the order in the OMS, run the intent's then() and queue an OrderAck that the UI drains once
+// per frame. Nothing in here waits on the caller, and the caller never waits on the wire.
+class OrderGateway {
+public:
+    struct Options {
+        Options() : queueCapacity(1024), ackCapacity(1024), spinUs(50) {}  // explicit: usable as a default argument
+        std::size_t queueCapacity;  // intents waiting for the submission thread
+        std::size_t ackCapacity;    // answers waiting for drainAcks(); beyond that they are counted and dropped
+        int spinUs;                 // submission thread polls this long before sleeping
+    };
+
+    // entry and oms must outlive the gateway.
+    OrderGateway(OrderEntry& entry, core::OrderManager& oms, Options options = Options());
+    ~OrderGateway();
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    // Never blocks. Returns the order's client order id, or empty when the queue is full. Any
+    // thread.
+    std::string submit(OrderIntent intent);
+
+    // Moves the answers received so far into out (appending). One consumer thread.
+    std::size_t drainAcks(std::vector<OrderAck>& out);
+
+    // Intents queued or on the wire.
+    std::size_t pending() const;
+
+    // Stamps intent, hand-off, write and answer of every order from now on; null stops.
+    // The tracer must outlive the gateway and its in-flight orders.
+    void setTracer(core::OrderTracer* tracer);
+
+private:
+    struct Impl;
+    std::shared_ptr<Impl> impl_;  // shared with in-flight completions
+};
+
+} // namespace binancerj::net
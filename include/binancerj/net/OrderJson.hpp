@@ -0,0 +1,21 @@
+#pragma once
+
+#include "binancerj/core/AccountState.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace binancerj::net {
+
+// Exchange order objects (REST order/openOrders/batchOrders answers, ws-fapi results) read into
+// core::OrderState with the JsonScan helpers.
+
+// One order object; orderId stays 0 when the text is not an order (e.g. {"code","msg"}).
+core::OrderState parseOrderJson(std::string_view object);
+// Array of order objects; entries without an orderId are skipped.
+std::vector<core::OrderState> parseOrderArray(std::string_view array);
+// "<code> <msg>" of an error object; empty when the text carries no code.
+std::string orderErrorText(std::string_view object);
+
+} // namespace binancerj::net
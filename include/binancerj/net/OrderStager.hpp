@@ -0,0 +1,77 @@
+#pragma once
+
+#include "binancerj/net/OrderEntry.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace binancerj::net {
+
+// Quick orders for one symbol, kept ready to send: an IOC LIMIT buy and sell at the touch sized
+// from the available balance, and a reduce-only IOC close per open position. update() re-rounds
+// and re-serializes them (through the transport's stageOrder) only when an input changed, so a
+// hotkey picks a staged payload and the gateway only stamps, signs and writes it.
+class OrderStager {
+public:
+    struct Position {
+        double amount{0.0};     // signed; > 0 is long
+        double markPrice{0.0};  // price when the book side is empty
+
+        bool operator==(const Position& o) const { return amount == o.amount && markPrice == o.markPrice; }
+    };
+
+    struct Inputs {
+        std::string symbol;
+        double bestBid{0.0};
+        double bestAsk{0.0};
+        double availableUsdt{0.0};
+        double sizePct{100.0};      // of availableUsdt
+        double leverage{1.0};       // notional multiplier (1 when sizing ignores leverage)
+        double qtyStep{0.0};
+        double priceTick{0.0};
+        double minQty{0.0};
+        bool dualSide{false};       // hedge mode: orders carry positionSide
+        std::vector<Position> positions;  // open positions of symbol
+        int recvWindowMs{5000};
+
+        bool operator==(const Inputs& o) const;
+        bool operator!=(const Inputs& o) const { return !(*this == o); }
+    };
+
+    using StagedPtr = std::shared_ptr<const OrderEntry::StagedOrder>;
+
+    struct Staged {
+        std::uint64_t version{0};
+        std::string symbol;
+        StagedPtr buy;                  // null when note says why
+        StagedPtr sell;
+        std::vector<StagedPtr> flatten; // one per position
+        std::string note;               // "No book" / "Qty too small" when buy or sell is missing
+    };
+
+    // entry must outlive the stager; its stageOrder() decides what is serialized ahead.
+    explicit OrderStager(const OrderEntry& entry);
+
+    OrderStager(const OrderStager&) = delete;
+    OrderStager& operator=(const OrderStager&) = delete;
+
+    // Re-stages when in differs from the last call; true when it did. One writer thread.
+    bool update(const Inputs& in);
+
+    // The payloads of the last update (never null). Any thread.
+    std::shared_ptr<const Staged> current() const;
+
+private:
+    const OrderEntry& entry_;
+    Inputs last_;
+    bool primed_{false};
+    std::uint64_t version_{0};
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const Staged> published_;
+};
+
+} // namespace binancerj::net
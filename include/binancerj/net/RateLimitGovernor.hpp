@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace binancerj::net {
+
+// Process-wide admission control for every BinanceRest call. Tracks the account's request
+// weight and order count per exchange window from the X-MBX-USED-WEIGHT-1M and
+// X-MBX-ORDER-COUNT-10S/1M headers (plus a local estimate between responses), models the
+// weight of each endpoint, and as the budget fills delays, then sheds, market-data and
+// polling calls so order traffic keeps its headroom. A 429/418 Retry-After stops everything
+// until it expires. Cancels never count as orders and are never delayed or shed for budget or
+// a 429, but a 418 IP ban stops them too: every call during the ban extends it.
+class RateLimitGovernor {
+public:
+    enum class Priority { Order = 0, Account = 1, Market = 2, Cancel = 3 };
+
+    struct Classified {
+        Priority priority;
+        int weight;
+        int orders{0};  // charge against the order-count limits (a batch counts each order)
+    };
+
+    struct Decision {
+        enum Kind { Admit, Delay, Shed } kind;
+        int delayMs;         // Delay: re-ask after this long
+        const char* reason;  // Shed
+    };
+
+    struct Limits {
+        int weight1m;
+        int orders10s;
+        int orders1m;
+    };
+
+    static RateLimitGovernor& instance();
+
+    RateLimitGovernor(const RateLimitGovernor&) = delete;
+    RateLimitGovernor& operator=(const RateLimitGovernor&) = delete;
+
+    // Priority and documented request weight of a call, from its method and target.
+    static Classified classify(const std::string& method, const std::string& target);
+
+    // Asks to send a call; `waitedMs` is how long it has already been delayed. Admitted
+    // calls are charged to the local estimate right away.
+    Decision admit(const Classified& cost, int waitedMs);
+    // How long a call of this cost should be held before admit() would take it without delay
+    // or shedding (0: now). Charges nothing; lets a queue wait out the budget and back-off
+    // instead of sending calls into a shed.
+    int holdMs(const Classified& cost) const;
+    // Feeds back response headers and status (429/418 with Retry-After).
+    void onResponse(int status, int usedWeight1m, int orderCount10s, int orderCount1m, int retryAfterSec);
+
+    void setLimits(const Limits& limits);
+    Limits limits() const;
+    int usedWeight1m() const { return usedWeight_.load(std::memory_order_relaxed); }
+    int orderCount10s() const { return orders10s_.load(std::memory_order_relaxed); }
+    bool backingOff() const;
+
+private:
+    RateLimitGovernor() = default;
+
+    void rollWindowsLocked(long long nowMs);
+
+    mutable std::mutex mutex_;
+    Limits limits_{2400, 300, 1200};
+    long long minuteWindow_{0};   // exchange minute the weight/1m counts belong to
+    long long tenSecWindow_{0};
+    std::atomic<int> usedWeight_{0};
+    std::atomic<int> orders10s_{0};
+    int orders1m_{0};
+    std::chrono::steady_clock::time_point backoffUntil_{};
+    std::chrono::steady_clock::time_point banUntil_{};  // 418: cancels are refused as well
+};
+
+} // namespace binancerj::net
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <openssl/evp.h>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace binancerj::net {
+
+// Builds `k=v&k=v` query strings into a reusable buffer; numbers go through std::to_chars,
+// so a warmed-up builder does not allocate. The buffer may start with a "path?" prefix.
+class QueryBuilder {
+public:
+    void clear() { buf_.clear(); }
+    void reserve(std::size_t bytes) { buf_.reserve(bytes); }
+
+    QueryBuilder& add(std::string_view key, std::string_view value);
+    QueryBuilder& add(std::string_view key, long long value);
+    QueryBuilder& add(std::string_view key, int value) { return add(key, static_cast<long long>(value)); }
+    // Fixed-point, e.g. addFixed("quantity", 0.001) -> quantity=0.00100000
+    QueryBuilder& addFixed(std::string_view key, double value, int decimals = 8);
+
+    bool empty() const { return buf_.empty(); }
+    const std::string& str() const { return buf_; }
+    std::string& buffer() { return buf_; }
+
+private:
+    void appendKey(std::string_view key);
+
+    std::string buf_;
+};
+
+// HMAC-SHA256 signer for Binance signed endpoints. The keyed inner/outer digest states are
+// computed once per secret and cloned per request instead of re-deriving the pads each call.
+class RequestSigner {
+public:
+    static constexpr std::size_t kHexLength = 64;
+
+    explicit RequestSigner(std::string_view secret = {});
+    ~RequestSigner();
+
+    RequestSigner(const RequestSigner&) = delete;
+    RequestSigner& operator=(const RequestSigner&) = delete;
+
+    void setSecret(std::string_view secret);
+
+    // Writes the lowercase hex HMAC of payload to out (kHexLength chars, not terminated).
+    void sign(std::string_view payload, char* out) const;
+    // Appends "&signature=<hex>" for the current contents of query.
+    void appendSignature(std::string& query) const;
+
+    // Lowercase hex through a lookup table; out must hold 2 * len chars.
+    static void toHex(const unsigned char* data, std::size_t len, char* out);
+
+private:
+    mutable std::mutex mutex_;  // guards work_; signing is short, so contention stays negligible
+    EVP_MD_CTX* inner_{nullptr};
+    EVP_MD_CTX* outer_{nullptr};
+    EVP_MD_CTX* work_{nullptr};
+};
+
+} // namespace binancerj::net
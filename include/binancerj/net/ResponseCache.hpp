@@ -0,0 +1,82 @@
+#pragma once
+
+#include "binancerj/net/BinanceRest.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace binancerj::net {
+
+// Process-wide cache in front of BinanceRest's public and read-only endpoints. Successful
+// responses are kept for a per-endpoint TTL, and identical calls issued while one is already
+// in flight wait for that call instead of sending their own (single-flight), so duplicate
+// round trips and request weight go away. Keys are scoped by host, and by API key for signed
+// endpoints; recvWindow is not part of the key. Any signed write (order, cancel, leverage...)
+// invalidates its account's entries so the next read sees the change. A lead that gives up
+// (cancelled, timed out, connection lost) does not pass its failure on: the oldest waiter
+// takes the flight over and fetches instead.
+class ResponseCache {
+public:
+    using Result = BinanceRest::Result;
+    // Called once with the shared result, or with lead = true when the flight was handed over:
+    // the waiter must then fetch itself and complete() (r is the failure the previous lead saw).
+    using Waiter = std::function<void(const Result& r, bool lead)>;
+
+    enum class Lookup {
+        Hit,     // out holds a fresh cached result
+        Joined,  // an identical call is in flight; the waiter runs when it completes
+        Lead,    // caller must fetch and then call complete()
+    };
+
+    static ResponseCache& instance();
+
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    // How long a GET on `path` may be served from cache: 0 = coalesce in-flight calls only,
+    // negative = bypass (e.g. /fapi/v1/time, whose round trip ClockSync measures).
+    static std::chrono::milliseconds ttlFor(const std::string& path);
+    // scope + path + params, without recvWindow.
+    static std::string makeKey(const std::string& scope, const std::string& path, const std::string& params);
+
+    // Joined: *ticket (when given) identifies the waiter for leave().
+    Lookup acquire(const std::string& key, Result& out, Waiter waiter, std::uint64_t* ticket = nullptr);
+    // Ends the flight the Lead caller started: stores ok results for `ttl` (unless the scope
+    // was invalidated meanwhile) and hands `r` to every joined waiter. A transport failure or
+    // cancellation (status -1/-2) is the lead's own: the oldest waiter leads instead.
+    void complete(const std::string& key, std::chrono::milliseconds ttl, const Result& r);
+    // Withdraws a joined waiter that stopped waiting (its own deadline or cancel). False when
+    // it was already called, or is about to be.
+    bool leave(const std::string& key, std::uint64_t ticket);
+    // Drops every entry of a scope and keeps in-flight reads from storing older data.
+    void invalidate(const std::string& scope);
+    void clear();
+
+private:
+    struct Entry {
+        Result result;
+        std::chrono::steady_clock::time_point expires{};
+    };
+
+    struct Flight {
+        std::uint64_t generation{0};
+        std::vector<std::pair<std::uint64_t, Waiter>> waiters;  // by ticket, oldest first
+    };
+
+    ResponseCache() = default;
+
+    std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    std::map<std::string, Flight> flights_;
+    std::uint64_t generation_{0};  // bumped by invalidate()/clear()
+    std::uint64_t nextTicket_{0};
+};
+
+} // namespace binancerj::net
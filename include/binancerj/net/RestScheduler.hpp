@@ -0,0 +1,102 @@
+#pragma once
+
+#include "binancerj/net/BinanceRest.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace binancerj::net {
+
+// Runs REST jobs over a bounded set of long-lived clients (one per worker thread), paced by a
+// token bucket per endpoint class. Weight budget and 429/418 back-off are RateLimitGovernor's:
+// a job stays queued while the governor would delay or shed its class, and a job the governor
+// sheds anyway (status -3, never sent) goes back into the queue a few times.
+// Lower priority values run first; equal priorities run in submission order.
+class RestScheduler {
+public:
+    enum class EndpointClass : std::size_t { Market = 0, Account, Order, Count };
+
+    struct BucketConfig {
+        double ratePerSec;   // weight refilled per second
+        double burst;        // bucket capacity
+    };
+
+    struct Options {
+        std::string host{"fapi.binance.com"};
+        std::size_t connections{4};
+        int maxShedRetries{3};             // requeues of a job shed locally before its -3 is returned
+        std::array<BucketConfig, static_cast<std::size_t>(EndpointClass::Count)> buckets{{
+            {30.0, 300.0},   // Market: klines/depth/ticker
+            {10.0, 60.0},    // Account: account/openOrders/userTrades
+            {20.0, 40.0},    // Order: order placement/cancel
+        }};
+    };
+
+    using Job = std::function<BinanceRest::Result(BinanceRest&)>;
+
+    explicit RestScheduler(Options options);
+    ~RestScheduler();
+
+    RestScheduler(const RestScheduler&) = delete;
+    RestScheduler& operator=(const RestScheduler&) = delete;
+
+    // Queues a job costing `weight` request weight. The future carries the REST result; a
+    // scheduler shut down before dispatch yields status -1.
+    std::future<BinanceRest::Result> submit(EndpointClass cls, int weight, int priority, Job job);
+
+    void shutdown();
+    std::size_t pending() const;
+
+    // Process-wide scheduler for market data on Endpoints::get().restHost.
+    static RestScheduler& shared();
+    // Request weight of GET /fapi/v1/klines for a given limit.
+    static int klinesWeight(int limit);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        int priority;
+        std::uint64_t seq;
+        int weight;
+        int sheds;
+        Job job;
+        std::shared_ptr<std::promise<BinanceRest::Result>> promise;
+    };
+    struct TaskOrder {
+        bool operator()(const Task& a, const Task& b) const {
+            if (a.priority != b.priority) return a.priority > b.priority;
+            return a.seq > b.seq;
+        }
+    };
+    struct Bucket {
+        BucketConfig config;
+        double tokens;
+        Clock::time_point refilled;
+    };
+
+    void workerLoop(std::size_t index);
+    void refillLocked(Bucket& bucket, Clock::time_point now);
+
+    Options options_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_{false};
+    std::uint64_t nextSeq_{0};
+    std::array<std::priority_queue<Task, std::vector<Task>, TaskOrder>, static_cast<std::size_t>(EndpointClass::Count)> queues_;
+    std::array<Bucket, static_cast<std::size_t>(EndpointClass::Count)> buckets_;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace binancerj::net
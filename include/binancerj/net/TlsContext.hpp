@@ -0,0 +1,50 @@
+#pragma once
+
+#include <boost/asio/ssl/context.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace binancerj::net {
+
+// Process-wide TLS client contexts shared by REST and WebSocket clients. Trust stores are
+// loaded once per context, and negotiated sessions (TLS 1.2 session IDs and TLS 1.3
+// tickets) are cached per host so reconnects resume instead of running a full handshake.
+class TlsContextFactory {
+public:
+    static TlsContextFactory& instance();
+
+    TlsContextFactory(const TlsContextFactory&) = delete;
+    TlsContextFactory& operator=(const TlsContextFactory&) = delete;
+    ~TlsContextFactory();
+
+    // Shared client context; lives for the whole process.
+    boost::asio::ssl::context& client(bool verifyPeer = true);
+
+    // Call on a fresh connection before the TLS handshake: sets SNI and offers the cached
+    // session for host, if any.
+    void prepare(SSL* ssl, const std::string& host);
+    // Call after a successful handshake; counts resumed vs full handshakes.
+    void handshakeDone(SSL* ssl);
+    // Drops the cached session for host (e.g. after a handshake failure).
+    void forget(const std::string& host);
+
+    std::size_t cachedSessions() const;
+
+private:
+    TlsContextFactory() = default;
+
+    std::unique_ptr<boost::asio::ssl::context> makeContext(bool verifyPeer);
+    std::string sessionKeyLocked(SSL* ssl, const std::string& host) const;
+    void store(SSL* ssl, const std::string& host, SSL_SESSION* session);
+    static int onNewSession(SSL* ssl, SSL_SESSION* session);
+
+    mutable std::mutex mutex_;
+    std::unique_ptr<boost::asio::ssl::context> verified_;
+    std::unique_ptr<boost::asio::ssl::context> insecure_;
+    std::map<std::string, SSL_SESSION*> sessions_;
+};
+
+} // namespace binancerj::net
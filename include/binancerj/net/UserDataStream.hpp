@@ -0,0 +1,65 @@
+#pragma once
+
+#include "binancerj/core/AccountState.hpp"
+#include "binancerj/core/OrderManager.hpp"
+#include "binancerj/core/OrderTracer.hpp"
+
+#include <memory>
+#include <string>
+
+namespace binancerj::net {
+
+// Account state pushed by the USD-M user data stream instead of polled. Obtains a listenKey
+// (POST /fapi/v1/listenKey), keeps it alive, and applies ORDER_TRADE_UPDATE, ACCOUNT_UPDATE,
+// ACCOUNT_CONFIG_UPDATE and MARGIN_CALL events to an AccountState as they arrive. One I/O
+// thread per stream.
+//
+// REST stays as the safety net, at low frequency: a full reconcile (account + all open orders)
+// after every (re)connect and every reconcileIntervalSec, and an account-only refresh shortly
+// after ACCOUNT_UPDATE bursts, for the available/margin balances the events do not carry.
+// Watched symbols get their recent trades backfilled after each connect, since fills that
+// happened while disconnected never arrive as events.
+class UserDataStream {
+public:
+    struct Options {
+        Options() : reconcileIntervalSec(60), keepAliveIntervalSec(1800), accountRefreshDelayMs(1000), fillBackfillLimit(500) {}  // explicit: usable as a default argument
+        int reconcileIntervalSec;    // full REST reconcile period
+        int keepAliveIntervalSec;    // listenKey PUT period; the key lapses after 60 minutes
+        int accountRefreshDelayMs;   // ACCOUNT_UPDATE -> account refresh, coalesced
+        int fillBackfillLimit;       // userTrades per watched symbol after each connect
+    };
+
+    explicit UserDataStream(Options options = Options());
+    ~UserDataStream();
+
+    UserDataStream(const UserDataStream&) = delete;
+    UserDataStream& operator=(const UserDataStream&) = delete;
+
+    // Configure API key/secret (fallback to env BINANCE_API_KEY / BINANCE_API_SECRET)
+    void setCredentials(const std::string& apiKey, const std::string& apiSecret);
+    void setInsecureTLS(bool v);
+
+    // Gets the listenKey and connects; reconnects on its own from then on. Idempotent.
+    void start();
+    bool connected() const;
+
+    // Adds a symbol whose recent fills are backfilled over REST (now, and after reconnects).
+    void watchSymbol(const std::string& symbol);
+    // Also feeds ORDER_TRADE_UPDATE events and the periodic open-order lists into oms (which
+    // must outlive the stream); nullptr detaches.
+    void setOrderManager(core::OrderManager* oms);
+    // Stamps NewEvent and FirstFill on traced orders at event receipt (tracer must outlive the
+    // stream); nullptr detaches.
+    void setOrderTracer(core::OrderTracer* tracer);
+    // Runs a full REST reconcile now (coalesced with one already running).
+    void requestReconcile();
+
+    const core::AccountState& state() const;
+    std::shared_ptr<const core::AccountSnapshot> snapshot() const { return state().snapshot(); }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace binancerj::net
@@ -25,7 +25,7 @@ private:
     std::string host_;
     std::string port_;
     boost::asio::io_context io_context_;
-    boost::asio::ssl::context ssl_context_; 
+    boost::asio::ssl::context& ssl_context_; // shared, from TlsContextFactory
     boost::beast::websocket::stream<boost::beast::ssl_stream<boost::asio::ip::tcp::socket>> ws_;
 
 };
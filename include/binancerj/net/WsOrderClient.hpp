@@ -0,0 +1,52 @@
+#pragma once
+
+#include "binancerj/net/OrderEntry.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace binancerj::net {
+
+// Order entry over the Futures WebSocket trading API (ws-fapi, /ws-fapi/v1). One persistent
+// TLS WebSocket per client; requests are correlated by id and pipelined, so any number can be
+// outstanding and responses may come back in any order. Same requests and results as
+// RestOrderEntry without HTTP framing or per-call connection checks.
+//
+// Each request carries apiKey, timestamp and an HMAC signature over its sorted params
+// (session.logon needs an Ed25519 key). The session opens on connect() or the first request
+// and comes back after a drop; requests queued meanwhile go out once it is up. A request
+// already written when the connection drops fails with status -1: the exchange may have acted
+// on it, so check with queryOrder before resending. AsyncRequest::cancel() has no effect.
+class WsOrderClient : public OrderEntry {
+public:
+    // wsApiHost: "host[:port]"; empty means Endpoints::get().wsApiHost.
+    explicit WsOrderClient(const std::string& wsApiHost = {});
+    ~WsOrderClient() override;
+
+    WsOrderClient(const WsOrderClient&) = delete;
+    WsOrderClient& operator=(const WsOrderClient&) = delete;
+
+    // Configure API key/secret (fallback to env BINANCE_API_KEY / BINANCE_API_SECRET)
+    void setCredentials(const std::string& apiKey, const std::string& apiSecret);
+    void setInsecureTLS(bool v);
+
+    // Opens the session now, so the first order does not pay for the connect, and keeps it
+    // open from then on.
+    void connect();
+    bool connected() const;
+    // Requests queued or written and not yet answered.
+    std::size_t inFlight() const;
+
+    AsyncRequest placeOrderAsync(const OrderRequest& order, int recvWindowMs = 5000, AsyncOptions options = {}) override;
+    AsyncRequest cancelOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId = "", int recvWindowMs = 5000, AsyncOptions options = {}) override;
+    AsyncRequest modifyOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, const std::string& side, double quantity, double price, int recvWindowMs = 5000, AsyncOptions options = {}) override;
+    AsyncRequest queryOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId = "", int recvWindowMs = 5000, AsyncOptions options = {}) override;
+    const char* transport() const override { return "ws"; }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace binancerj::net
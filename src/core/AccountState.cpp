@@ -0,0 +1,337 @@
+#include "binancerj/core/AccountState.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace binancerj::core {
+
+namespace {
+
+constexpr std::size_t kMaxClosedIds = 4096;
+constexpr long long kClosedRetentionMs = 10LL * 60 * 1000;
+
+bool differs(double a, double b) {
+    return std::abs(a - b) > 1e-9 * std::max(1.0, std::max(std::abs(a), std::abs(b)));
+}
+
+bool fillBefore(const FillState& a, const FillState& b) {
+    return a.timeMs < b.timeMs;
+}
+
+} // namespace
+
+void FillHistory::append(const FillState& fill) {
+    if (chunks_.empty() || chunks_.back()->size() == kChunk) {
+        auto chunk = std::make_shared<std::vector<FillState>>();
+        chunk->reserve(kChunk);
+        chunk->push_back(fill);
+        chunks_.push_back(std::move(chunk));
+    } else {
+        // Snapshots already published share the old last chunk: replace it, never modify it.
+        auto chunk = std::make_shared<std::vector<FillState>>(*chunks_.back());
+        chunk->push_back(fill);
+        chunks_.back() = std::move(chunk);
+    }
+    ++size_;
+}
+
+void FillHistory::assign(const std::vector<FillState>& fills) {
+    chunks_.clear();
+    for (std::size_t i = 0; i < fills.size(); i += kChunk) {
+        const auto end = fills.begin() + static_cast<std::ptrdiff_t>(std::min(fills.size(), i + kChunk));
+        chunks_.push_back(std::make_shared<const std::vector<FillState>>(fills.begin() + static_cast<std::ptrdiff_t>(i), end));
+    }
+    size_ = fills.size();
+}
+
+std::vector<FillState> FillHistory::flatten() const {
+    std::vector<FillState> out;
+    out.reserve(size_);
+    for (const auto& chunk : chunks_) out.insert(out.end(), chunk->begin(), chunk->end());
+    return out;
+}
+
+void FillHistory::trimTo(std::size_t keep, std::vector<FillState>& dropped) {
+    std::size_t drop = 0;
+    std::size_t remaining = size_;
+    while (drop < chunks_.size() && remaining - chunks_[drop]->size() >= keep) {
+        remaining -= chunks_[drop]->size();
+        dropped.insert(dropped.end(), chunks_[drop]->begin(), chunks_[drop]->end());
+        ++drop;
+    }
+    chunks_.erase(chunks_.begin(), chunks_.begin() + static_cast<std::ptrdiff_t>(drop));
+    size_ = remaining;
+}
+
+const BalanceState* AccountSnapshot::balance(const std::string& asset) const {
+    for (const auto& b : balances) {
+        if (b.asset == asset) return &b;
+    }
+    return nullptr;
+}
+
+double AccountSnapshot::positionAmount(const std::string& symbol) const {
+    double amount = 0.0;
+    for (const auto& p : positions) {
+        if (p.symbol == symbol) amount += p.amount;
+    }
+    return amount;
+}
+
+AccountState::AccountState() : published_(std::make_shared<const AccountSnapshot>()) {}
+
+std::shared_ptr<const AccountSnapshot> AccountState::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_;
+}
+
+std::uint64_t AccountState::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_->version;
+}
+
+std::uint64_t AccountState::waitForChange(std::uint64_t seen, std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait_for(lock, timeout, [this, seen]() { return published_->version != seen; });
+    return published_->version;
+}
+
+void AccountState::publishLocked(long long timeMs) {
+    ++working_.version;
+    working_.updateTimeMs = std::max(working_.updateTimeMs, timeMs);
+    published_ = std::make_shared<const AccountSnapshot>(working_);
+    changed_.notify_all();
+}
+
+PositionState& AccountState::positionLocked(const std::string& symbol, const std::string& positionSide) {
+    const std::string side = positionSide.empty() ? std::string("BOTH") : positionSide;
+    for (auto& p : working_.positions) {
+        if (p.symbol == symbol && p.positionSide == side) return p;
+    }
+    PositionState p;
+    p.symbol = symbol;
+    p.positionSide = side;
+    for (const auto& other : working_.positions) {
+        if (other.symbol == symbol && other.leverage > 0) { p.leverage = other.leverage; break; }
+    }
+    working_.positions.push_back(std::move(p));
+    return working_.positions.back();
+}
+
+bool AccountState::addFillLocked(const FillState& fill) {
+    if (!fillKeys_.insert(FillKey{fill.symbol, fill.tradeId}).second) return false;
+    auto& fills = working_.fills;
+    if (fills.empty() || fills.back().timeMs <= fill.timeMs) {
+        fills.append(fill);  // the usual case: stream fills arrive in time order
+    } else {
+        std::vector<FillState> all = fills.flatten();
+        all.insert(std::upper_bound(all.begin(), all.end(), fill, fillBefore), fill);
+        fills.assign(all);
+    }
+    trimFillsLocked();
+    return true;
+}
+
+void AccountState::trimFillsLocked() {
+    std::vector<FillState> dropped;
+    working_.fills.trimTo(AccountSnapshot::kMaxFills, dropped);
+    for (const auto& f : dropped) fillKeys_.erase(FillKey{f.symbol, f.tradeId});
+}
+
+void AccountState::applyOrderUpdate(const OrderState& order, const FillState* fill) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fill) addFillLocked(*fill);
+
+    auto& open = working_.openOrders;
+    auto it = std::find_if(open.begin(), open.end(), [&order](const OrderState& o) { return o.orderId == order.orderId; });
+    const bool stale = it != open.end() && it->updateTimeMs > order.updateTimeMs;
+    if (!stale) {
+        if (order.isOpen()) {
+            // A NEW that arrives after the order was already seen closed is late, not a reopen.
+            auto closed = closedAt_.find(order.orderId);
+            if (closed == closedAt_.end() || closed->second < order.updateTimeMs) {
+                if (it != open.end()) *it = order;
+                else open.push_back(order);
+            }
+        } else {
+            if (it != open.end()) open.erase(it);
+            closedAt_[order.orderId] = order.updateTimeMs;
+            if (closedAt_.size() > kMaxClosedIds) {
+                const long long cutoff = order.updateTimeMs - kClosedRetentionMs;
+                for (auto c = closedAt_.begin(); c != closedAt_.end();) {
+                    if (c->second < cutoff) c = closedAt_.erase(c);
+                    else ++c;
+                }
+            }
+        }
+    }
+    publishLocked(order.updateTimeMs);
+}
+
+void AccountState::applyAccountUpdate(const std::vector<BalanceState>& balances, const std::vector<PositionState>& positions, long long eventTimeMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& b : balances) {
+        auto it = std::find_if(working_.balances.begin(), working_.balances.end(), [&b](const BalanceState& x) { return x.asset == b.asset; });
+        if (it == working_.balances.end()) {
+            BalanceState fresh = b;
+            fresh.availableBalance = b.crossWalletBalance;
+            fresh.marginBalance = b.walletBalance;
+            fresh.updateTimeMs = eventTimeMs;
+            working_.balances.push_back(std::move(fresh));
+            continue;
+        }
+        const double delta = b.walletBalance - it->walletBalance;
+        it->availableBalance += delta;
+        it->marginBalance += delta;
+        it->walletBalance = b.walletBalance;
+        it->crossWalletBalance = b.crossWalletBalance;
+        it->updateTimeMs = eventTimeMs;
+    }
+    for (const auto& p : positions) {
+        PositionState& cur = positionLocked(p.symbol, p.positionSide);
+        cur.amount = p.amount;
+        cur.entryPrice = p.entryPrice;
+        cur.unrealizedPnl = p.unrealizedPnl;
+        cur.isolatedWallet = p.isolatedWallet;
+        if (!p.marginType.empty()) cur.marginType = p.marginType;
+        cur.updateTimeMs = eventTimeMs;
+    }
+    publishLocked(eventTimeMs);
+}
+
+void AccountState::applyLeverage(const std::string& symbol, int leverage, long long eventTimeMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool found = false;
+    for (auto& p : working_.positions) {
+        if (p.symbol != symbol) continue;
+        p.leverage = leverage;
+        p.updateTimeMs = eventTimeMs;
+        found = true;
+    }
+    if (!found) {
+        PositionState& p = positionLocked(symbol, "BOTH");
+        p.leverage = leverage;
+        p.updateTimeMs = eventTimeMs;
+    }
+    publishLocked(eventTimeMs);
+}
+
+void AccountState::applyMarginCall(const std::vector<PositionState>& positions, long long eventTimeMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& p : positions) {
+        PositionState& cur = positionLocked(p.symbol, p.positionSide);
+        cur.amount = p.amount;
+        cur.markPrice = p.markPrice;
+        cur.unrealizedPnl = p.unrealizedPnl;
+        if (!p.marginType.empty()) cur.marginType = p.marginType;
+        cur.updateTimeMs = eventTimeMs;
+    }
+    working_.marginCall = true;
+    publishLocked(eventTimeMs);
+}
+
+std::size_t AccountState::reconcileAccount(const std::vector<BalanceState>& balances, const std::vector<PositionState>& positions, double takerRate, double makerRate, long long fetchStartMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t corrected = 0;
+
+    std::vector<BalanceState> nextBalances;
+    nextBalances.reserve(balances.size());
+    for (const auto& b : balances) {
+        auto it = std::find_if(working_.balances.begin(), working_.balances.end(), [&b](const BalanceState& x) { return x.asset == b.asset; });
+        if (it != working_.balances.end() && it->updateTimeMs >= fetchStartMs) {
+            nextBalances.push_back(*it);
+            continue;
+        }
+        if (it == working_.balances.end() || differs(it->walletBalance, b.walletBalance)) ++corrected;
+        nextBalances.push_back(b);
+    }
+    for (const auto& b : working_.balances) {
+        const bool inRest = std::any_of(balances.begin(), balances.end(), [&b](const BalanceState& x) { return x.asset == b.asset; });
+        if (!inRest && b.updateTimeMs >= fetchStartMs) nextBalances.push_back(b);
+    }
+
+    std::vector<PositionState> nextPositions;
+    nextPositions.reserve(positions.size());
+    for (const auto& p : positions) {
+        auto it = std::find_if(working_.positions.begin(), working_.positions.end(),
+            [&p](const PositionState& x) { return x.symbol == p.symbol && x.positionSide == p.positionSide; });
+        if (it != working_.positions.end() && it->updateTimeMs >= fetchStartMs) {
+            nextPositions.push_back(*it);
+            continue;
+        }
+        const double localAmount = it != working_.positions.end() ? it->amount : 0.0;
+        if (differs(localAmount, p.amount) || (it != working_.positions.end() && p.amount != 0.0 && differs(it->entryPrice, p.entryPrice))) ++corrected;
+        nextPositions.push_back(p);
+    }
+    for (const auto& p : working_.positions) {
+        const bool inRest = std::any_of(positions.begin(), positions.end(),
+            [&p](const PositionState& x) { return x.symbol == p.symbol && x.positionSide == p.positionSide; });
+        if (inRest) continue;
+        if (p.updateTimeMs >= fetchStartMs) nextPositions.push_back(p);
+        else if (p.amount != 0.0) ++corrected;
+    }
+
+    working_.balances = std::move(nextBalances);
+    working_.positions = std::move(nextPositions);
+    working_.takerRate = takerRate;
+    working_.makerRate = makerRate;
+    working_.marginCall = false;
+    publishLocked(fetchStartMs);
+    return corrected;
+}
+
+std::size_t AccountState::reconcileOpenOrders(const std::vector<OrderState>& orders, long long fetchStartMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t corrected = 0;
+    std::vector<OrderState> next;
+    next.reserve(orders.size());
+
+    for (const auto& local : working_.openOrders) {
+        auto rest = std::find_if(orders.begin(), orders.end(), [&local](const OrderState& o) { return o.orderId == local.orderId; });
+        if (local.updateTimeMs >= fetchStartMs) {
+            next.push_back(local);  // changed while the request was out
+        } else if (rest != orders.end()) {
+            if (rest->status != local.status || differs(rest->executedQty, local.executedQty) || differs(rest->price, local.price) || differs(rest->origQty, local.origQty)) ++corrected;
+            next.push_back(*rest);
+        } else {
+            ++corrected;  // closed without an event reaching us
+            closedAt_[local.orderId] = fetchStartMs;
+        }
+    }
+    for (const auto& o : orders) {
+        const bool known = std::any_of(working_.openOrders.begin(), working_.openOrders.end(), [&o](const OrderState& x) { return x.orderId == o.orderId; });
+        if (known) continue;
+        auto closed = closedAt_.find(o.orderId);
+        if (closed != closedAt_.end() && closed->second >= o.updateTimeMs) continue;  // we saw it close after that
+        ++corrected;
+        next.push_back(o);
+    }
+
+    working_.openOrders = std::move(next);
+    publishLocked(fetchStartMs);
+    return corrected;
+}
+
+std::size_t AccountState::mergeFills(const std::vector<FillState>& fills) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<FillState> fresh;
+    long long newest = 0;
+    for (const auto& f : fills) {
+        if (!fillKeys_.insert(FillKey{f.symbol, f.tradeId}).second) continue;
+        fresh.push_back(f);
+        newest = std::max(newest, f.timeMs);
+    }
+    if (fresh.empty()) return 0;
+    // A backfill is mostly older than what the stream delivered: merge it in one rebuild.
+    std::stable_sort(fresh.begin(), fresh.end(), fillBefore);
+    std::vector<FillState> all = working_.fills.flatten();
+    const auto mid = static_cast<std::ptrdiff_t>(all.size());
+    all.insert(all.end(), fresh.begin(), fresh.end());
+    std::inplace_merge(all.begin(), all.begin() + mid, all.end(), fillBefore);
+    working_.fills.assign(all);
+    trimFillsLocked();
+    publishLocked(newest);
+    return fresh.size();
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,101 @@
+#include "binancerj/core/BackfillPlanner.hpp"
+#include "binancerj/core/KlineCache.hpp"
+
+#include <algorithm>
+
+namespace binancerj::core {
+
+BackfillPlanner::BackfillPlanner(long long intervalMs, std::size_t maxPerRequest)
+    : intervalMs_(intervalMs > 0 ? intervalMs : 60000),
+      maxPerRequest_(maxPerRequest ? maxPerRequest : 1) {
+}
+
+long long BackfillPlanner::alignDown(long long t) const {
+    long long q = t / intervalMs_;
+    if (t < 0 && t % intervalMs_ != 0) {
+        --q;
+    }
+    return q * intervalMs_;
+}
+
+void BackfillPlanner::addRun(long long from, long long to) {
+    // Insert, then coalesce with neighbours that overlap or touch (gap of exactly one interval).
+    auto pos = std::lower_bound(runs_.begin(), runs_.end(), from,
+                                [](const TimeRange& r, long long t) { return r.from < t; });
+    pos = runs_.insert(pos, TimeRange{from, to});
+    if (pos != runs_.begin() && std::prev(pos)->to + intervalMs_ >= pos->from) {
+        --pos;
+        pos->to = std::max(pos->to, std::next(pos)->to);
+        runs_.erase(std::next(pos));
+    }
+    while (std::next(pos) != runs_.end() && pos->to + intervalMs_ >= std::next(pos)->from) {
+        pos->to = std::max(pos->to, std::next(pos)->to);
+        runs_.erase(std::next(pos));
+    }
+}
+
+void BackfillPlanner::addCoverage(const std::vector<Candle>& sorted) {
+    if (sorted.empty()) {
+        return;
+    }
+    long long runFrom = sorted.front().t0;
+    long long runTo = runFrom;
+    for (std::size_t i = 1; i < sorted.size(); ++i) {
+        const long long t = sorted[i].t0;
+        if (t <= runTo + intervalMs_) {
+            runTo = std::max(runTo, t);
+            continue;
+        }
+        addRun(runFrom, runTo);
+        runFrom = runTo = t;
+    }
+    addRun(runFrom, runTo);
+}
+
+void BackfillPlanner::addCoverage(const KlineCache& cache, long long from, long long to) {
+    std::vector<Candle> rows;
+    cache.read(from, to, rows);
+    addCoverage(rows);
+}
+
+std::vector<TimeRange> BackfillPlanner::missing(long long from, long long to) const {
+    std::vector<TimeRange> out;
+    long long cursor = alignDown(from);
+    const long long last = alignDown(to);
+    for (const auto& run : runs_) {
+        if (run.to < cursor) {
+            continue;
+        }
+        if (run.from > last) {
+            break;
+        }
+        if (run.from > cursor) {
+            out.push_back(TimeRange{cursor, run.from - intervalMs_});
+        }
+        cursor = run.to + intervalMs_;
+        if (cursor > last) {
+            return out;
+        }
+    }
+    if (cursor <= last) {
+        out.push_back(TimeRange{cursor, last});
+    }
+    return out;
+}
+
+std::vector<TimeRange> BackfillPlanner::plan(long long from, long long to) const {
+    std::vector<TimeRange> segments;
+    const long long span = static_cast<long long>(maxPerRequest_) * intervalMs_;
+    auto gaps = missing(from, to);
+    for (auto it = gaps.rbegin(); it != gaps.rend(); ++it) {
+        long long segTo = it->to;
+        while (segTo >= it->from) {
+            const long long segFrom = std::max(it->from, segTo - span + intervalMs_);
+            segments.push_back(TimeRange{segFrom, segTo});
+            segTo = segFrom - intervalMs_;
+        }
+    }
+    return segments;
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,124 @@
+#include "binancerj/core/CandleLod.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace binancerj::core {
+
+namespace {
+
+// Identity element: an empty slot that combine() skips.
+const Candle kEmpty{std::numeric_limits<long long>::max(), std::numeric_limits<long long>::min(), 0.0, 0.0, 0.0, 0.0, 0.0};
+
+bool isEmpty(const Candle& c) {
+    return c.t0 == std::numeric_limits<long long>::max();
+}
+
+} // namespace
+
+Candle CandleLod::combine(const Candle& a, const Candle& b) {
+    if (isEmpty(a)) return b;
+    if (isEmpty(b)) return a;
+    return Candle{a.t0, b.t1, a.o, std::max(a.h, b.h), std::min(a.l, b.l), b.c, a.v + b.v};
+}
+
+void CandleLod::build(const std::vector<Candle>& series) {
+    size_ = series.size();
+    capacity_ = 1;
+    while (capacity_ < size_) {
+        capacity_ <<= 1;
+    }
+    // Leave headroom for live appends so sync() rarely has to rebuild.
+    if (capacity_ < size_ + size_ / 8 + 1) {
+        capacity_ <<= 1;
+    }
+    tree_.assign(2 * capacity_, kEmpty);
+    std::copy(series.begin(), series.end(), tree_.begin() + static_cast<std::ptrdiff_t>(capacity_));
+    for (std::size_t i = capacity_ - 1; i >= 1; --i) {
+        tree_[i] = combine(tree_[2 * i], tree_[2 * i + 1]);
+    }
+}
+
+void CandleLod::set(std::size_t index, const Candle& bar) {
+    std::size_t i = capacity_ + index;
+    tree_[i] = bar;
+    for (i >>= 1; i >= 1; i >>= 1) {
+        tree_[i] = combine(tree_[2 * i], tree_[2 * i + 1]);
+    }
+}
+
+void CandleLod::sync(const std::vector<Candle>& series) {
+    const bool sameHistory = size_ > 0 && series.size() >= size_ && series.size() <= capacity_
+        && series.front().t0 == leaf(0).t0 && series[size_ - 1].t0 == leaf(size_ - 1).t0;
+    if (!sameHistory) {
+        build(series);
+        return;
+    }
+    // The previous last bar may still have been live: refresh it along with any new bars.
+    for (std::size_t i = size_ - 1; i < series.size(); ++i) {
+        set(i, series[i]);
+    }
+    size_ = series.size();
+}
+
+std::pair<std::size_t, std::size_t> CandleLod::indexRange(long long t0, long long t1) const {
+    if (size_ == 0 || t1 < t0) {
+        return {0, 0};
+    }
+    const Candle* begin = tree_.data() + capacity_;
+    const Candle* end = begin + size_;
+    const Candle* first = std::partition_point(begin, end, [t0](const Candle& c) { return c.t1 < t0; });
+    const Candle* last = std::partition_point(first, end, [t1](const Candle& c) { return c.t0 <= t1; });
+    return {static_cast<std::size_t>(first - begin), static_cast<std::size_t>(last - begin)};
+}
+
+bool CandleLod::aggregate(std::size_t first, std::size_t last, Candle& out) const {
+    last = std::min(last, size_);
+    if (first >= last) {
+        return false;
+    }
+    Candle left = kEmpty;
+    Candle right = kEmpty;
+    for (std::size_t l = first + capacity_, r = last + capacity_; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) left = combine(left, tree_[l++]);
+        if (r & 1) right = combine(tree_[--r], right);
+    }
+    out = combine(left, right);
+    return true;
+}
+
+bool CandleLod::priceRange(long long t0, long long t1, double& low, double& high) const {
+    const auto range = indexRange(t0, t1);
+    Candle agg{};
+    if (!aggregate(range.first, range.second, agg)) {
+        return false;
+    }
+    low = agg.l;
+    high = agg.h;
+    return true;
+}
+
+void CandleLod::decimate(long long t0, long long t1, std::size_t columns, std::vector<Candle>& out) const {
+    out.clear();
+    const auto range = indexRange(t0, t1);
+    const std::size_t count = range.second - range.first;
+    if (count == 0) {
+        return;
+    }
+    columns = std::max<std::size_t>(1, columns);
+    if (count <= columns) {
+        out.assign(tree_.begin() + static_cast<std::ptrdiff_t>(capacity_ + range.first),
+                   tree_.begin() + static_cast<std::ptrdiff_t>(capacity_ + range.second));
+        return;
+    }
+    const std::size_t group = (count + columns - 1) / columns;
+    out.reserve(columns + 1);
+    for (std::size_t i = range.first / group * group; i < range.second; i += group) {
+        Candle agg{};
+        if (aggregate(i, i + group, agg)) {
+            out.push_back(agg);
+        }
+    }
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,125 @@
+#include "binancerj/core/CandleMerge.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace binancerj::core {
+
+namespace {
+
+struct Cursor {
+    const Candle* it;
+    const Candle* end;
+    std::size_t run;
+};
+
+// Min-heap on t0; on ties the later run surfaces first so it wins the dedupe.
+bool heapAfter(const Cursor& a, const Cursor& b) {
+    if (a.it->t0 != b.it->t0) {
+        return a.it->t0 > b.it->t0;
+    }
+    return a.run < b.run;
+}
+
+bool byOpenTime(const Candle& a, const Candle& b) {
+    return a.t0 < b.t0;
+}
+
+} // namespace
+
+void mergeSortedRuns(const std::vector<const std::vector<Candle>*>& runs, std::vector<Candle>& dest) {
+    dest.clear();
+    std::size_t total = 0;
+    std::vector<Cursor> heap;
+    heap.reserve(runs.size());
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        if (!runs[i] || runs[i]->empty()) {
+            continue;
+        }
+        total += runs[i]->size();
+        heap.push_back(Cursor{runs[i]->data(), runs[i]->data() + runs[i]->size(), i});
+    }
+    dest.reserve(total);
+    if (heap.size() == 1) {
+        dest.assign(heap.front().it, heap.front().end);
+        dest.erase(std::unique(dest.begin(), dest.end(),
+                               [](const Candle& a, const Candle& b) { return a.t0 == b.t0; }),
+                   dest.end());
+        return;
+    }
+    std::make_heap(heap.begin(), heap.end(), heapAfter);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), heapAfter);
+        Cursor& top = heap.back();
+        if (dest.empty() || dest.back().t0 != top.it->t0) {
+            dest.push_back(*top.it);
+        }
+        if (++top.it == top.end) {
+            heap.pop_back();
+        } else {
+            std::push_heap(heap.begin(), heap.end(), heapAfter);
+        }
+    }
+}
+
+void mergeCandlesInto(std::vector<Candle>& base, std::vector<std::vector<Candle>>& parts) {
+    std::vector<const std::vector<Candle>*> runs;
+    runs.reserve(parts.size() + 1);
+    runs.push_back(&base);
+    bool anyPart = false;
+    for (auto& part : parts) {
+        if (part.empty()) {
+            continue;
+        }
+        if (!std::is_sorted(part.begin(), part.end(), byOpenTime)) {
+            std::sort(part.begin(), part.end(), byOpenTime);
+        }
+        runs.push_back(&part);
+        anyPart = true;
+    }
+    if (!anyPart) {
+        return;
+    }
+    // Fast path: a single part strictly after the base is a plain append.
+    if (runs.size() == 2 && (base.empty() || base.back().t0 < runs[1]->front().t0)) {
+        const auto& part = *runs[1];
+        base.reserve(base.size() + part.size());
+        for (const auto& c : part) {
+            if (base.empty() || base.back().t0 != c.t0) {
+                base.push_back(c);
+            } else {
+                base.back() = c;
+            }
+        }
+        return;
+    }
+    std::vector<Candle> merged;
+    mergeSortedRuns(runs, merged);
+    base.swap(merged);
+}
+
+void mergeCandlesInto(std::vector<Candle>& base, std::vector<Candle>& part) {
+    std::vector<std::vector<Candle>> parts(1);
+    parts[0].swap(part);
+    mergeCandlesInto(base, parts);
+    part.swap(parts[0]);
+}
+
+bool upsertCandle(std::vector<Candle>& series, const Candle& candle) {
+    if (series.empty() || series.back().t0 < candle.t0) {
+        series.push_back(candle);
+        return true;
+    }
+    if (series.back().t0 == candle.t0) {
+        series.back() = candle;
+        return true;
+    }
+    auto it = std::lower_bound(series.begin(), series.end(), candle, byOpenTime);
+    if (it != series.end() && it->t0 == candle.t0) {
+        *it = candle;
+        return true;
+    }
+    return false;
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,237 @@
+#include "binancerj/core/CandlePyramid.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <algorithm>
+#include <future>
+
+namespace binancerj::core {
+
+namespace {
+
+long long bucketStart(long long t, long long ms) {
+    long long q = t / ms;
+    if (t < 0 && t % ms != 0) {
+        --q;
+    }
+    return q * ms;
+}
+
+bool byOpenTime(const Candle& a, const Candle& b) {
+    return a.t0 < b.t0;
+}
+
+} // namespace
+
+CandlePyramid::CandlePyramid(long long baseIntervalMs, std::vector<long long> levelIntervalsMs)
+    : baseMs_(baseIntervalMs > 0 ? baseIntervalMs : 60000) {
+    std::sort(levelIntervalsMs.begin(), levelIntervalsMs.end());
+    for (long long ms : levelIntervalsMs) {
+        // Only exact multiples of the base can be derived.
+        if (ms > baseMs_ && ms % baseMs_ == 0) {
+            levels_.push_back(Level{ms, {}});
+        }
+    }
+}
+
+std::vector<long long> CandlePyramid::defaultLevels() {
+    const long long m = 60LL * 1000;
+    const long long h = 60 * m;
+    return {3 * m, 5 * m, 15 * m, 30 * m, h, 2 * h, 4 * h, 6 * h, 12 * h, 24 * h};
+}
+
+void CandlePyramid::reduce(const std::vector<Candle>& base, long long baseMs, Level& level) {
+    level.bars.clear();
+    const long long ms = level.intervalMs;
+    level.bars.reserve(base.size() / static_cast<std::size_t>(ms / baseMs) + 1);
+    std::size_t i = 0;
+    // A leading bucket that starts before the loaded base would be incomplete: skip it.
+    if (!base.empty() && bucketStart(base.front().t0, ms) != base.front().t0) {
+        const long long firstFull = bucketStart(base.front().t0, ms) + ms;
+        while (i < base.size() && base[i].t0 < firstFull) {
+            ++i;
+        }
+    }
+    for (; i < base.size(); ++i) {
+        const Candle& b = base[i];
+        const long long t0 = bucketStart(b.t0, ms);
+        if (level.bars.empty() || level.bars.back().t0 != t0) {
+            level.bars.push_back(Candle{t0, t0 + ms - 1, b.o, b.h, b.l, b.c, b.v});
+            continue;
+        }
+        Candle& agg = level.bars.back();
+        agg.h = std::max(agg.h, b.h);
+        agg.l = std::min(agg.l, b.l);
+        agg.c = b.c;
+        agg.v += b.v;
+    }
+}
+
+void CandlePyramid::reset(const std::string& symbol, std::vector<Candle> base) {
+    telemetry::ScopedTimer timer("candle_pyramid", "reset");
+    if (!std::is_sorted(base.begin(), base.end(), byOpenTime)) {
+        std::sort(base.begin(), base.end(), byOpenTime);
+    }
+    std::vector<Level> levels;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        levels.reserve(levels_.size());
+        for (const auto& lv : levels_) {
+            levels.push_back(Level{lv.intervalMs, {}});
+        }
+    }
+    // Levels are independent reductions of the same base: build them concurrently.
+    std::vector<std::future<void>> jobs;
+    jobs.reserve(levels.size());
+    for (auto& lv : levels) {
+        jobs.push_back(std::async(std::launch::async, [&base, &lv, this]() { reduce(base, baseMs_, lv); }));
+    }
+    for (auto& job : jobs) {
+        job.get();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    symbol_ = symbol;
+    base_.swap(base);
+    levels_.swap(levels);
+    if (symbol == expected_) {
+        for (const Candle& bar : buffered_) {
+            updateLocked(bar);
+        }
+        expected_.clear();
+        buffered_.clear();
+    }
+    telemetry::logGauge("candle_pyramid", "base_bars", static_cast<double>(base_.size()));
+}
+
+void CandlePyramid::expect(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (expected_ != symbol) {
+        buffered_.clear();
+    }
+    expected_ = symbol;
+}
+
+void CandlePyramid::rebuildBucket(Level& level, long long bucketT0) {
+    auto first = std::lower_bound(base_.begin(), base_.end(), Candle{bucketT0, 0, 0, 0, 0, 0, 0}, byOpenTime);
+    auto bar = std::lower_bound(level.bars.begin(), level.bars.end(), Candle{bucketT0, 0, 0, 0, 0, 0, 0}, byOpenTime);
+    if (bar == level.bars.end() || bar->t0 != bucketT0 || first == base_.end()) {
+        return;
+    }
+    Candle agg{bucketT0, bucketT0 + level.intervalMs - 1, first->o, first->h, first->l, first->c, 0.0};
+    for (auto it = first; it != base_.end() && it->t0 < bucketT0 + level.intervalMs; ++it) {
+        agg.h = std::max(agg.h, it->h);
+        agg.l = std::min(agg.l, it->l);
+        agg.c = it->c;
+        agg.v += it->v;
+    }
+    *bar = agg;
+}
+
+bool CandlePyramid::update(const std::string& symbol, const Candle& baseBar) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (symbol == expected_) {
+        // Live bars arrive in order: only the newest one is ever updated in place.
+        if (!buffered_.empty() && buffered_.back().t0 == baseBar.t0) {
+            buffered_.back() = baseBar;
+        } else if (buffered_.empty() || buffered_.back().t0 < baseBar.t0) {
+            buffered_.push_back(baseBar);
+        }
+    }
+    if (symbol != symbol_) {
+        return symbol == expected_;
+    }
+    updateLocked(baseBar);
+    return true;
+}
+
+void CandlePyramid::updateLocked(const Candle& baseBar) {
+    // Upsert into the base, remembering the previous state of the bar.
+    bool hadPrev = false;
+    Candle prev{};
+    bool appended = false;
+    if (base_.empty() || base_.back().t0 < baseBar.t0) {
+        base_.push_back(baseBar);
+        appended = true;
+    } else {
+        auto it = std::lower_bound(base_.begin(), base_.end(), baseBar, byOpenTime);
+        if (it != base_.end() && it->t0 == baseBar.t0) {
+            prev = *it;
+            hadPrev = true;
+            *it = baseBar;
+        } else {
+            base_.insert(it, baseBar);
+        }
+    }
+    const bool isNewest = base_.back().t0 == baseBar.t0;
+
+    for (auto& lv : levels_) {
+        const long long t0 = bucketStart(baseBar.t0, lv.intervalMs);
+        if (lv.bars.empty() || lv.bars.back().t0 < t0) {
+            // First base bar of a new bucket (mid-bucket starts stay partial until reload).
+            lv.bars.push_back(Candle{t0, t0 + lv.intervalMs - 1, baseBar.o, baseBar.h, baseBar.l, baseBar.c, baseBar.v});
+            continue;
+        }
+        Candle& agg = lv.bars.back();
+        const bool monotonic = !hadPrev || (baseBar.h >= prev.h && baseBar.l <= prev.l);
+        if (agg.t0 == t0 && isNewest && monotonic) {
+            // Live bar: highs only rise, lows only fall, volume only grows.
+            agg.h = std::max(agg.h, baseBar.h);
+            agg.l = std::min(agg.l, baseBar.l);
+            agg.c = baseBar.c;
+            agg.v += baseBar.v - (hadPrev ? prev.v : 0.0);
+            if (appended && agg.t0 == baseBar.t0) {
+                agg.o = baseBar.o;
+            }
+            continue;
+        }
+        rebuildBucket(lv, t0);
+    }
+}
+
+const std::vector<Candle>* CandlePyramid::seriesLocked(long long intervalMs) const {
+    if (intervalMs == baseMs_) {
+        return &base_;
+    }
+    for (const auto& lv : levels_) {
+        if (lv.intervalMs == intervalMs) {
+            return &lv.bars;
+        }
+    }
+    return nullptr;
+}
+
+bool CandlePyramid::supports(long long intervalMs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return seriesLocked(intervalMs) != nullptr;
+}
+
+bool CandlePyramid::copyLevel(const std::string& symbol, long long intervalMs, std::vector<Candle>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto* series = symbol == symbol_ ? seriesLocked(intervalMs) : nullptr;
+    if (!series || series->empty()) {
+        return false;
+    }
+    out.assign(series->begin(), series->end());
+    return true;
+}
+
+bool CandlePyramid::latest(const std::string& symbol, long long intervalMs, Candle& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto* series = symbol == symbol_ ? seriesLocked(intervalMs) : nullptr;
+    if (!series || series->empty()) {
+        return false;
+    }
+    out = series->back();
+    return true;
+}
+
+std::string CandlePyramid::symbol() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return symbol_;
+}
+
+std::size_t CandlePyramid::baseSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return base_.size();
+}
+
+} // namespace binancerj::core
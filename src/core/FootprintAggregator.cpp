@@ -0,0 +1,265 @@
+#include "binancerj/core/FootprintAggregator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace binancerj::core {
+
+namespace {
+
+long long floorDiv(long long value, long long step) {
+    long long q = value / step;
+    if ((value % step) != 0 && ((value < 0) != (step < 0))) {
+        --q;
+    }
+    return q;
+}
+
+// Bucket of a price. A price on a bucket edge (0.3 / 0.1) must not land one bucket low from
+// rounding error, so the quotient gets a small relative nudge before flooring.
+long long bucketOf(double price, double bucketSize) {
+    const double q = price / bucketSize;
+    return static_cast<long long>(std::floor(q + 1e-9 * std::max(1.0, std::abs(q))));
+}
+
+long long currentUtcDayStart() {
+    const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return floorDiv(now, FootprintAggregator::kSessionMs) * FootprintAggregator::kSessionMs;
+}
+
+} // namespace
+
+FootprintAggregator::FootprintAggregator(double bucketSize, long long intervalMs, std::size_t maxCandles)
+    : bucketSize_(bucketSize > 0.0 ? bucketSize : 1.0),
+      intervalMs_(intervalMs > 0 ? intervalMs : 60000),
+      maxCandles_(maxCandles ? maxCandles : 1) {
+    session_.sessionStartMs = currentUtcDayStart();
+}
+
+void FootprintAggregator::reset(double bucketSize, long long intervalMs, long long sessionStartMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bucketSize_ = bucketSize > 0.0 ? bucketSize : 1.0;
+    intervalMs_ = intervalMs > 0 ? intervalMs : 60000;
+    while (!candles_.empty()) {
+        spare_.push_back(std::move(candles_.front()));
+        candles_.pop_front();
+    }
+    startSessionLocked(sessionStartMs > 0 ? sessionStartMs : currentUtcDayStart());
+    ++version_;
+}
+
+void FootprintAggregator::startSessionLocked(long long sessionStartMs) {
+    session_.buy.clear();
+    session_.sell.clear();
+    session_.firstBucket = 0;
+    session_.totalVolume = 0.0;
+    session_.pocBucket = 0;
+    session_.pocVolume = 0.0;
+    session_.valueAreaLow = 0;
+    session_.valueAreaHigh = 0;
+    session_.sessionStartMs = sessionStartMs;
+    valueAreaDirty_ = false;
+}
+
+void FootprintAggregator::addToBuckets(long long bucket, double qty, bool isBuy,
+                                       long long& firstBucket, std::vector<double>& buy, std::vector<double>& sell) {
+    if (buy.empty()) {
+        firstBucket = bucket;
+    }
+    if (bucket < firstBucket) {
+        const auto grow = static_cast<std::size_t>(firstBucket - bucket);
+        buy.insert(buy.begin(), grow, 0.0);
+        sell.insert(sell.begin(), grow, 0.0);
+        firstBucket = bucket;
+    }
+    const auto idx = static_cast<std::size_t>(bucket - firstBucket);
+    if (idx >= buy.size()) {
+        buy.resize(idx + 1, 0.0);
+        sell.resize(idx + 1, 0.0);
+    }
+    (isBuy ? buy : sell)[idx] += qty;
+}
+
+FootprintAggregator::CandleFootprint& FootprintAggregator::candleFor(long long candleT0) {
+    // Trades arrive almost in order, so the newest candle is the common hit.
+    for (auto it = candles_.rbegin(); it != candles_.rend(); ++it) {
+        if (it->t0 == candleT0) {
+            return *it;
+        }
+        if (it->t0 < candleT0) {
+            break;
+        }
+    }
+
+    CandleFootprint fresh;
+    if (!spare_.empty()) {
+        fresh = std::move(spare_.back());
+        spare_.pop_back();
+    }
+    fresh.t0 = candleT0;
+    fresh.firstBucket = 0;
+    fresh.buy.clear();
+    fresh.sell.clear();
+    fresh.buyTotal = 0.0;
+    fresh.sellTotal = 0.0;
+    fresh.maxBucketVolume = 0.0;
+    fresh.version = 0;
+
+    auto pos = std::upper_bound(candles_.begin(), candles_.end(), candleT0,
+                                [](long long t, const CandleFootprint& c) { return t < c.t0; });
+    auto& candle = *candles_.insert(pos, std::move(fresh));
+    // addTrade never inserts in front of a full window, so the front is never the new candle
+    // (pop_front keeps references to the remaining elements valid).
+    if (candles_.size() > maxCandles_) {
+        spare_.push_back(std::move(candles_.front()));
+        candles_.pop_front();
+    }
+    return candle;
+}
+
+void FootprintAggregator::addTrade(long long ts, double price, double qty, bool isBuy) {
+    if (!(price > 0.0) || !(qty > 0.0)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const long long bucket = bucketOf(price, bucketSize_);
+    const long long candleT0 = floorDiv(ts, intervalMs_) * intervalMs_;
+
+    if (!candles_.empty() && candles_.size() >= maxCandles_ && candleT0 < candles_.front().t0) {
+        // Too old for the retained window; still counts toward the session below.
+    } else {
+        auto& candle = candleFor(candleT0);
+        addToBuckets(bucket, qty, isBuy, candle.firstBucket, candle.buy, candle.sell);
+        (isBuy ? candle.buyTotal : candle.sellTotal) += qty;
+        const auto idx = static_cast<std::size_t>(bucket - candle.firstBucket);
+        candle.maxBucketVolume = std::max(candle.maxBucketVolume, candle.buy[idx] + candle.sell[idx]);
+        candle.version = version_ + 1;
+    }
+
+    if (ts >= session_.sessionStartMs + kSessionMs) {
+        // Sessions are one day long: the first trade past the boundary starts the next one.
+        startSessionLocked(session_.sessionStartMs + floorDiv(ts - session_.sessionStartMs, kSessionMs) * kSessionMs);
+    }
+    if (ts >= session_.sessionStartMs) {
+        addToBuckets(bucket, qty, isBuy, session_.firstBucket, session_.buy, session_.sell);
+        session_.totalVolume += qty;
+        const auto idx = static_cast<std::size_t>(bucket - session_.firstBucket);
+        const double bucketVolume = session_.buy[idx] + session_.sell[idx];
+        if (bucketVolume > session_.pocVolume) {
+            session_.pocVolume = bucketVolume;
+            session_.pocBucket = bucket;
+        }
+        valueAreaDirty_ = true;
+    }
+    ++version_;
+}
+
+void FootprintAggregator::prepareValueArea() const {
+    if (!valueAreaDirty_) {
+        return;
+    }
+    valueAreaDirty_ = false;
+    if (session_.buy.empty()) {
+        session_.valueAreaLow = session_.valueAreaHigh = 0;
+        return;
+    }
+    const auto volumeAt = [this](long long i) {
+        const auto idx = static_cast<std::size_t>(i);
+        return session_.buy[idx] + session_.sell[idx];
+    };
+    const long long last = static_cast<long long>(session_.buy.size()) - 1;
+    long long lo = session_.pocBucket - session_.firstBucket;
+    long long hi = lo;
+    double acc = volumeAt(lo);
+    const double target = session_.totalVolume * kValueAreaShare;
+    while (acc < target && (lo > 0 || hi < last)) {
+        const double below = lo > 0 ? volumeAt(lo - 1) : -1.0;
+        const double above = hi < last ? volumeAt(hi + 1) : -1.0;
+        if (above >= below) {
+            acc += volumeAt(++hi);
+        } else {
+            acc += volumeAt(--lo);
+        }
+    }
+    session_.valueAreaLow = session_.firstBucket + lo;
+    session_.valueAreaHigh = session_.firstBucket + hi;
+}
+
+std::uint64_t FootprintAggregator::copyCandles(long long t0, long long t1, std::vector<CandleFootprint>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto first = std::lower_bound(candles_.begin(), candles_.end(), t0 - intervalMs_ + 1,
+                                  [](const CandleFootprint& c, long long t) { return c.t0 < t; });
+    std::size_t n = 0;
+    for (auto it = first; it != candles_.end() && it->t0 <= t1; ++it, ++n) {
+        if (n < out.size()) {
+            auto& dst = out[n];
+            // Only the candles that traded since the last copy move (usually just the newest).
+            if (dst.t0 == it->t0 && dst.version == it->version) {
+                continue;
+            }
+            dst.t0 = it->t0;
+            dst.firstBucket = it->firstBucket;
+            dst.buy.assign(it->buy.begin(), it->buy.end());
+            dst.sell.assign(it->sell.begin(), it->sell.end());
+            dst.buyTotal = it->buyTotal;
+            dst.sellTotal = it->sellTotal;
+            dst.maxBucketVolume = it->maxBucketVolume;
+            dst.version = it->version;
+        } else {
+            out.push_back(*it);
+        }
+    }
+    out.resize(n);
+    return version_;
+}
+
+std::uint64_t FootprintAggregator::copySession(SessionProfile& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    prepareValueArea();
+    out.sessionStartMs = session_.sessionStartMs;
+    out.firstBucket = session_.firstBucket;
+    out.buy.assign(session_.buy.begin(), session_.buy.end());
+    out.sell.assign(session_.sell.begin(), session_.sell.end());
+    out.totalVolume = session_.totalVolume;
+    out.pocBucket = session_.pocBucket;
+    out.pocVolume = session_.pocVolume;
+    out.valueAreaLow = session_.valueAreaLow;
+    out.valueAreaHigh = session_.valueAreaHigh;
+    return version_;
+}
+
+bool FootprintAggregator::candleTotals(long long candleT0, double& buy, double& sell) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::lower_bound(candles_.begin(), candles_.end(), candleT0,
+                               [](const CandleFootprint& c, long long t) { return c.t0 < t; });
+    if (it == candles_.end() || it->t0 != candleT0) {
+        return false;
+    }
+    buy = it->buyTotal;
+    sell = it->sellTotal;
+    return true;
+}
+
+std::uint64_t FootprintAggregator::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+double FootprintAggregator::bucketSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bucketSize_;
+}
+
+long long FootprintAggregator::intervalMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return intervalMs_;
+}
+
+double FootprintAggregator::bucketPrice(long long bucket) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<double>(bucket) * bucketSize_;
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,407 @@
+#include "binancerj/core/KlineCache.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace binancerj::core {
+
+namespace fs = std::filesystem;
+namespace bip = boost::interprocess;
+
+namespace {
+
+constexpr std::size_t kColumnCount = 7;
+constexpr std::array<const char*, kColumnCount> kColumnNames{{"t0", "t1", "o", "h", "l", "c", "v"}};
+constexpr std::size_t kWidth = 8; // every column is int64 or double
+// Appended candles are buffered and written (one remap) per batch; flush() or a rewrite drains them.
+constexpr std::size_t kAppendBatch = 32;
+constexpr const char* kManifestName = "manifest";
+
+void packRow(const Candle& c, std::array<char[kWidth], kColumnCount>& row) {
+    std::memcpy(row[0], &c.t0, kWidth);
+    std::memcpy(row[1], &c.t1, kWidth);
+    std::memcpy(row[2], &c.o, kWidth);
+    std::memcpy(row[3], &c.h, kWidth);
+    std::memcpy(row[4], &c.l, kWidth);
+    std::memcpy(row[5], &c.c, kWidth);
+    std::memcpy(row[6], &c.v, kWidth);
+}
+
+// Generation 0 keeps the original <name>.bin names, so caches written before the manifest still open.
+std::string columnPath(const std::string& dir, std::size_t column, std::uint64_t generation) {
+    std::string name = kColumnNames[column];
+    if (generation > 0) {
+        name += "." + std::to_string(generation);
+    }
+    return (fs::path(dir) / (name + ".bin")).string();
+}
+
+void unpackValue(const Candle& c, std::size_t column, char* out) {
+    const void* src = nullptr;
+    switch (column) {
+        case 0: src = &c.t0; break;
+        case 1: src = &c.t1; break;
+        case 2: src = &c.o; break;
+        case 3: src = &c.h; break;
+        case 4: src = &c.l; break;
+        case 5: src = &c.c; break;
+        default: src = &c.v; break;
+    }
+    std::memcpy(out, src, kWidth);
+}
+
+} // namespace
+
+struct KlineCache::Impl {
+    struct Column {
+        std::string path;
+        bip::file_mapping file;
+        bip::mapped_region region;
+        const char* data{nullptr};
+    };
+    std::array<Column, kColumnCount> columns;
+    std::uint64_t generation{0};   // column set named by the manifest
+    std::size_t mapped{0};         // rows in the mapped files
+    std::vector<Candle> pending;   // appended rows not yet written, after the mapped ones
+    std::size_t count{0};          // mapped + pending
+
+    void unmap() {
+        for (auto& col : columns) {
+            col.region = bip::mapped_region();
+            col.file = bip::file_mapping();
+            col.data = nullptr;
+        }
+        mapped = 0;
+        count = pending.size();
+    }
+
+    template <typename T>
+    T value(std::size_t column, std::size_t index) const {
+        T out;
+        if (index < mapped) {
+            std::memcpy(&out, columns[column].data + index * kWidth, kWidth);
+        } else {
+            char raw[kWidth];
+            unpackValue(pending[index - mapped], column, raw);
+            std::memcpy(&out, raw, kWidth);
+        }
+        return out;
+    }
+};
+
+KlineCache::KlineCache(std::string rootDir, std::string symbol, std::string interval)
+    : dir_((fs::path(rootDir) / (symbol + "_" + interval)).string()),
+      impl_(std::make_unique<Impl>()) {
+    setGenerationLocked(0);
+}
+
+KlineCache::~KlineCache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flushLocked();
+}
+
+void KlineCache::setGenerationLocked(std::uint64_t generation) {
+    impl_->generation = generation;
+    for (std::size_t i = 0; i < kColumnCount; ++i) {
+        impl_->columns[i].path = columnPath(dir_, i, generation);
+    }
+}
+
+std::uint64_t KlineCache::readManifestLocked() const {
+    std::ifstream in((fs::path(dir_) / kManifestName).string());
+    std::uint64_t generation = 0;
+    if (!(in >> generation)) {
+        return 0;
+    }
+    return generation;
+}
+
+bool KlineCache::writeManifestLocked(std::uint64_t generation) {
+    const std::string path = (fs::path(dir_) / kManifestName).string();
+    {
+        std::ofstream out(path + ".tmp", std::ios::binary | std::ios::trunc);
+        out << generation << "\n";
+        out.flush();
+        if (!out) {
+            return false;
+        }
+    }
+    // The rename is the commit point of a rewrite: readers see the old set or the new one.
+    std::error_code ec;
+    fs::rename(path + ".tmp", path, ec);
+    return !ec;
+}
+
+void KlineCache::removeStaleColumnsLocked() const {
+    // Columns of other generations are leftovers of an interrupted rewrite (or of the one it replaced).
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir_, ec)) {
+        const std::string ext = entry.path().extension().string();
+        if (ext != ".bin" && ext != ".tmp") {
+            continue;
+        }
+        bool current = false;
+        for (const auto& col : impl_->columns) {
+            current = current || entry.path() == fs::path(col.path);
+        }
+        if (!current) {
+            std::error_code rmEc;
+            fs::remove(entry.path(), rmEc);
+        }
+    }
+}
+
+bool KlineCache::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    fs::create_directories(dir_, ec);
+    if (ec) {
+        telemetry::logEvent("kline_cache", "open_failed " + dir_ + ": " + ec.message());
+        return false;
+    }
+    setGenerationLocked(readManifestLocked());
+    removeStaleColumnsLocked();
+    return remapLocked();
+}
+
+bool KlineCache::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return flushLocked();
+}
+
+bool KlineCache::flushLocked() {
+    if (impl_->pending.empty()) {
+        return true;
+    }
+    std::vector<Candle> rows;
+    rows.swap(impl_->pending);
+    return appendLocked(rows.data(), rows.size());
+}
+
+bool KlineCache::remapLocked() {
+    impl_->pending.clear();
+    impl_->unmap();
+    // A crash between column writes can leave ragged files: trim to the shortest column.
+    std::uintmax_t rows = UINTMAX_MAX;
+    for (auto& col : impl_->columns) {
+        std::error_code ec;
+        const auto bytes = fs::exists(col.path, ec) ? fs::file_size(col.path, ec) : 0;
+        rows = std::min<std::uintmax_t>(rows, ec ? 0 : bytes / kWidth);
+    }
+    if (rows == UINTMAX_MAX) {
+        rows = 0;
+    }
+    try {
+        for (auto& col : impl_->columns) {
+            std::error_code ec;
+            if (!fs::exists(col.path, ec)) {
+                std::ofstream(col.path, std::ios::binary | std::ios::app).flush();
+            }
+            if (fs::file_size(col.path, ec) != rows * kWidth) {
+                fs::resize_file(col.path, rows * kWidth, ec);
+            }
+            if (rows == 0) {
+                continue;
+            }
+            col.file = bip::file_mapping(col.path.c_str(), bip::read_only);
+            col.region = bip::mapped_region(col.file, bip::read_only, 0, static_cast<std::size_t>(rows * kWidth));
+            col.data = static_cast<const char*>(col.region.get_address());
+        }
+    } catch (const std::exception& ex) {
+        impl_->unmap();
+        telemetry::logEvent("kline_cache", "map_failed " + dir_ + ": " + ex.what());
+        return false;
+    }
+    impl_->mapped = static_cast<std::size_t>(rows);
+    impl_->count = impl_->mapped;
+    telemetry::logGauge("kline_cache", "rows", static_cast<double>(rows));
+    return true;
+}
+
+std::size_t KlineCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return impl_->count;
+}
+
+long long KlineCache::firstOpenTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return impl_->count ? impl_->value<long long>(0, 0) : 0;
+}
+
+long long KlineCache::lastOpenTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return impl_->count ? impl_->value<long long>(0, impl_->count - 1) : 0;
+}
+
+std::size_t KlineCache::lowerBoundLocked(long long openTime) const {
+    std::size_t lo = 0, hi = impl_->count;
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (impl_->value<long long>(0, mid) < openTime) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+std::size_t KlineCache::lowerBound(long long openTime) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lowerBoundLocked(openTime);
+}
+
+Candle KlineCache::atLocked(std::size_t index) const {
+    const auto& im = *impl_;
+    return Candle{im.value<long long>(0, index), im.value<long long>(1, index),
+                  im.value<double>(2, index), im.value<double>(3, index), im.value<double>(4, index),
+                  im.value<double>(5, index), im.value<double>(6, index)};
+}
+
+Candle KlineCache::at(std::size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return atLocked(index);
+}
+
+std::size_t KlineCache::read(long long fromT0, long long toT0, std::vector<Candle>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::size_t begin = lowerBoundLocked(fromT0);
+    const std::size_t end = lowerBoundLocked(toT0 == LLONG_MAX ? toT0 : toT0 + 1);
+    if (end <= begin) {
+        return 0;
+    }
+    out.reserve(out.size() + (end - begin));
+    for (std::size_t i = begin; i < end; ++i) {
+        out.push_back(atLocked(i));
+    }
+    return end - begin;
+}
+
+std::size_t KlineCache::readTail(std::size_t maxCount, std::vector<Candle>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::size_t n = std::min(maxCount, impl_->count);
+    out.reserve(out.size() + n);
+    for (std::size_t i = impl_->count - n; i < impl_->count; ++i) {
+        out.push_back(atLocked(i));
+    }
+    return n;
+}
+
+bool KlineCache::appendLocked(const Candle* first, std::size_t count) {
+    // Unmap before growing the files (Windows refuses to extend a mapped file in some cases).
+    impl_->unmap();
+    std::array<std::ofstream, kColumnCount> files;
+    for (std::size_t i = 0; i < kColumnCount; ++i) {
+        files[i].open(impl_->columns[i].path, std::ios::binary | std::ios::app);
+        if (!files[i]) {
+            remapLocked();
+            return false;
+        }
+    }
+    std::array<char[kWidth], kColumnCount> row;
+    for (std::size_t r = 0; r < count; ++r) {
+        packRow(first[r], row);
+        for (std::size_t i = 0; i < kColumnCount; ++i) {
+            files[i].write(row[i], kWidth);
+        }
+    }
+    bool ok = true;
+    for (auto& f : files) {
+        f.flush();
+        ok = ok && static_cast<bool>(f);
+        f.close();
+    }
+    return remapLocked() && ok;
+}
+
+bool KlineCache::rewriteLocked(const std::vector<Candle>& all) {
+    // The merged set goes to the next generation's files; the manifest rename swaps it in,
+    // so a crash at any point leaves one complete column set.
+    impl_->pending.clear();
+    impl_->unmap();
+    const std::uint64_t next = impl_->generation + 1;
+    std::array<std::ofstream, kColumnCount> files;
+    for (std::size_t i = 0; i < kColumnCount; ++i) {
+        files[i].open(columnPath(dir_, i, next), std::ios::binary | std::ios::trunc);
+        if (!files[i]) {
+            remapLocked();
+            return false;
+        }
+    }
+    std::array<char[kWidth], kColumnCount> row;
+    for (const auto& c : all) {
+        packRow(c, row);
+        for (std::size_t i = 0; i < kColumnCount; ++i) {
+            files[i].write(row[i], kWidth);
+        }
+    }
+    bool ok = true;
+    for (auto& f : files) {
+        f.flush();
+        ok = ok && static_cast<bool>(f);
+        f.close();
+    }
+    if (ok && writeManifestLocked(next)) {
+        setGenerationLocked(next);
+    } else {
+        ok = false;
+    }
+    removeStaleColumnsLocked();
+    return remapLocked() && ok;
+}
+
+bool KlineCache::store(const std::vector<Candle>& closed) {
+    if (closed.empty()) {
+        return true;
+    }
+    telemetry::ScopedTimer timer("kline_cache", "store");
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::size_t count = impl_->count;
+    const long long last = count ? impl_->value<long long>(0, count - 1) : LLONG_MIN;
+
+    // Split into candles already covered by the cache and the strictly newer tail.
+    auto tail = std::upper_bound(closed.begin(), closed.end(), last,
+                                 [](long long t, const Candle& c) { return t < c.t0; });
+    bool needsRewrite = false;
+    for (auto it = closed.begin(); it != tail; ++it) {
+        const std::size_t idx = lowerBoundLocked(it->t0);
+        if (idx >= count || impl_->value<long long>(0, idx) != it->t0) {
+            needsRewrite = true;
+            break;
+        }
+    }
+    if (!needsRewrite) {
+        impl_->pending.insert(impl_->pending.end(), tail, closed.end());
+        impl_->count = impl_->mapped + impl_->pending.size();
+        return impl_->pending.size() < kAppendBatch || flushLocked();
+    }
+
+    std::vector<Candle> merged;
+    merged.reserve(count + closed.size());
+    std::size_t i = 0;
+    auto it = closed.begin();
+    while (i < count || it != closed.end()) {
+        if (it == closed.end() || (i < count && impl_->value<long long>(0, i) < it->t0)) {
+            merged.push_back(atLocked(i++));
+        } else {
+            if (i < count && impl_->value<long long>(0, i) == it->t0) {
+                ++i; // fresh download wins
+            }
+            merged.push_back(*it++);
+        }
+    }
+    telemetry::logCounter("kline_cache", "rewrite", 1);
+    return rewriteLocked(merged);
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,274 @@
+#include "binancerj/core/OrderManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace binancerj::core {
+
+namespace {
+
+std::string base36(std::uint64_t v) {
+    static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    std::string out;
+    do {
+        out.push_back(kDigits[v % 36]);
+        v /= 36;
+    } while (v != 0);
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+// Millisecond start time: distinct per run, so ids never repeat across restarts.
+std::string sessionTag() {
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return base36(static_cast<std::uint64_t>(ms));
+}
+
+bool fullyExecuted(const OrderState& o) {
+    return o.origQty > 0.0 && o.executedQty >= o.origQty - 1e-12 * std::max(1.0, o.origQty);
+}
+
+} // namespace
+
+const char* toString(OrderPhase phase) {
+    switch (phase) {
+        case OrderPhase::PendingNew: return "PENDING_NEW";
+        case OrderPhase::Acked: return "NEW";
+        case OrderPhase::PartiallyFilled: return "PARTIALLY_FILLED";
+        case OrderPhase::Filled: return "FILLED";
+        case OrderPhase::Canceled: return "CANCELED";
+        case OrderPhase::Rejected: return "REJECTED";
+        case OrderPhase::Expired: return "EXPIRED";
+    }
+    return "?";
+}
+
+OrderPhase phaseFromStatus(const std::string& status) {
+    if (status == "NEW") return OrderPhase::Acked;
+    if (status == "PARTIALLY_FILLED") return OrderPhase::PartiallyFilled;
+    if (status == "FILLED") return OrderPhase::Filled;
+    if (status == "CANCELED") return OrderPhase::Canceled;
+    if (status == "REJECTED") return OrderPhase::Rejected;
+    if (status == "EXPIRED" || status == "EXPIRED_IN_MATCH") return OrderPhase::Expired;
+    return OrderPhase::PendingNew;
+}
+
+const ManagedOrder* OrderTableSnapshot::find(long long orderId) const {
+    auto it = byOrderId.find(orderId);
+    return it != byOrderId.end() ? &orders[it->second] : nullptr;
+}
+
+const ManagedOrder* OrderTableSnapshot::findClient(const std::string& clientOrderId) const {
+    auto it = byClientId.find(clientOrderId);
+    return it != byClientId.end() ? &orders[it->second] : nullptr;
+}
+
+OrderManager::OrderManager(std::string prefix)
+    : prefix_(std::move(prefix)), session_(sessionTag()), published_(std::make_shared<const OrderTableSnapshot>()) {}
+
+std::string OrderManager::newClientOrderId() {
+    return prefix_ + session_ + "-" + base36(sequence_.fetch_add(1, std::memory_order_relaxed) + 1);
+}
+
+std::uint32_t OrderManager::allocLocked() {
+    std::uint32_t slot;
+    if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+        slots_[slot] = ManagedOrder();
+        used_[slot] = true;
+    } else {
+        slot = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+        used_.push_back(true);
+    }
+    slots_[slot].slot = slot;
+    slots_[slot].sequence = ++nextSequence_;
+    return slot;
+}
+
+ManagedOrder* OrderManager::lookupLocked(long long orderId, const std::string& clientOrderId) {
+    if (orderId > 0) {
+        auto it = byOrderId_.find(orderId);
+        if (it != byOrderId_.end()) return &slots_[it->second];
+    }
+    if (!clientOrderId.empty()) {
+        auto it = byClientId_.find(clientOrderId);
+        if (it != byClientId_.end()) return &slots_[it->second];
+    }
+    return nullptr;
+}
+
+void OrderManager::indexLocked(ManagedOrder& m) {
+    if (m.order.orderId > 0) byOrderId_[m.order.orderId] = m.slot;
+    if (!m.order.clientOrderId.empty()) byClientId_[m.order.clientOrderId] = m.slot;
+}
+
+bool OrderManager::advanceLocked(ManagedOrder& m, const OrderState& update) {
+    if (isTerminal(m.phase)) return false;
+    const OrderPhase next = phaseFromStatus(update.status);
+    if (next == OrderPhase::PendingNew || next < m.phase) return false;
+    if (next == m.phase && update.updateTimeMs < m.order.updateTimeMs) return false;
+
+    const double executed = std::max(m.order.executedQty, update.executedQty);
+    const std::string clientOrderId = m.order.clientOrderId;
+    m.order = update;
+    m.order.executedQty = executed;
+    if (m.order.clientOrderId.empty()) m.order.clientOrderId = clientOrderId;
+    indexLocked(m);
+    if (isTerminal(next)) closeLocked(m, next);
+    else m.phase = next;
+    return true;
+}
+
+void OrderManager::closeLocked(ManagedOrder& m, OrderPhase phase) {
+    m.phase = phase;
+    retired_.push_back(m.slot);
+    while (retired_.size() > kRetainTerminal) {
+        const std::uint32_t slot = retired_.front();
+        retired_.pop_front();
+        const ManagedOrder& old = slots_[slot];
+        auto byId = byOrderId_.find(old.order.orderId);
+        if (byId != byOrderId_.end() && byId->second == slot) byOrderId_.erase(byId);
+        auto byClient = byClientId_.find(old.order.clientOrderId);
+        if (byClient != byClientId_.end() && byClient->second == slot) byClientId_.erase(byClient);
+        used_[slot] = false;
+        free_.push_back(slot);
+    }
+}
+
+void OrderManager::publishLocked() {
+    auto snap = std::make_shared<OrderTableSnapshot>();
+    snap->version = ++version_;
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        if (used_[i] && slots_[i].isOpen()) snap->orders.push_back(slots_[i]);
+    }
+    std::sort(snap->orders.begin(), snap->orders.end(), [](const ManagedOrder& a, const ManagedOrder& b) { return a.sequence < b.sequence; });
+    for (std::size_t i = 0; i < snap->orders.size(); ++i) {
+        const OrderState& o = snap->orders[i].order;
+        if (o.orderId > 0) snap->byOrderId.emplace(o.orderId, static_cast<std::uint32_t>(i));
+        if (!o.clientOrderId.empty()) snap->byClientId.emplace(o.clientOrderId, static_cast<std::uint32_t>(i));
+    }
+    published_ = std::move(snap);
+    changed_.notify_all();
+}
+
+std::string OrderManager::submit(OrderState order, long long nowMs) {
+    if (order.clientOrderId.empty()) order.clientOrderId = newClientOrderId();
+    std::lock_guard<std::mutex> lock(mutex_);
+    ManagedOrder& m = slots_[allocLocked()];
+    m.phase = OrderPhase::PendingNew;
+    order.status.clear();
+    order.updateTimeMs = nowMs;
+    m.order = std::move(order);
+    m.submitTimeMs = nowMs;
+    indexLocked(m);
+    publishLocked();
+    return m.order.clientOrderId;
+}
+
+void OrderManager::onAck(const std::string& clientOrderId, const OrderState& ack) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ManagedOrder* m = lookupLocked(ack.orderId, clientOrderId);
+    if (!m) return;
+    if (advanceLocked(*m, ack)) publishLocked();
+}
+
+void OrderManager::onReject(const std::string& clientOrderId, const std::string& reason, long long nowMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ManagedOrder* m = lookupLocked(0, clientOrderId);
+    // An event may already have placed it: the answer that failed was a timeout, not a refusal.
+    if (!m || m->phase != OrderPhase::PendingNew) return;
+    m->rejectReason = reason;
+    m->order.updateTimeMs = nowMs;
+    closeLocked(*m, OrderPhase::Rejected);
+    publishLocked();
+}
+
+void OrderManager::applyUpdate(const OrderState& order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ManagedOrder* m = lookupLocked(order.orderId, order.clientOrderId);
+    if (!m) {
+        const OrderPhase phase = phaseFromStatus(order.status);
+        if (phase == OrderPhase::PendingNew || isTerminal(phase)) return;  // closed before we saw it
+        m = &slots_[allocLocked()];
+    }
+    if (advanceLocked(*m, order)) publishLocked();
+}
+
+std::size_t OrderManager::reconcile(const std::vector<OrderState>& openOrders, long long fetchStartMs, std::vector<OrderState>* unanswered) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t corrected = 0;
+    std::vector<bool> listed(slots_.size(), false);
+
+    for (const auto& o : openOrders) {
+        ManagedOrder* m = lookupLocked(o.orderId, o.clientOrderId);
+        if (!m) {
+            if (phaseFromStatus(o.status) == OrderPhase::PendingNew) continue;
+            m = &slots_[allocLocked()];
+            listed.resize(slots_.size(), false);
+            ++corrected;  // open without an event reaching us
+        }
+        listed[m->slot] = true;
+        if (isTerminal(m->phase)) continue;  // we saw it close after the fetch
+        if (m->phase != OrderPhase::PendingNew && m->order.updateTimeMs >= fetchStartMs) continue;  // changed while the request was out
+        const OrderPhase before = m->phase;
+        const double executedBefore = m->order.executedQty;
+        const double priceBefore = m->order.price;
+        if (advanceLocked(*m, o) && before != OrderPhase::PendingNew &&
+            (m->phase != before || m->order.executedQty != executedBefore || m->order.price != priceBefore)) {
+            ++corrected;
+        }
+    }
+
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        ManagedOrder& m = slots_[i];
+        if (!used_[i] || listed[i] || !m.isOpen()) continue;
+        if (m.phase == OrderPhase::PendingNew) {
+            if (m.submitTimeMs + kAckTimeoutMs >= fetchStartMs) continue;  // answer may still come
+            // Missing from the open list does not mean refused: it may have filled at once.
+            if (unanswered) unanswered->push_back(m.order);
+        } else if (m.order.updateTimeMs < fetchStartMs) {
+            // Closed without an event reaching us; the final status is not in the open list.
+            closeLocked(m, fullyExecuted(m.order) ? OrderPhase::Filled : OrderPhase::Canceled);
+            ++corrected;
+        }
+    }
+
+    publishLocked();
+    return corrected;
+}
+
+std::shared_ptr<const OrderTableSnapshot> OrderManager::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_;
+}
+
+std::uint64_t OrderManager::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+std::uint64_t OrderManager::waitForChange(std::uint64_t seen, std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait_for(lock, timeout, [this, seen]() { return version_ != seen; });
+    return version_;
+}
+
+bool OrderManager::find(long long orderId, ManagedOrder& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = byOrderId_.find(orderId);
+    if (it == byOrderId_.end()) return false;
+    out = slots_[it->second];
+    return true;
+}
+
+bool OrderManager::findClient(const std::string& clientOrderId, ManagedOrder& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = byClientId_.find(clientOrderId);
+    if (it == byClientId_.end()) return false;
+    out = slots_[it->second];
+    return true;
+}
+
+} // namespace binancerj::core
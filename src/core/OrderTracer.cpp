@@ -0,0 +1,210 @@
+#include "binancerj/core/OrderTracer.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace binancerj::core {
+
+namespace {
+
+constexpr double kSubBuckets = 4.0;  // per power of two
+
+std::uint8_t bit(OrderStage stage) {
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned>(stage));
+}
+
+std::string fixed(double v, int decimals = 1) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return buf;
+}
+
+} // namespace
+
+const char* toString(OrderStage stage) {
+    switch (stage) {
+        case OrderStage::Intent: return "intent";
+        case OrderStage::Signed: return "signed";
+        case OrderStage::Written: return "written";
+        case OrderStage::Acked: return "acked";
+        case OrderStage::NewEvent: return "new_event";
+        case OrderStage::FirstFill: return "first_fill";
+    }
+    return "?";
+}
+
+void LatencyHistogram::add(double us) {
+    if (!(us >= 0.0)) return;
+    const double pos = us < 1.0 ? 0.0 : std::log2(us) * kSubBuckets;
+    const std::size_t i = std::min<std::size_t>(kBuckets - 1, static_cast<std::size_t>(pos));
+    ++buckets_[i];
+    if (count_ == 0 || us < min_) min_ = us;
+    if (us > max_) max_ = us;
+    sum_ += us;
+    ++count_;
+}
+
+double LatencyHistogram::quantile(double q) const {
+    if (count_ == 0) return 0.0;
+    const double target = std::clamp(q, 0.0, 1.0) * static_cast<double>(count_);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets_[i];
+        if (buckets_[i] != 0 && static_cast<double>(seen) >= target) return std::min(bucketUpperUs(i), max_);
+    }
+    return max_;
+}
+
+double LatencyHistogram::bucketUpperUs(std::size_t i) {
+    return std::exp2(static_cast<double>(i + 1) / kSubBuckets);
+}
+
+const std::array<OrderTracer::Span, OrderTracer::kSpanCount>& OrderTracer::spans() {
+    // Exchange-side spans start at Written: that is when the request left this process.
+    static const std::array<Span, kSpanCount> kSpans = {{
+        {"queue_sign", OrderStage::Intent, OrderStage::Signed},
+        {"write", OrderStage::Signed, OrderStage::Written},
+        {"ack", OrderStage::Written, OrderStage::Acked},
+        {"new_event", OrderStage::Written, OrderStage::NewEvent},
+        {"first_fill", OrderStage::Written, OrderStage::FirstFill},
+        {"intent_to_ack", OrderStage::Intent, OrderStage::Acked},
+    }};
+    return kSpans;
+}
+
+OrderTracer::OrderTracer(std::size_t capacity) : traces_(std::max<std::size_t>(1, capacity)) {}
+
+std::uint64_t OrderTracer::begin(const std::string& clientOrderId, const std::string& orderType, Clock::time_point at) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::uint64_t id = ++nextId_;
+    Trace& t = traces_[id % traces_.size()];
+    if (t.id != 0) {
+        auto it = byClientId_.find(t.clientOrderId);
+        if (it != byClientId_.end() && it->second == t.id) byClientId_.erase(it);
+    }
+    t.id = id;
+    t.clientOrderId = clientOrderId;
+    t.orderType = orderType;
+    t.stamped = 0;
+    if (!clientOrderId.empty()) byClientId_[clientOrderId] = id;
+    markLocked(t, OrderStage::Intent, at);
+    return id;
+}
+
+void OrderTracer::mark(std::uint64_t traceId, OrderStage stage, Clock::time_point at) {
+    if (traceId == 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Trace& t = traces_[traceId % traces_.size()];
+    if (t.id == traceId) markLocked(t, stage, at);
+}
+
+void OrderTracer::mark(const std::string& clientOrderId, OrderStage stage, Clock::time_point at) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = byClientId_.find(clientOrderId);
+    if (it == byClientId_.end()) return;
+    Trace& t = traces_[it->second % traces_.size()];
+    if (t.id == it->second) markLocked(t, stage, at);
+}
+
+void OrderTracer::markLocked(Trace& t, OrderStage stage, Clock::time_point at) {
+    if (t.stamped & bit(stage)) return;
+    t.stamped |= bit(stage);
+    t.at[static_cast<std::size_t>(stage)] = at;
+
+    // Close every span this stamp completes, whichever end arrived first.
+    TypeStats* stats = nullptr;
+    const auto& all = spans();
+    for (std::size_t s = 0; s < all.size(); ++s) {
+        const Span& span = all[s];
+        if (span.from != stage && span.to != stage) continue;
+        if (!(t.stamped & bit(span.from)) || !(t.stamped & bit(span.to))) continue;
+        if (!stats) stats = &byType_[t.orderType];
+        const auto elapsed = t.at[static_cast<std::size_t>(span.to)] - t.at[static_cast<std::size_t>(span.from)];
+        stats->spans[s].add(std::chrono::duration<double, std::micro>(elapsed).count());
+    }
+}
+
+std::vector<OrderTracer::SpanStats> OrderTracer::stats() const {
+    std::vector<SpanStats> out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [type, stats] : byType_) {
+        for (std::size_t s = 0; s < spans().size(); ++s) {
+            if (stats.spans[s].count() == 0) continue;
+            out.push_back(SpanStats{type, spans()[s].name, stats.spans[s]});
+        }
+    }
+    return out;
+}
+
+void OrderTracer::publish() {
+    std::vector<SpanStats> fresh;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [type, stats] : byType_) {
+            for (std::size_t s = 0; s < spans().size(); ++s) {
+                const std::uint64_t n = stats.spans[s].count();
+                if (n == stats.published[s]) continue;
+                stats.published[s] = n;
+                fresh.push_back(SpanStats{type, spans()[s].name, stats.spans[s]});
+            }
+        }
+    }
+    // Logged outside the lock: the telemetry file must not stall the order path.
+    for (const auto& row : fresh) {
+        const std::string label = row.orderType + "." + row.span;
+        telemetry::logGauge("order_trace", label + ".count", static_cast<double>(row.histogram.count()));
+        telemetry::logGauge("order_trace", label + ".p50_us", row.histogram.quantile(0.50));
+        telemetry::logGauge("order_trace", label + ".p99_us", row.histogram.quantile(0.99));
+    }
+}
+
+std::string OrderTracer::reportCsv() const {
+    std::string out = "order_type,span,count,mean_us,min_us,p50_us,p90_us,p99_us,max_us\n";
+    for (const auto& row : stats()) {
+        const LatencyHistogram& h = row.histogram;
+        out += row.orderType + "," + row.span + "," + std::to_string(h.count()) + "," + fixed(h.mean()) + "," + fixed(h.min()) + "," +
+               fixed(h.quantile(0.50)) + "," + fixed(h.quantile(0.90)) + "," + fixed(h.quantile(0.99)) + "," + fixed(h.max()) + "\n";
+    }
+    return out;
+}
+
+std::string OrderTracer::reportJson() const {
+    std::string out = "{\"spans\":[";
+    bool first = true;
+    for (const auto& row : stats()) {
+        const LatencyHistogram& h = row.histogram;
+        if (!first) out += ',';
+        first = false;
+        out += "{\"order_type\":\"" + row.orderType + "\",\"span\":\"" + row.span + "\",\"count\":" + std::to_string(h.count()) +
+               ",\"mean_us\":" + fixed(h.mean()) + ",\"min_us\":" + fixed(h.min()) + ",\"p50_us\":" + fixed(h.quantile(0.50)) +
+               ",\"p90_us\":" + fixed(h.quantile(0.90)) + ",\"p99_us\":" + fixed(h.quantile(0.99)) + ",\"max_us\":" + fixed(h.max()) +
+               ",\"buckets\":[";
+        bool firstBucket = true;
+        for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+            if (h.buckets()[i] == 0) continue;
+            if (!firstBucket) out += ',';
+            firstBucket = false;
+            out += "{\"le_us\":" + fixed(LatencyHistogram::bucketUpperUs(i)) + ",\"n\":" + std::to_string(h.buckets()[i]) + "}";
+        }
+        out += "]}";
+    }
+    out += "]}\n";
+    return out;
+}
+
+bool OrderTracer::writeReport(const std::string& basePath) const {
+    const std::filesystem::path base(basePath);
+    std::error_code ec;
+    if (base.has_parent_path()) std::filesystem::create_directories(base.parent_path(), ec);
+    std::ofstream csv(basePath + ".csv", std::ios::binary | std::ios::trunc);
+    csv << reportCsv();
+    std::ofstream json(basePath + ".json", std::ios::binary | std::ios::trunc);
+    json << reportJson();
+    return csv.good() && json.good();
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,198 @@
+#include "binancerj/core/SweepDetector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace binancerj::core {
+
+SweepDetector::SweepDetector(std::size_t maxSymbols, std::size_t eventCapacity,
+                             double quantile, std::uint64_t warmupSamples)
+    : symbols_(maxSymbols ? maxSymbols : 1),
+      ring_(eventCapacity ? eventCapacity : 1),
+      quantile_(quantile),
+      warmupSamples_(warmupSamples) {
+    for (auto& s : symbols_) {
+        s.sizes = P2Quantile(quantile);
+    }
+}
+
+void SweepDetector::setLevelProbe(LevelProbe probe, void* context) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    probe_ = probe;
+    probeContext_ = context;
+}
+
+void SweepDetector::setMinLevels(std::uint32_t levels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    minLevels_ = std::max<std::uint32_t>(2, levels);
+}
+
+double SweepDetector::thresholdLocked(const SymbolState& state) const {
+    if (state.sizes.count() < warmupSamples_) {
+        return 0.0;
+    }
+    return state.sizes.value();
+}
+
+void SweepDetector::onTrade(std::uint16_t slot, long long ts, double price, double qty, bool isBuy) {
+    if (!(price > 0.0) || !(qty > 0.0)) {
+        return;
+    }
+    Pending closed;
+    LevelProbe probe = nullptr;
+    void* probeContext = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (slot >= symbols_.size()) {
+            return;
+        }
+        auto& g = symbols_[slot].pending;
+        if (g.open && (g.ts != ts || g.isBuy != isBuy)) {
+            closed = g;
+            g.open = false;
+        }
+        if (!g.open) {
+            probe = probe_;
+            probeContext = probeContext_;
+            g.bookLevels = -1;
+            g.open = true;
+            g.isBuy = isBuy;
+            g.ts = ts;
+            g.firstPrice = price;
+            g.lastPrice = price;
+            g.qty = 0.0;
+            g.notional = 0.0;
+            g.trades = 0;
+            g.distinctPrices = 1;
+        } else if (price != g.lastPrice) {
+            ++g.distinctPrices;
+            g.lastPrice = price;
+        }
+        g.qty += qty;
+        g.notional += price * qty;
+        ++g.trades;
+    }
+    if (closed.open) {
+        closeGroup(slot, closed);
+    }
+    if (probe) {
+        // Snapshot the passive side now: by the time the group closes, the depth stream has
+        // already removed the levels it swept. The probe takes the book's lock, so it runs
+        // without ours (no lock-order tie to the book writer).
+        std::array<double, kProbeLevels> prices;
+        const int n = probe(probeContext, slot, price, isBuy, prices.data(), kProbeLevels);
+        if (n >= 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& g = symbols_[slot].pending;
+            if (g.open && g.ts == ts && g.isBuy == isBuy && g.bookLevels < 0) {
+                g.bookLevels = std::min(n, kProbeLevels);
+                std::copy(prices.begin(), prices.begin() + g.bookLevels, g.bookPrices.begin());
+            }
+        }
+    }
+}
+
+void SweepDetector::reset(std::uint16_t slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slot >= symbols_.size()) {
+        return;
+    }
+    symbols_[slot].pending = Pending{};
+    symbols_[slot].sizes = P2Quantile(quantile_);
+}
+
+void SweepDetector::flush(long long nowMs, long long graceMs) {
+    for (std::size_t i = 0; i < symbols_.size(); ++i) {
+        Pending closed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& g = symbols_[i].pending;
+            if (!g.open || g.ts >= nowMs - graceMs) {
+                continue;
+            }
+            closed = g;
+            g.open = false;
+        }
+        closeGroup(static_cast<std::uint16_t>(i), closed);
+    }
+}
+
+std::uint32_t SweepDetector::sweptLevels(const Pending& g) {
+    const double lo = std::min(g.firstPrice, g.lastPrice);
+    const double hi = std::max(g.firstPrice, g.lastPrice);
+    const double eps = 1e-9 * std::max(1.0, std::abs(hi));
+    std::uint32_t n = 0;
+    for (int i = 0; i < g.bookLevels; ++i) {
+        const double p = g.bookPrices[static_cast<std::size_t>(i)];
+        if (p >= lo - eps && p <= hi + eps) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+void SweepDetector::closeGroup(std::uint16_t slot, const Pending& g) {
+    std::uint32_t levels = g.distinctPrices;
+    if (g.distinctPrices > 1 && g.bookLevels > 0) {
+        levels = std::max(levels, sweptLevels(g));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& state = symbols_[slot];
+    const double threshold = thresholdLocked(state);
+    std::uint8_t flags = 0;
+    if (levels >= minLevels_) {
+        flags |= SweepEvent::MultiLevel;
+    }
+    if (threshold > 0.0 && g.qty >= threshold) {
+        flags |= SweepEvent::Outlier;
+    }
+    // Classify against the distribution before this order joins it.
+    state.sizes.add(g.qty);
+
+    if (flags == 0) {
+        return;
+    }
+    auto& ev = ring_[static_cast<std::size_t>(nextSeq_ % ring_.size())];
+    ev.seq = nextSeq_++;
+    ev.slot = slot;
+    ev.flags = flags;
+    ev.isBuy = g.isBuy;
+    ev.ts = g.ts;
+    ev.firstPrice = g.firstPrice;
+    ev.lastPrice = g.lastPrice;
+    ev.vwap = g.qty > 0.0 ? g.notional / g.qty : g.lastPrice;
+    ev.qty = g.qty;
+    ev.notional = g.notional;
+    ev.trades = g.trades;
+    ev.levels = levels;
+    ev.threshold = threshold;
+}
+
+std::size_t SweepDetector::readSince(std::uint64_t& cursor, std::vector<SweepEvent>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.clear();
+    const std::uint64_t capacity = ring_.size();
+    if (nextSeq_ > capacity && cursor < nextSeq_ - capacity) {
+        cursor = nextSeq_ - capacity;
+    }
+    for (; cursor < nextSeq_; ++cursor) {
+        out.push_back(ring_[static_cast<std::size_t>(cursor % capacity)]);
+    }
+    return out.size();
+}
+
+double SweepDetector::threshold(std::uint16_t slot) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slot >= symbols_.size()) {
+        return 0.0;
+    }
+    return thresholdLocked(symbols_[slot]);
+}
+
+std::uint64_t SweepDetector::published() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nextSeq_;
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,360 @@
+#include "binancerj/core/SymbolTable.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace binancerj::core {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kFileHeader = "#symbols v1";
+
+// Forward-only reader over exchangeInfo: pulls the few fields the table needs and skips the
+// rest without building a DOM. Strings are returned raw (symbol names and filter values carry
+// no escapes).
+class JsonCursor {
+public:
+    explicit JsonCursor(std::string_view text) : p_(text.data()), end_(text.data() + text.size()) {}
+
+    bool consume(char c) {
+        ws();
+        if (p_ < end_ && *p_ == c) {
+            ++p_;
+            return true;
+        }
+        return false;
+    }
+
+    bool string(std::string_view& out) {
+        ws();
+        if (p_ >= end_ || *p_ != '"') return false;
+        const char* start = ++p_;
+        while (p_ < end_ && *p_ != '"') {
+            p_ += (*p_ == '\\') ? 2 : 1;
+        }
+        if (p_ >= end_) return false;
+        out = std::string_view(start, static_cast<std::size_t>(p_ - start));
+        ++p_;
+        return true;
+    }
+
+    // String contents or a bare literal (number, true, false, null).
+    bool scalar(std::string_view& out) {
+        ws();
+        if (p_ < end_ && *p_ == '"') return string(out);
+        const char* start = p_;
+        while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' && !std::isspace(static_cast<unsigned char>(*p_))) ++p_;
+        out = std::string_view(start, static_cast<std::size_t>(p_ - start));
+        return p_ > start;
+    }
+
+    bool skip() {
+        ws();
+        if (p_ >= end_) return false;
+        if (*p_ == '"') {
+            std::string_view ignored;
+            return string(ignored);
+        }
+        if (*p_ != '{' && *p_ != '[') {
+            std::string_view ignored;
+            return scalar(ignored);
+        }
+        int depth = 0;
+        while (p_ < end_) {
+            const char c = *p_;
+            if (c == '"') {
+                std::string_view ignored;
+                if (!string(ignored)) return false;
+                continue;
+            }
+            ++p_;
+            if (c == '{' || c == '[') ++depth;
+            else if ((c == '}' || c == ']') && --depth == 0) return true;
+        }
+        return false;
+    }
+
+    // Iterates "key": value pairs of an object; fn(key) must consume the value.
+    template <typename Fn>
+    bool object(Fn&& fn) {
+        if (!consume('{')) return false;
+        if (consume('}')) return true;
+        do {
+            std::string_view key;
+            if (!string(key) || !consume(':') || !fn(key)) return false;
+        } while (consume(','));
+        return consume('}');
+    }
+
+    // Iterates the elements of an array; fn() must consume one element.
+    template <typename Fn>
+    bool array(Fn&& fn) {
+        if (!consume('[')) return false;
+        if (consume(']')) return true;
+        do {
+            if (!fn()) return false;
+        } while (consume(','));
+        return consume(']');
+    }
+
+private:
+    void ws() {
+        while (p_ < end_ && std::isspace(static_cast<unsigned char>(*p_))) ++p_;
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+double toDouble(std::string_view s) {
+    double v = 0.0;
+    std::from_chars(s.data(), s.data() + s.size(), v);
+    return v;
+}
+
+long long toInt(std::string_view s) {
+    long long v = 0;
+    std::from_chars(s.data(), s.data() + s.size(), v);
+    return v;
+}
+
+ContractType parseContractType(std::string_view s) {
+    if (s == "PERPETUAL") return ContractType::Perpetual;
+    if (s == "CURRENT_QUARTER") return ContractType::CurrentQuarter;
+    if (s == "NEXT_QUARTER") return ContractType::NextQuarter;
+    return ContractType::Other;
+}
+
+bool parseFilters(JsonCursor& in, SymbolInfo& info) {
+    return in.array([&]() {
+        // Keys come in any order: collect first, apply once filterType is known.
+        std::string_view type, tick, step, minQty, notional;
+        const bool ok = in.object([&](std::string_view key) {
+            if (key == "filterType") return in.scalar(type);
+            if (key == "tickSize") return in.scalar(tick);
+            if (key == "stepSize") return in.scalar(step);
+            if (key == "minQty") return in.scalar(minQty);
+            if (key == "notional") return in.scalar(notional);
+            return in.skip();
+        });
+        if (type == "PRICE_FILTER") {
+            info.tickSize = toDouble(tick);
+        } else if (type == "LOT_SIZE") {
+            info.stepSize = toDouble(step);
+            info.minQty = toDouble(minQty);
+        } else if (type == "MARKET_LOT_SIZE") {
+            info.marketStepSize = toDouble(step);
+            info.marketMinQty = toDouble(minQty);
+        } else if (type == "MIN_NOTIONAL") {
+            info.minNotional = toDouble(notional);
+        }
+        return ok;
+    });
+}
+
+bool sameRules(const SymbolInfo& a, const SymbolInfo& b) {
+    return a.contractType == b.contractType && a.trading == b.trading && a.tickSize == b.tickSize
+        && a.stepSize == b.stepSize && a.minQty == b.minQty && a.marketStepSize == b.marketStepSize
+        && a.marketMinQty == b.marketMinQty && a.minNotional == b.minNotional
+        && a.pricePrecision == b.pricePrecision && a.quantityPrecision == b.quantityPrecision;
+}
+
+void appendDouble(std::string& out, double v) {
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), v);  // shortest round-trip form
+    out.append(buf, res.ptr);
+}
+
+} // namespace
+
+double SymbolInfo::floorPrice(double price) const {
+    return tickSize > 0.0 ? std::floor((price + 1e-12) / tickSize) * tickSize : price;
+}
+
+double SymbolInfo::ceilPrice(double price) const {
+    return tickSize > 0.0 ? std::ceil((price - 1e-12) / tickSize) * tickSize : price;
+}
+
+double SymbolInfo::floorQty(double qty, bool market) const {
+    const double step = market ? marketStepSize : stepSize;
+    return step > 0.0 ? std::floor((qty + 1e-12) / step) * step : qty;
+}
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolId SymbolTable::intern(std::string_view symbol) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return internLocked(symbol);
+}
+
+SymbolId SymbolTable::internLocked(std::string_view symbol) {
+    auto it = ids_.find(std::string(symbol));
+    if (it != ids_.end()) return it->second;
+    if (ids_.size() >= kMaxSymbols) return kNoSymbol;
+    const SymbolId id = static_cast<SymbolId>(ids_.size());
+    ids_.emplace(std::string(symbol), id);
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(std::string(symbol));
+    return it == ids_.end() ? kNoSymbol : it->second;
+}
+
+void SymbolTable::publishLocked(SymbolInfo info) {
+    const SymbolId id = internLocked(info.symbol);
+    if (id == kNoSymbol) return;
+    auto& slot = slots_[static_cast<std::size_t>(id)];
+    if (info.marketStepSize <= 0.0) info.marketStepSize = info.stepSize;
+    if (info.marketMinQty <= 0.0) info.marketMinQty = info.minQty;
+    const SymbolInfo* current = slot.load(std::memory_order_relaxed);
+    if (current && sameRules(*current, info)) return;
+    storage_.push_back(std::make_unique<const SymbolInfo>(std::move(info)));
+    slot.store(storage_.back().get(), std::memory_order_release);
+    if (!current) count_.fetch_add(1, std::memory_order_release);
+}
+
+std::size_t SymbolTable::loadExchangeInfo(std::string_view json) {
+    telemetry::ScopedTimer timer("symbols", "parse_exchange_info");
+    std::vector<SymbolInfo> parsed;
+    long long serverTime = 0;
+    JsonCursor in(json);
+    const bool ok = in.object([&](std::string_view key) {
+        if (key == "serverTime") {
+            std::string_view v;
+            if (!in.scalar(v)) return false;
+            serverTime = toInt(v);
+            return true;
+        }
+        if (key != "symbols") return in.skip();
+        return in.array([&]() {
+            SymbolInfo info;
+            const bool symbolOk = in.object([&](std::string_view field) {
+                std::string_view v;
+                if (field == "filters") return parseFilters(in, info);
+                if (field == "symbol") { if (!in.scalar(v)) return false; info.symbol.assign(v); return true; }
+                if (field == "contractType") { if (!in.scalar(v)) return false; info.contractType = parseContractType(v); return true; }
+                if (field == "status") { if (!in.scalar(v)) return false; info.trading = v == "TRADING"; return true; }
+                if (field == "pricePrecision") { if (!in.scalar(v)) return false; info.pricePrecision = static_cast<int>(toInt(v)); return true; }
+                if (field == "quantityPrecision") { if (!in.scalar(v)) return false; info.quantityPrecision = static_cast<int>(toInt(v)); return true; }
+                return in.skip();
+            });
+            if (symbolOk && !info.symbol.empty()) parsed.push_back(std::move(info));
+            return symbolOk;
+        });
+    });
+    if (!ok) {
+        telemetry::logEvent("symbols", "exchange_info_parse_failed parsed=" + std::to_string(parsed.size()));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& info : parsed) publishLocked(std::move(info));
+    if (serverTime > 0) updatedMs_.store(serverTime, std::memory_order_relaxed);
+    telemetry::logGauge("symbols", "loaded", static_cast<double>(parsed.size()));
+    return parsed.size();
+}
+
+bool SymbolTable::save(const std::string& path) const {
+    std::string out;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.reserve(ids_.size() * 96);
+        out.append(kFileHeader).append(" updatedMs=").append(std::to_string(updatedMs_.load(std::memory_order_relaxed))).append(1, '\n');
+        for (std::size_t id = 0; id < ids_.size(); ++id) {
+            const SymbolInfo* s = slots_[id].load(std::memory_order_relaxed);
+            if (!s) continue;
+            out.append(s->symbol);
+            out.append(1, '\t').append(std::to_string(static_cast<int>(s->contractType)));
+            out.append(1, '\t').append(s->trading ? "1" : "0");
+            for (double v : {s->tickSize, s->stepSize, s->minQty, s->marketStepSize, s->marketMinQty, s->minNotional}) {
+                out.append(1, '\t');
+                appendDouble(out, v);
+            }
+            out.append(1, '\t').append(std::to_string(s->pricePrecision));
+            out.append(1, '\t').append(std::to_string(s->quantityPrecision));
+            out.append(1, '\n');
+        }
+    }
+    // Write aside and rename so a crash never leaves a truncated table.
+    std::error_code ec;
+    const fs::path target(path);
+    if (target.has_parent_path()) fs::create_directories(target.parent_path(), ec);
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            telemetry::logEvent("symbols", "save_failed " + path);
+            return false;
+        }
+    }
+    fs::rename(tmp, target, ec);
+    if (ec) {
+        telemetry::logEvent("symbols", "save_failed " + path + ": " + ec.message());
+        return false;
+    }
+    return true;
+}
+
+std::size_t SymbolTable::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return 0;
+    std::string line;
+    if (!std::getline(file, line) || line.rfind(kFileHeader, 0) != 0) {
+        telemetry::logEvent("symbols", "load_skipped bad header " + path);
+        return 0;
+    }
+    long long updated = 0;
+    const auto eq = line.find("updatedMs=");
+    if (eq != std::string::npos) updated = toInt(std::string_view(line).substr(eq + 10));
+
+    std::vector<SymbolInfo> parsed;
+    while (std::getline(file, line)) {
+        std::string_view fields[11];
+        std::size_t n = 0, pos = 0;
+        while (n < 11 && pos <= line.size()) {
+            std::size_t tab = line.find('\t', pos);
+            if (tab == std::string::npos) tab = line.size();
+            fields[n++] = std::string_view(line).substr(pos, tab - pos);
+            pos = tab + 1;
+        }
+        if (n != 11 || fields[0].empty()) continue;
+        SymbolInfo info;
+        info.symbol.assign(fields[0]);
+        const long long type = toInt(fields[1]);
+        info.contractType = type >= 0 && type <= static_cast<int>(ContractType::Other) ? static_cast<ContractType>(type) : ContractType::Other;
+        info.trading = fields[2] == "1";
+        info.tickSize = toDouble(fields[3]);
+        info.stepSize = toDouble(fields[4]);
+        info.minQty = toDouble(fields[5]);
+        info.marketStepSize = toDouble(fields[6]);
+        info.marketMinQty = toDouble(fields[7]);
+        info.minNotional = toDouble(fields[8]);
+        info.pricePrecision = static_cast<int>(toInt(fields[9]));
+        info.quantityPrecision = static_cast<int>(toInt(fields[10]));
+        parsed.push_back(std::move(info));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Never let a stale file roll back newer data already loaded from the exchange.
+    if (updatedMs_.load(std::memory_order_relaxed) > updated) {
+        telemetry::logEvent("symbols", "load_skipped older than table " + path);
+        return 0;
+    }
+    for (auto& info : parsed) publishLocked(std::move(info));
+    updatedMs_.store(updated, std::memory_order_relaxed);
+    telemetry::logEvent("symbols", "warm_start file=" + path + " symbols=" + std::to_string(parsed.size()));
+    return parsed.size();
+}
+
+} // namespace binancerj::core
@@ -0,0 +1,163 @@
+#include "binancerj/core/TradeStats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace binancerj::core {
+
+namespace {
+
+constexpr long long kDayMs = 24LL * 60 * 60 * 1000;
+
+long long wallClockMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+RollingVolumeWindow::RollingVolumeWindow(long long spanMs, std::size_t slots)
+    : slotMs_(std::max<long long>(1, spanMs / static_cast<long long>(slots ? slots : 1))),
+      spanMs_(spanMs),
+      ring_(slots ? slots : 1) {
+}
+
+void RollingVolumeWindow::clear() {
+    std::fill(ring_.begin(), ring_.end(), Totals{});
+    totals_ = Totals{};
+    headSlot_ = 0;
+}
+
+void RollingVolumeWindow::advanceTo(long long ts) {
+    const long long slot = ts / slotMs_;
+    if (slot <= headSlot_) {
+        return;
+    }
+    const long long n = static_cast<long long>(ring_.size());
+    if (headSlot_ == 0 || slot - headSlot_ >= n) {
+        std::fill(ring_.begin(), ring_.end(), Totals{});
+        totals_ = Totals{};
+        headSlot_ = slot;
+        return;
+    }
+    for (long long s = headSlot_ + 1; s <= slot; ++s) {
+        auto& expired = ring_[static_cast<std::size_t>(s % n)];
+        totals_.buyVolume -= expired.buyVolume;
+        totals_.sellVolume -= expired.sellVolume;
+        totals_.buyCount -= expired.buyCount;
+        totals_.sellCount -= expired.sellCount;
+        expired = Totals{};
+    }
+    headSlot_ = slot;
+    // Re-sum once per lap so floating-point subtraction error cannot accumulate.
+    if (slot % n == 0) {
+        Totals exact;
+        for (const auto& t : ring_) {
+            exact.buyVolume += t.buyVolume;
+            exact.sellVolume += t.sellVolume;
+            exact.buyCount += t.buyCount;
+            exact.sellCount += t.sellCount;
+        }
+        totals_ = exact;
+    }
+}
+
+void RollingVolumeWindow::add(long long ts, double qty, bool isBuy) {
+    advanceTo(ts);
+    const long long slot = ts / slotMs_;
+    const long long n = static_cast<long long>(ring_.size());
+    if (slot <= headSlot_ - n) {
+        return; // already outside the window
+    }
+    auto& bucket = ring_[static_cast<std::size_t>(slot % n)];
+    if (isBuy) {
+        bucket.buyVolume += qty;
+        bucket.buyCount += 1;
+        totals_.buyVolume += qty;
+        totals_.buyCount += 1;
+    } else {
+        bucket.sellVolume += qty;
+        bucket.sellCount += 1;
+        totals_.sellVolume += qty;
+        totals_.sellCount += 1;
+    }
+}
+
+TradeStats::TradeStats(long long anchorMs)
+    : windows_{{RollingVolumeWindow(kWindowSpansMs[0], 20),
+                RollingVolumeWindow(kWindowSpansMs[1], 20),
+                RollingVolumeWindow(kWindowSpansMs[2], 60)}} {
+    anchor(anchorMs);
+}
+
+void TradeStats::anchor(long long anchorMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    anchorMs_ = anchorMs > 0 ? anchorMs : (wallClockMs() / kDayMs) * kDayMs;
+    refPrice_ = 0.0;
+    sumV_ = sumDV_ = sumD2V_ = 0.0;
+    cvd_ = 0.0;
+    tradeCount_ = 0;
+}
+
+void TradeStats::reset(long long anchorMs) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& w : windows_) {
+            w.clear();
+        }
+        lastPrice_ = 0.0;
+        lastTs_ = 0;
+    }
+    anchor(anchorMs);
+}
+
+void TradeStats::addTrade(long long ts, double price, double qty, bool isBuy) {
+    if (!(price > 0.0) || !(qty > 0.0)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& w : windows_) {
+        w.add(ts, qty, isBuy);
+    }
+    if (ts >= lastTs_) {
+        lastTs_ = ts;
+        lastPrice_ = price;
+    }
+    if (ts < anchorMs_) {
+        return;
+    }
+    if (refPrice_ <= 0.0) {
+        refPrice_ = price;
+    }
+    const double d = price - refPrice_;
+    sumV_ += qty;
+    sumDV_ += d * qty;
+    sumD2V_ += d * d * qty;
+    cvd_ += isBuy ? qty : -qty;
+    ++tradeCount_;
+}
+
+TradeStats::Snapshot TradeStats::snapshot(long long nowMs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Snapshot snap;
+    snap.anchorMs = anchorMs_;
+    snap.volume = sumV_;
+    snap.cvd = cvd_;
+    snap.lastPrice = lastPrice_;
+    snap.lastTs = lastTs_;
+    snap.tradeCount = tradeCount_;
+    if (sumV_ > 0.0) {
+        const double meanD = sumDV_ / sumV_;
+        snap.vwap = refPrice_ + meanD;
+        snap.stdev = std::sqrt(std::max(0.0, sumD2V_ / sumV_ - meanD * meanD));
+    }
+    const long long now = nowMs > 0 ? nowMs : wallClockMs();
+    for (std::size_t i = 0; i < windows_.size(); ++i) {
+        windows_[i].advanceTo(now);
+        snap.windows[i] = windows_[i].totals();
+    }
+    return snap;
+}
+
+} // namespace binancerj::core
@@ -1,4 +1,5 @@
 #include "binancerj/net/AsyncWebSocketHub.hpp"
+#include "binancerj/net/TlsContext.hpp"
 #include "binancerj/telemetry/PerfTelemetry.hpp"
 
 #include <boost/asio/connect.hpp>
@@ -30,15 +31,12 @@ using websocket_stream = boost::beast::websocket::stream<ssl_stream>;
 
 struct AsyncWebSocketHub::Impl {
     boost::asio::io_context ioContext;
-    boost::asio::ssl::context sslContext{boost::asio::ssl::context::tlsv12_client};
+    boost::asio::ssl::context& sslContext{TlsContextFactory::instance().client()};
     std::unique_ptr<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> workGuard;
     std::vector<std::thread> ioThreads;
     std::atomic<std::uint32_t> subscriptionId{1};
 
-    Impl() {
-        sslContext.set_default_verify_paths();
-        sslContext.set_verify_mode(boost::asio::ssl::verify_peer);
-    }
+    Impl() = default;
 };
 
 class AsyncWebSocketHub::Session : public std::enable_shared_from_this<AsyncWebSocketHub::Session> {
@@ -110,6 +108,7 @@ private:
             return;
         }
         auto self = shared_from_this();
+        TlsContextFactory::instance().prepare(ws_.next_layer().native_handle(), host_);
         ws_.next_layer().async_handshake(boost::asio::ssl::stream_base::client,
             [self](const boost::system::error_code& handshakeEc) {
                 self->onSslHandshake(handshakeEc);
@@ -118,9 +117,11 @@ private:
 
     void onSslHandshake(const boost::system::error_code& ec) {
         if (ec) {
+            TlsContextFactory::instance().forget(host_);
             fail("ssl_handshake", ec);
             return;
         }
+        TlsContextFactory::instance().handshakeDone(ws_.next_layer().native_handle());
         auto self = shared_from_this();
         ws_.async_handshake(host_, "/ws",
             [self](const boost::system::error_code& hsEc) {
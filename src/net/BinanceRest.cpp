@@ -1,17 +1,27 @@
 #include "binancerj/net/BinanceRest.hpp"
+#include "binancerj/net/ClockSync.hpp"
+#include "binancerj/net/Endpoints.hpp"
+#include "binancerj/net/RateLimitGovernor.hpp"
+#include "binancerj/net/RequestSigner.hpp"
+#include "binancerj/net/ResponseCache.hpp"
+#include "binancerj/net/TlsContext.hpp"
 #include "binancerj/telemetry/PerfTelemetry.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/asio/ssl.hpp>
 #include <boost/beast.hpp>
 #include <boost/beast/ssl.hpp>
-#include <openssl/hmac.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <chrono>
-#include <sstream>
-#include <iomanip>
 #include <cstdlib>
 #include <cctype>
-#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using tcp = boost::asio::ip::tcp;
 namespace ssl = boost::asio::ssl;
@@ -19,14 +29,18 @@ namespace beast = boost::beast;
 namespace http = beast::http;
 
 static std::string url_encode(const std::string& s) {
-    std::ostringstream oss;
+    static const char* hex = "0123456789ABCDEF";
+    std::string out;
+    out.reserve(s.size() * 3);
     for (unsigned char c : s) {
-        if (std::isalnum(c) || c=='-'||c=='_'||c=='.'||c=='~') oss << c;
+        if (std::isalnum(c) || c=='-'||c=='_'||c=='.'||c=='~') out.push_back(static_cast<char>(c));
         else {
-            oss << '%' << std::uppercase << std::hex << std::setw(2) << std::setfill('0') << (int)c << std::nouppercase << std::dec;
+            out.push_back('%');
+            out.push_back(hex[c >> 4]);
+            out.push_back(hex[c & 0x0F]);
         }
     }
-    return oss.str();
+    return out;
 }
 
 static std::string trim_quotes_ws(std::string v) {
@@ -42,14 +56,204 @@ static std::string trim_quotes_ws(std::string v) {
     return v;
 }
 
+namespace {
+
+constexpr auto kIdleTimeout = std::chrono::seconds(30);  // drop pooled connections idle longer than this
+constexpr auto kIoTimeout = std::chrono::seconds(10);    // per connect/handshake/write/read on a blocking connection
+constexpr auto kJoinTimeout = 2 * kIoTimeout;            // a blocking read joined to an identical one in flight
+constexpr std::size_t kMaxIdlePerHost = 8;
+
+using TlsStream = beast::ssl_stream<beast::tcp_stream>;
+
+using Governor = binancerj::net::RateLimitGovernor;
+using Cache = binancerj::net::ResponseCache;
+
+// One prepared HTTP call; shared by the blocking and async paths.
+struct Call {
+    std::string method;
+    std::string target;
+    std::string body;
+    bool isPost{false};
+    std::string apiKey;
+    Governor::Classified cost{Governor::Priority::Market, 1, 0};
+    std::string cacheKey;                    // cacheable reads only
+    std::chrono::milliseconds cacheTtl{-1};
+    std::string invalidates;                 // cache scope a signed write makes stale
+};
+
+Call make_call(std::string method, std::string target, bool isPost, std::string apiKey) {
+    Call call;
+    call.method = std::move(method);
+    call.target = std::move(target);
+    call.isPost = isPost;
+    call.apiKey = std::move(apiKey);
+    call.cost = Governor::classify(call.method, call.target);
+    return call;
+}
+
+// An idle connection must have nothing to read: pending bytes mean close_notify or FIN.
+bool idle_connection_healthy(TlsStream& stream) {
+    auto& sock = beast::get_lowest_layer(stream).socket();
+    if (!sock.is_open()) return false;
+    boost::system::error_code ec, ignored;
+    sock.non_blocking(true, ec);
+    if (ec) return false;
+    char probe = 0;
+    sock.receive(boost::asio::buffer(&probe, 1), tcp::socket::message_peek, ec);
+    sock.non_blocking(false, ignored);
+    return ec == boost::asio::error::would_block;
+}
+
+http::request<http::string_body> make_request(const std::string& host, const Call& call) {
+    http::request<http::string_body> req;
+    // Select HTTP verb based on 'method' argument
+    http::verb verb = http::verb::get;
+    if (call.method == "GET") verb = http::verb::get;
+    else if (call.method == "POST") verb = http::verb::post;
+    else if (call.method == "DELETE") verb = http::verb::delete_;
+    else if (call.method == "PUT") verb = http::verb::put;
+    req.method(verb);
+    req.target(call.target);
+    req.version(11);
+    req.keep_alive(true);
+    req.set(http::field::host, host);
+    req.set(http::field::user_agent, "BinanceRJTech/1.0");
+    req.set(http::field::accept, "application/json");
+    if (!call.apiKey.empty()) req.set("X-MBX-APIKEY", call.apiKey);
+    if (call.isPost) {
+        req.set(http::field::content_type, "application/x-www-form-urlencoded");
+        req.body() = call.body;
+        req.content_length(req.body().size());
+    }
+    return req;
+}
+
+void fill_result(BinanceRest::Result& r, http::response<http::string_body>& res) {
+    r.ok = (res.result_int() >= 200 && res.result_int() < 300);
+    r.status = res.result_int();
+    auto header_int = [&res](const char* name, int fallback) {
+        auto it = res.find(name);
+        if (it == res.end()) return fallback;
+        try { return std::stoi(std::string(it->value())); } catch (...) { return fallback; }
+    };
+    r.usedWeight1m = header_int("X-MBX-USED-WEIGHT-1M", -1);
+    r.orderCount10s = header_int("X-MBX-ORDER-COUNT-10S", -1);
+    r.orderCount1m = header_int("X-MBX-ORDER-COUNT-1M", -1);
+    r.retryAfterSec = header_int("Retry-After", 0);
+    Governor::instance().onResponse(r.status, r.usedWeight1m, r.orderCount10s, r.orderCount1m, r.retryAfterSec);
+    r.body = std::move(res.body());
+    if (r.usedWeight1m >= 0) telemetry::logGauge("rest", "used_weight_1m", static_cast<double>(r.usedWeight1m));
+    telemetry::logGauge("rest", "status_code", static_cast<double>(r.status));
+    telemetry::logGauge("rest", "payload_bytes", static_cast<double>(r.body.size()));
+}
+
+BinanceRest::Result failed_result(int status, const std::string& why) {
+    BinanceRest::Result r;
+    r.ok = false;
+    r.status = status;
+    r.body = why;
+    return r;
+}
+
+// A call that failed on a reused keep-alive connection may be retried once on a fresh one:
+// always when the request was never fully written, otherwise only when it is a GET. A written
+// POST/PUT/DELETE may already have reached the exchange and must not be sent twice.
+bool may_retry_stale(const Call& call, bool reused, int attempt, bool written) {
+    return reused && attempt == 0 && (!written || call.method == "GET");
+}
+
+// After a call went out: ends its cache flight, or makes its account's cached reads stale.
+void settle_cache(const Call& call, const BinanceRest::Result& r) {
+    if (!call.cacheKey.empty()) Cache::instance().complete(call.cacheKey, call.cacheTtl, r);
+    if (!call.invalidates.empty()) Cache::instance().invalidate(call.invalidates);
+}
+
+// One keep-alive TLS connection for the blocking path. Owns its io_context, which the calling
+// thread runs for each operation: the stream's expiry only bounds async operations, so every
+// connect/handshake/write/read is started async and awaited with run(). The TLS context is the
+// process-wide one from TlsContextFactory.
+struct PooledConnection {
+    boost::asio::io_context ioc;
+    std::unique_ptr<TlsStream> stream;
+    std::chrono::steady_clock::time_point lastUsed{};
+    int served{0};
+
+    // Runs the operation just started on stream until it completes or kIoTimeout passes (the
+    // stream then closes its socket and the operation fails with beast::error::timeout).
+    template <typename Start>
+    void await(Start&& start) {
+        beast::error_code ec;
+        beast::get_lowest_layer(*stream).expires_after(kIoTimeout);
+        start([&ec](const beast::error_code& e, auto&&...) { ec = e; });
+        ioc.restart();
+        ioc.run();
+        beast::get_lowest_layer(*stream).expires_never();
+        if (ec) throw beast::system_error(ec);
+    }
+};
+
+// Keep-alive connection bound to a client's async io_context.
+struct AsyncConnection {
+    std::unique_ptr<TlsStream> stream;
+    std::chrono::steady_clock::time_point lastUsed{};
+};
+
+// Idle keep-alive connections shared by every BinanceRest in the process, keyed by host.
+class ConnectionPool {
+public:
+    static ConnectionPool& instance() {
+        static ConnectionPool pool;
+        return pool;
+    }
+
+    // Most recently used healthy idle connection for key, or null when a new one is needed.
+    std::unique_ptr<PooledConnection> acquire(const std::string& key) {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& idle = idle_[key];
+        idle.erase(std::remove_if(idle.begin(), idle.end(), [now](const std::unique_ptr<PooledConnection>& c) {
+            return now - c->lastUsed > kIdleTimeout;
+        }), idle.end());
+        while (!idle.empty()) {
+            std::unique_ptr<PooledConnection> conn = std::move(idle.back());
+            idle.pop_back();
+            if (idle_connection_healthy(*conn->stream)) return conn;
+            telemetry::logCounter("rest", "conn_stale", 1);
+        }
+        return nullptr;
+    }
+
+    void release(const std::string& key, std::unique_ptr<PooledConnection> conn) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& idle = idle_[key];
+        if (idle.size() < kMaxIdlePerHost) idle.push_back(std::move(conn));
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, std::vector<std::unique_ptr<PooledConnection>>> idle_;
+};
+
+} // namespace
+
 struct BinanceRest::Impl {
-    std::string host;
+    std::string host;      // "host[:port]" as given: Host header, pool and cache key
+    std::string hostName;  // DNS name / SNI
+    std::string port;
     std::string apiKey;
-    std::string apiSecret;
-    long long timeOffsetMs{0};
+    binancerj::net::RequestSigner signer;  // keyed with the API secret
     bool insecureTLS{false};
 
+    // Async side: one I/O thread per client, started on first async call. asyncIdle is only
+    // touched from that thread.
+    boost::asio::io_context io;
+    std::unique_ptr<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> ioWork;
+    std::thread ioThread;
+    std::once_flag ioStarted;
+    std::vector<std::unique_ptr<AsyncConnection>> asyncIdle;
+
     Impl(const std::string& h) : host(h) {
+        binancerj::net::splitHostPort(host, hostName, port);
         auto get_env = [](const char* name)->std::string {
 #ifdef _WIN32
             size_t len = 0; char* buf = nullptr;
@@ -63,274 +267,735 @@ struct BinanceRest::Impl {
         std::string k = trim_quotes_ws(get_env("BINANCE_API_KEY"));
         std::string s = trim_quotes_ws(get_env("BINANCE_API_SECRET"));
         if (!k.empty()) apiKey = std::move(k);
-        if (!s.empty()) apiSecret = std::move(s);
+        signer.setSecret(s);
     }
 
-    std::string hmac_sha256_hex(const std::string& data) {
-        unsigned char md[EVP_MAX_MD_SIZE]; unsigned int md_len = 0;
-        HMAC(EVP_sha256(), apiSecret.data(), (int)apiSecret.size(), (const unsigned char*)data.data(), data.size(), md, &md_len);
-        std::ostringstream oss;
-        for (unsigned int i=0;i<md_len;++i) oss << std::hex << std::setw(2) << std::setfill('0') << (int)md[i];
-        return oss.str();
+    ~Impl() {
+        if (ioThread.joinable()) {
+            // Calls still in flight are abandoned; their futures resolve to status -2.
+            ioWork.reset();
+            io.stop();
+            ioThread.join();
+        }
     }
 
-    void try_load_ca(ssl::context& ctx) {
-        // Try environment overrides first
-        auto get_env = [](const char* name)->std::string {
-#ifdef _WIN32
-            size_t len = 0; char* buf = nullptr;
-            if (_dupenv_s(&buf, &len, name) == 0 && buf) { std::string v(buf); free(buf); return v; }
-            return {};
-#else
-            const char* v = std::getenv(name);
-            return v ? std::string(v) : std::string();
-#endif
-        };
-        std::string cafile = get_env("SSL_CERT_FILE");
-        if (cafile.empty()) cafile = get_env("CURL_CA_BUNDLE");
-        if (!cafile.empty()) {
-            SSL_CTX_load_verify_locations(ctx.native_handle(), cafile.c_str(), nullptr);
-            return;
+    // Exchange time for request timestamps (local clock until ClockSync has a sample, and for
+    // hosts other than the one ClockSync samples).
+    long long now_ms() const {
+        return binancerj::net::ClockSync::instance().serverTimeMsFor(host);
+    }
+
+    // Unsigned GET
+    Call public_call(const std::string& target) const {
+        Call call = make_call("GET", target, false, {});
+        const std::size_t q = target.find('?');
+        const std::string path = target.substr(0, q);
+        call.cacheTtl = Cache::ttlFor(path);
+        if (call.cacheTtl.count() >= 0) {
+            call.cacheKey = Cache::makeKey(host, path, q == std::string::npos ? std::string() : target.substr(q + 1));
         }
-        // Try common local files
-        namespace fs = std::filesystem;
-        const char* guesses[] = {
-            "cacert.pem",
-            "cert\\cacert.pem",
-            "certs\\cacert.pem",
-            "C:\\Program Files\\OpenSSL-Win64\\certs\\cacert.pem",
-            "C:\\Program Files\\Git\\mingw64\\ssl\\certs\\ca-bundle.crt",
-        };
-        for (auto p : guesses) {
-            if (fs::exists(p)) {
-                SSL_CTX_load_verify_locations(ctx.native_handle(), p, nullptr);
-                break;
-            }
+        return call;
+    }
+
+    // Cache scope of this client's account.
+    std::string account_scope() const {
+        return host + "#" + apiKey;
+    }
+
+    // API key header only, no timestamp/signature (listenKey management)
+    Call key_call(const std::string& method, const std::string& path) const {
+        return make_call(method, path, method == "POST", apiKey);
+    }
+
+    // Appends timestamp + signature to params; parameters travel in the query string only
+    // (avoid duplicating in body to prevent signature mismatches)
+    Call signed_call(const std::string& method, const std::string& path, const std::string& params) {
+        binancerj::net::QueryBuilder q;
+        q.reserve(path.size() + params.size() + 112);
+        std::string& target = q.buffer();
+        target.append(path).append(1, '?');
+        // Everything after '?' is what gets signed.
+        const std::size_t signedFrom = target.size();
+        target.append(params);
+        q.add("timestamp", now_ms());
+        char hex[binancerj::net::RequestSigner::kHexLength];
+        signer.sign(std::string_view(target).substr(signedFrom), hex);
+        q.add("signature", std::string_view(hex, sizeof(hex)));
+        Call call = make_call(method, std::move(target), method == "POST", apiKey);
+        if (method == "GET") {
+            call.cacheTtl = Cache::ttlFor(path);
+            if (call.cacheTtl.count() >= 0) call.cacheKey = Cache::makeKey(account_scope(), path, params);
+        } else {
+            call.invalidates = account_scope();
         }
+        return call;
     }
 
-    Result https_request(const std::string& method, const std::string& target, const std::string& bodyOrQuery, bool isPost, const std::string& apiKeyHdr) {
-        Result r;
-        telemetry::logEvent("rest", "call method=" + method + " target=" + target);
-        telemetry::ScopedTimer timer("rest", method + ":" + target);
-        try {
-            boost::asio::io_context ioc;
-            ssl::context ctx(ssl::context::tlsv12_client);
-            ctx.set_default_verify_paths();
-            if (insecureTLS) ctx.set_verify_mode(ssl::verify_none);
-            else {
-                ctx.set_verify_mode(ssl::verify_peer);
-                try_load_ca(ctx);
-            }
+    // Fresh TLS connection to host:port (resolve, connect, handshake). The shared context
+    // offers a cached session, so reconnects usually skip the full handshake.
+    std::unique_ptr<PooledConnection> connect() {
+        auto& tls = binancerj::net::TlsContextFactory::instance();
+        auto conn = std::make_unique<PooledConnection>();
+
+        tcp::resolver resolver(conn->ioc);
+        auto const results = resolver.resolve(hostName, port);
+
+        conn->stream = std::make_unique<TlsStream>(conn->ioc, tls.client(!insecureTLS));
+        tls.prepare(conn->stream->native_handle(), hostName);
 
-            tcp::resolver resolver(ioc);
-            auto const results = resolver.resolve(host, "443");
+        auto& stream = *conn->stream;
+        conn->await([&](auto handler) { beast::get_lowest_layer(stream).async_connect(results, handler); });
+        try {
+            conn->await([&](auto handler) { stream.async_handshake(ssl::stream_base::client, handler); });
+        } catch (...) {
+            tls.forget(hostName);
+            throw;
+        }
+        tls.handshakeDone(conn->stream->native_handle());
+        telemetry::logCounter("rest", "conn_new", 1);
+        return conn;
+    }
 
-            beast::ssl_stream<beast::tcp_stream> stream(ioc, ctx);
-            if(! SSL_set_tlsext_host_name(stream.native_handle(), host.c_str()))
-            {
-                beast::error_code ec(static_cast<int>(::ERR_get_error()), boost::asio::error::get_ssl_category());
-                throw beast::system_error(ec, "Failed to set SNI");
+    // Blocking admission: sleeps through governor delays; false (with r filled) when shed.
+    static bool admit_blocking(const Call& call, Result& r) {
+        int waitedMs = 0;
+        for (;;) {
+            const auto d = Governor::instance().admit(call.cost, waitedMs);
+            if (d.kind == Governor::Decision::Admit) return true;
+            if (d.kind == Governor::Decision::Shed) {
+                r = failed_result(-3, std::string("Rate limit: ") + d.reason);
+                telemetry::logEvent("rest", "shed method=" + call.method + " target=" + call.target + " reason=" + d.reason);
+                return false;
             }
+            std::this_thread::sleep_for(std::chrono::milliseconds(d.delayMs));
+            waitedMs += d.delayMs;
+        }
+    }
 
-            beast::get_lowest_layer(stream).connect(results);
-            stream.handshake(ssl::stream_base::client);
-
-            http::request<http::string_body> req;
-            // Select HTTP verb based on 'method' argument
-            http::verb verb = http::verb::get;
-            if (method == "GET") verb = http::verb::get;
-            else if (method == "POST") verb = http::verb::post;
-            else if (method == "DELETE") verb = http::verb::delete_;
-            else if (method == "PUT") verb = http::verb::put;
-            req.method(verb);
-            req.target(target);
-            req.version(11);
-            req.set(http::field::host, host);
-            req.set(http::field::user_agent, "BinanceRJTech/1.0");
-            req.set(http::field::accept, "application/json");
-            if (!apiKeyHdr.empty()) req.set("X-MBX-APIKEY", apiKeyHdr);
-            if (isPost) {
-                req.set(http::field::content_type, "application/x-www-form-urlencoded");
-                req.body() = bodyOrQuery;
-                req.content_length(req.body().size());
+    // Serves cacheable reads from ResponseCache (or waits for an identical call in flight),
+    // sends everything else.
+    Result run(const Call& call) {
+        if (!call.cacheKey.empty()) {
+            Result cached;
+            std::uint64_t ticket = 0;
+            auto joined = std::make_shared<std::promise<std::pair<Result, bool>>>();
+            auto shared = joined->get_future();
+            const auto lookup = Cache::instance().acquire(call.cacheKey, cached,
+                [joined](const Result& r, bool lead) { joined->set_value({r, lead}); }, &ticket);
+            if (lookup == Cache::Lookup::Hit) return cached;
+            if (lookup == Cache::Lookup::Joined) {
+                if (shared.wait_for(kJoinTimeout) == std::future_status::timeout && Cache::instance().leave(call.cacheKey, ticket)) {
+                    return failed_result(-1, "HTTPS error: timeout waiting for an identical call");
+                }
+                auto [r, lead] = shared.get();
+                if (!lead) return r;
+                // The lead gave up: this call fetches for the flight
             }
+        }
+        Result r = send(call);
+        settle_cache(call, r);
+        return r;
+    }
 
-            http::write(stream, req);
-
-            beast::flat_buffer buffer;
-            http::response<http::string_body> res;
-            http::read(stream, buffer, res);
-
-            beast::error_code ec;
-            stream.shutdown(ec);
-
-            r.ok = (res.result_int() >= 200 && res.result_int() < 300);
-            r.status = res.result_int();
-            r.body = std::move(res.body());
-            telemetry::logGauge("rest", "status_code", static_cast<double>(r.status));
-            telemetry::logGauge("rest", "payload_bytes", static_cast<double>(r.body.size()));
-        } catch (const std::exception& ex) {
-            r.ok = false;
-            r.status = -1;
-            r.body = std::string("HTTPS error: ") + ex.what();
-            telemetry::logEvent("rest", std::string("error method=") + method + " target=" + target + " msg=" + ex.what());
+    Result send(const Call& call) {
+        Result r;
+        if (!admit_blocking(call, r)) return r;
+        telemetry::logEvent("rest", "call method=" + call.method + " target=" + call.target);
+        telemetry::ScopedTimer timer("rest", call.method + ":" + call.target);
+        const http::request<http::string_body> req = make_request(host, call);
+
+        auto& pool = ConnectionPool::instance();
+        const std::string poolKey = insecureTLS ? host + "#insecure" : host;
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            std::unique_ptr<PooledConnection> conn = pool.acquire(poolKey);
+            const bool reused = conn != nullptr;
+            bool written = false;
+            try {
+                if (!conn) conn = connect();
+                else telemetry::logCounter("rest", "conn_reused", 1);
+                auto& stream = *conn->stream;
+
+                conn->await([&](auto handler) { http::async_write(stream, req, handler); });
+                written = true;
+
+                beast::flat_buffer buffer;
+                http::response<http::string_body> res;
+                conn->await([&](auto handler) { http::async_read(stream, buffer, res, handler); });
+
+                const bool keepAlive = res.keep_alive();
+                fill_result(r, res);
+
+                // Server asked to close (Connection: close): drop it, the next call reconnects
+                conn->lastUsed = std::chrono::steady_clock::now();
+                ++conn->served;
+                if (keepAlive) pool.release(poolKey, std::move(conn));
+                return r;
+            } catch (const std::exception& ex) {
+                // A reused connection can die while idle: retry once on a fresh connection
+                if (may_retry_stale(call, reused, attempt, written)) {
+                    telemetry::logCounter("rest", "conn_retry", 1);
+                    continue;
+                }
+                r = failed_result(-1, std::string("HTTPS error: ") + ex.what());
+                telemetry::logEvent("rest", std::string("error method=") + call.method + " target=" + call.target + " msg=" + ex.what());
+                return r;
+            }
         }
         return r;
     }
+
+    AsyncRequest run_async(Call call, AsyncOptions options);
+
+    std::unique_ptr<AsyncConnection> take_idle_async() {
+        const auto now = std::chrono::steady_clock::now();
+        while (!asyncIdle.empty()) {
+            std::unique_ptr<AsyncConnection> conn = std::move(asyncIdle.back());
+            asyncIdle.pop_back();
+            if (now - conn->lastUsed <= kIdleTimeout && idle_connection_healthy(*conn->stream)) return conn;
+            telemetry::logCounter("rest", "conn_stale", 1);
+        }
+        return nullptr;
+    }
+
+    void release_async(std::unique_ptr<AsyncConnection> conn) {
+        conn->lastUsed = std::chrono::steady_clock::now();
+        if (asyncIdle.size() < kMaxIdlePerHost) asyncIdle.push_back(std::move(conn));
+    }
+};
+
+// One async call: resolve/connect/handshake (or a pooled connection), write, read, all on the
+// client's I/O thread. A deadline timer bounds the whole call; cancel() and the deadline close
+// the socket so outstanding operations finish with operation_aborted. A cacheable read that
+// joined an identical call in flight waits under the same deadline and completes on this
+// client's I/O thread too; when that call's lead gives up, this op takes the fetch over.
+struct BinanceRest::AsyncOp : std::enable_shared_from_this<BinanceRest::AsyncOp> {
+    Impl& impl;
+    Call call;
+    http::request<http::string_body> req;
+    std::promise<Result> promise;
+    std::function<void(const Result&)> onComplete;
+    std::function<void()> onWritten;
+    int timeoutMs;
+    boost::asio::steady_timer deadline;
+    boost::asio::steady_timer gate;  // governor delays
+    int gateWaitedMs{0};
+    tcp::resolver resolver;
+    std::unique_ptr<AsyncConnection> conn;
+    beast::flat_buffer buffer;
+    http::response<http::string_body> res;
+    std::chrono::steady_clock::time_point started{};
+    bool reused{false};
+    bool written{false};
+    bool done{false};
+    int attempt{0};
+    bool leads{true};                     // sends itself and ends the cache flight, if any
+    std::uint64_t ticket{0};              // joined: waiter ticket in the flight
+    std::atomic<bool> handedLead{false};  // joined: the flight was handed over and not yet taken
+
+    AsyncOp(Impl& owner, Call c, AsyncOptions options)
+        : impl(owner),
+          call(std::move(c)),
+          req(make_request(owner.host, call)),
+          onComplete(std::move(options.onComplete)),
+          onWritten(std::move(options.onWritten)),
+          timeoutMs(options.timeoutMs > 0 ? options.timeoutMs : 10000),
+          deadline(owner.io),
+          gate(owner.io),
+          resolver(owner.io),
+          started(std::chrono::steady_clock::now()) {}
+
+    ~AsyncOp() {
+        const Result r = failed_result(-2, "HTTPS error: cancelled");
+        if (!done) {
+            settle(r);
+            promise.set_value(r);
+        } else if (handedLead.exchange(false)) {
+            settle_cache(call, r);  // handed the flight after finishing: pass it on
+        }
+    }
+
+    void start() {
+        if (done) return;
+        auto self = shared_from_this();
+        telemetry::logEvent("rest", std::string(ticket ? "async join" : "async call") + " method=" + call.method + " target=" + call.target);
+        deadline.expires_after(std::chrono::milliseconds(timeoutMs));
+        deadline.async_wait([self](const boost::system::error_code& ec) {
+            if (!ec) self->abort(-1, "HTTPS error: timeout");
+        });
+        if (ticket == 0) admit();
+    }
+
+    // Joined: the shared call ended with r, or its lead gave up and the flight is ours.
+    void joined(const Result& r, bool lead) {
+        if (!lead) return complete(r);
+        if (!handedLead.exchange(false)) return;  // settle() already passed it on
+        if (done) {
+            settle_cache(call, failed_result(-2, "HTTPS error: cancelled"));
+            return;
+        }
+        leads = true;
+        admit();
+    }
+
+    // Ends the cache flight this op leads; a joined op leaves its flight (and passes it on if
+    // it was handed over meanwhile). Hits have nothing to settle.
+    void settle(const Result& r) {
+        if (leads) {
+            settle_cache(call, r);
+        } else if (ticket != 0 && !Cache::instance().leave(call.cacheKey, ticket) && handedLead.exchange(false)) {
+            settle_cache(call, r);
+        }
+    }
+
+    // Governor delays wait on a timer so other calls on the I/O thread keep moving.
+    void admit() {
+        if (done) return;
+        const auto d = Governor::instance().admit(call.cost, gateWaitedMs);
+        if (d.kind == Governor::Decision::Shed) {
+            telemetry::logEvent("rest", "shed method=" + call.method + " target=" + call.target + " reason=" + d.reason);
+            complete(failed_result(-3, std::string("Rate limit: ") + d.reason));
+            return;
+        }
+        if (d.kind == Governor::Decision::Delay) {
+            auto self = shared_from_this();
+            gateWaitedMs += d.delayMs;
+            gate.expires_after(std::chrono::milliseconds(d.delayMs));
+            gate.async_wait([self](const boost::system::error_code& ec) {
+                if (!ec) self->admit();
+            });
+            return;
+        }
+        conn = impl.take_idle_async();
+        reused = conn != nullptr;
+        if (reused) {
+            telemetry::logCounter("rest", "conn_reused", 1);
+            send();
+        } else {
+            connect();
+        }
+    }
+
+    void connect() {
+        auto self = shared_from_this();
+        auto& tls = binancerj::net::TlsContextFactory::instance();
+        conn = std::make_unique<AsyncConnection>();
+        conn->stream = std::make_unique<TlsStream>(impl.io, tls.client(!impl.insecureTLS));
+        tls.prepare(conn->stream->native_handle(), impl.hostName);
+        resolver.async_resolve(impl.hostName, impl.port, [self](const beast::error_code& ec, tcp::resolver::results_type results) {
+            if (self->done) return;
+            if (ec) return self->fail("resolve", ec);
+            beast::get_lowest_layer(*self->conn->stream).async_connect(results,
+                [self](const beast::error_code& connEc, const tcp::endpoint&) {
+                    if (self->done) return;
+                    if (connEc) return self->fail("connect", connEc);
+                    self->conn->stream->async_handshake(ssl::stream_base::client, [self](const beast::error_code& hsEc) {
+                        if (self->done) return;
+                        auto& tls = binancerj::net::TlsContextFactory::instance();
+                        if (hsEc) {
+                            tls.forget(self->impl.hostName);
+                            return self->fail("handshake", hsEc);
+                        }
+                        tls.handshakeDone(self->conn->stream->native_handle());
+                        telemetry::logCounter("rest", "conn_new", 1);
+                        self->send();
+                    });
+                });
+        });
+    }
+
+    void send() {
+        auto self = shared_from_this();
+        written = false;
+        http::async_write(*conn->stream, req, [self](const beast::error_code& ec, std::size_t) {
+            if (self->done) return;
+            if (ec) return self->fail("write", ec);
+            self->written = true;
+            self->buffer.clear();
+            self->res = {};
+            http::async_read(*self->conn->stream, self->buffer, self->res, [self](const beast::error_code& readEc, std::size_t) {
+                if (self->done) return;
+                if (readEc) return self->fail("read", readEc);
+                self->finish();
+            });
+            if (self->onWritten) self->onWritten();
+        });
+    }
+
+    void finish() {
+        Result r;
+        const bool keepAlive = res.keep_alive();
+        fill_result(r, res);
+        if (keepAlive) impl.release_async(std::move(conn));
+        complete(std::move(r));
+    }
+
+    void fail(const char* stage, const beast::error_code& ec) {
+        // Same rule as the blocking path: one retry on a fresh connection after a stale reuse
+        if (may_retry_stale(call, reused, attempt, written)) {
+            telemetry::logCounter("rest", "conn_retry", 1);
+            attempt = 1;
+            reused = false;
+            conn.reset();
+            connect();
+            return;
+        }
+        telemetry::logEvent("rest", std::string("error method=") + call.method + " target=" + call.target + " stage=" + stage + " msg=" + ec.message());
+        complete(failed_result(-1, std::string("HTTPS error: ") + stage + ": " + ec.message()));
+    }
+
+    void abort(int status, const std::string& why) {
+        if (done) return;
+        boost::system::error_code ignored;
+        resolver.cancel();
+        if (conn) beast::get_lowest_layer(*conn->stream).socket().close(ignored);
+        complete(failed_result(status, why));
+    }
+
+    void complete(Result r) {
+        if (done) return;
+        done = true;
+        deadline.cancel();
+        gate.cancel();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        telemetry::logGauge("rest", "async_ms", ms);
+        settle(r);
+        // Outstanding handlers keep this op (and conn) alive until they drain
+        if (onComplete) {
+            try { onComplete(r); } catch (...) {}
+        }
+        promise.set_value(std::move(r));
+    }
 };
 
+BinanceRest::AsyncRequest BinanceRest::Impl::run_async(Call call, AsyncOptions options) {
+    std::call_once(ioStarted, [this]() {
+        ioWork = std::make_unique<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>(io.get_executor());
+        ioThread = std::thread([this]() { io.run(); });
+    });
+    if (options.onSigned) options.onSigned();  // signed by the endpoint; the I/O thread cannot have written yet
+    auto op = std::make_shared<AsyncOp>(*this, std::move(call), std::move(options));
+    AsyncRequest handle;
+    handle.result = op->promise.get_future();
+    handle.op_ = op;
+    if (!op->call.cacheKey.empty()) {
+        // Hits and joined calls complete on this client's I/O thread like any other; the waiter
+        // only holds the op weakly, so a joined op that gave up is not kept alive by the flight.
+        op->leads = false;
+        Result cached;
+        std::weak_ptr<AsyncOp> weak = op;
+        auto waiter = [weak, key = op->call.cacheKey, ttl = op->call.cacheTtl](const Result& r, bool lead) {
+            auto joiner = weak.lock();
+            if (!joiner) {
+                if (lead) Cache::instance().complete(key, ttl, failed_result(-2, "HTTPS error: cancelled"));
+                return;
+            }
+            if (lead) joiner->handedLead = true;
+            boost::asio::post(joiner->impl.io, [joiner, r, lead]() { joiner->joined(r, lead); });
+        };
+        const auto lookup = Cache::instance().acquire(op->call.cacheKey, cached, std::move(waiter), &op->ticket);
+        if (lookup == Cache::Lookup::Hit) {
+            boost::asio::post(io, [op, cached = std::move(cached)]() { op->complete(cached); });
+            return handle;
+        }
+        // Lead: the op ends the flight when it completes. Joined: it waits under its own deadline.
+        if (lookup == Cache::Lookup::Lead) op->leads = true;
+    }
+    boost::asio::post(io, [op]() { op->start(); });
+    return handle;
+}
+
+void BinanceRest::AsyncRequest::cancel() const {
+    if (auto op = op_.lock()) {
+        boost::asio::post(op->impl.io, [op]() { op->abort(-2, "HTTPS error: cancelled"); });
+    }
+}
+
 BinanceRest::BinanceRest(const std::string& baseHost) : impl_(new Impl(baseHost)) {}
 BinanceRest::~BinanceRest() = default;
 
 void BinanceRest::setCredentials(const std::string& apiKey, const std::string& apiSecret) {
     impl_->apiKey = apiKey;
-    impl_->apiSecret = apiSecret;
-}
-
-BinanceRest::Result BinanceRest::getServerTime() {
-    std::string target = "/fapi/v1/time";
-    return impl_->https_request("GET", target, {}, false, {});
+    impl_->signer.setSecret(apiSecret);
 }
 
 void BinanceRest::setInsecureTLS(bool v) {
     impl_->insecureTLS = v;
 }
 
+// ---- Endpoint parameters (shared by blocking and async forms) ----
+
+static std::string klines_target(const std::string& symbol, const std::string& interval, long long startTime, long long endTime, int limit) {
+    binancerj::net::QueryBuilder q;
+    q.reserve(96);
+    q.buffer() = "/fapi/v1/klines?";
+    q.add("symbol", symbol).add("interval", interval);
+    if (startTime > 0) q.add("startTime", startTime);
+    if (endTime > 0)   q.add("endTime", endTime);
+    if (limit > 0)     q.add("limit", limit);
+    return std::move(q.buffer());
+}
+
+static std::string depth_target(const std::string& symbol, int limit) {
+    binancerj::net::QueryBuilder q;
+    q.buffer() = "/fapi/v1/depth?";
+    q.add("symbol", symbol);
+    if (limit > 0) q.add("limit", limit);
+    return std::move(q.buffer());
+}
+
+static std::string exchange_info_target(const std::string& symbol) {
+    return symbol.empty() ? std::string("/fapi/v1/exchangeInfo") : "/fapi/v1/exchangeInfo?symbol=" + symbol;
+}
+
+static std::string open_orders_params(const std::string& symbol, int recvWindowMs) {
+    binancerj::net::QueryBuilder q;
+    if (!symbol.empty()) q.add("symbol", symbol);
+    q.add("recvWindow", recvWindowMs);
+    return std::move(q.buffer());
+}
+
+static std::string user_trades_params(const std::string& symbol, int limit, int recvWindowMs) {
+    binancerj::net::QueryBuilder q;
+    q.add("symbol", symbol);
+    if (limit > 0) q.add("limit", limit);
+    q.add("recvWindow", recvWindowMs);
+    return std::move(q.buffer());
+}
+
+static std::string cancel_order_params(const std::string& symbol, long long orderId, const std::string& origClientOrderId, int recvWindowMs) {
+    binancerj::net::QueryBuilder q;
+    q.add("symbol", symbol);
+    if (orderId > 0) q.add("orderId", orderId);
+    if (!origClientOrderId.empty()) q.add("origClientOrderId", url_encode(origClientOrderId));
+    q.add("recvWindow", recvWindowMs);
+    return std::move(q.buffer());
+}
+
+static std::string place_order_params(const std::string& symbol, const std::string& side, const std::string& type, double quantity, double price, const std::string& tif, bool reduceOnly, int recvWindowMs, const std::string& positionSide, double stopPrice, const std::string& workingType) {
+    binancerj::net::QueryBuilder q;
+    q.reserve(192);
+    q.add("symbol", symbol);
+    q.add("side", side);
+    q.add("type", type);
+    q.addFixed("quantity", quantity);
+    if (type == "LIMIT") {
+        q.addFixed("price", price);
+        q.add("timeInForce", tif);
+    }
+    if (type == "STOP_MARKET" || type == "TAKE_PROFIT_MARKET") {
+        if (stopPrice > 0) q.addFixed("stopPrice", stopPrice);
+        if (!workingType.empty()) q.add("workingType", workingType);
+    }
+    if (!positionSide.empty()) q.add("positionSide", positionSide);
+    if (reduceOnly) q.add("reduceOnly", "true");
+    q.add("recvWindow", recvWindowMs);
+    return std::move(q.buffer());
+}
+
+std::string BinanceRest::serializeOrder(const OrderRequest& o, int recvWindowMs) {
+    return place_order_params(o.symbol, o.side, o.type, o.quantity, o.price, o.timeInForce.empty() ? std::string("GTC") : o.timeInForce,
+                              o.reduceOnly, recvWindowMs, o.positionSide, o.stopPrice, o.workingType);
+}
+
+// place_order_params for an OrderRequest, plus its client order id.
+static std::string order_request_params(const BinanceRest::OrderRequest& o, int recvWindowMs) {
+    std::string params = BinanceRest::serializeOrder(o, recvWindowMs);
+    if (!o.newClientOrderId.empty()) params += "&newClientOrderId=" + url_encode(o.newClientOrderId);
+    return params;
+}
+
+static std::string modify_order_params(const std::string& symbol, long long orderId, const std::string& origClientOrderId, const std::string& side, double quantity, double price, int recvWindowMs) {
+    binancerj::net::QueryBuilder q;
+    q.reserve(160);
+    q.add("symbol", symbol);
+    if (orderId > 0) q.add("orderId", orderId);
+    if (!origClientOrderId.empty()) q.add("origClientOrderId", url_encode(origClientOrderId));
+    q.add("side", side);
+    q.addFixed("quantity", quantity);
+    q.addFixed("price", price);
+    q.add("recvWindow", recvWindowMs);
+    return std::move(q.buffer());
+}
+
+static std::string cancel_replace_params(const std::string& symbol, long long cancelOrderId, const std::string& side, const std::string& type, double quantity, double price, const std::string& timeInForce, bool reduceOnly, const std::string& positionSide, const std::string& cancelReplaceMode, int recvWindowMs) {
+    binancerj::net::QueryBuilder q;
+    q.reserve(224);
+    q.add("symbol", symbol);
+    q.add("cancelOrderId", cancelOrderId);
+    q.add("side", side);
+    q.add("type", type);
+    q.addFixed("quantity", quantity);
+    if (type == "LIMIT") {
+        q.addFixed("price", price);
+        q.add("timeInForce", timeInForce);
+    }
+    if (!positionSide.empty()) q.add("positionSide", positionSide);
+    if (reduceOnly) q.add("reduceOnly", "true");
+    q.add("cancelReplaceMode", cancelReplaceMode);
+    q.add("recvWindow", recvWindowMs);
+    return std::move(q.buffer());
+}
+
+// JSON array for batchOrders; every value is sent as a string, as the endpoint expects.
+static std::string batch_orders_params(const std::vector<BinanceRest::OrderRequest>& orders, int recvWindowMs) {
+    std::string json;
+    json.reserve(orders.size() * 192);
+    auto field = [&json](const char* key, const std::string& value) {
+        if (json.back() != '{') json += ',';
+        json += '"'; json += key; json += "\":\""; json += value; json += '"';
+    };
+    auto fixed = [](double v) {
+        char buf[64];
+        auto res = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::fixed, 8);
+        return res.ec == std::errc() ? std::string(buf, res.ptr) : std::string("0");
+    };
+    json += '[';
+    for (const auto& o : orders) {
+        if (json.size() > 1) json += ',';
+        json += '{';
+        field("symbol", o.symbol);
+        field("side", o.side);
+        field("type", o.type);
+        field("quantity", fixed(o.quantity));
+        if (o.type == "LIMIT") {
+            field("price", fixed(o.price));
+            field("timeInForce", o.timeInForce.empty() ? std::string("GTC") : o.timeInForce);
+        }
+        if (o.type == "STOP_MARKET" || o.type == "TAKE_PROFIT_MARKET") {
+            if (o.stopPrice > 0) field("stopPrice", fixed(o.stopPrice));
+            if (!o.workingType.empty()) field("workingType", o.workingType);
+        }
+        if (!o.positionSide.empty()) field("positionSide", o.positionSide);
+        if (o.reduceOnly) field("reduceOnly", "true");
+        if (!o.newClientOrderId.empty()) field("newClientOrderId", o.newClientOrderId);
+        json += '}';
+    }
+    json += ']';
+    binancerj::net::QueryBuilder q;
+    q.add("batchOrders", url_encode(json));
+    q.add("recvWindow", recvWindowMs);
+    return std::move(q.buffer());
+}
+
+static std::string batch_cancel_params(const std::string& symbol, const std::vector<long long>& orderIds, int recvWindowMs) {
+    std::string list = "[";
+    for (long long id : orderIds) {
+        if (list.size() > 1) list += ',';
+        list += std::to_string(id);
+    }
+    list += ']';
+    binancerj::net::QueryBuilder q;
+    q.add("symbol", symbol);
+    q.add("orderIdList", url_encode(list));
+    q.add("recvWindow", recvWindowMs);
+    return std::move(q.buffer());
+}
+
+static bool batch_size_ok(std::size_t count, std::size_t limit) {
+    return count > 0 && count <= limit;
+}
+
+static BinanceRest::AsyncRequest rejected_async(const std::string& why, BinanceRest::AsyncOptions& options) {
+    BinanceRest::Result r = failed_result(0, why);
+    if (options.onComplete) options.onComplete(r);
+    std::promise<BinanceRest::Result> promise;
+    BinanceRest::AsyncRequest req;
+    req.result = promise.get_future();
+    promise.set_value(std::move(r));
+    return req;
+}
+
+// ---- Blocking endpoints ----
+
+BinanceRest::Result BinanceRest::getServerTime() {
+    return impl_->run(impl_->public_call("/fapi/v1/time"));
+}
+
 BinanceRest::Result BinanceRest::getAccountInfo(int recvWindowMs) {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q;
-    q << "recvWindow=" << recvWindowMs << "&timestamp=" << ts;
-    std::string qs = q.str();
-    qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("GET", "/fapi/v2/account?" + qs, {}, false, impl_->apiKey);
+    return impl_->run(impl_->signed_call("GET", "/fapi/v2/account", "recvWindow=" + std::to_string(recvWindowMs)));
 }
 
 BinanceRest::Result BinanceRest::getExchangeInfo(const std::string& symbol) {
-    std::string target = "/fapi/v1/exchangeInfo?symbol=" + symbol;
-    return impl_->https_request("GET", target, {}, false, {});
+    return impl_->run(impl_->public_call(exchange_info_target(symbol)));
 }
 
 BinanceRest::Result BinanceRest::getKlines(const std::string& symbol, const std::string& interval, long long startTime, long long endTime, int limit) {
-    std::ostringstream q;
-    q << "/fapi/v1/klines?symbol=" << symbol << "&interval=" << interval;
-    if (startTime > 0) q << "&startTime=" << startTime;
-    if (endTime > 0)   q << "&endTime=" << endTime;
-    if (limit > 0)     q << "&limit=" << limit;
-    return impl_->https_request("GET", q.str(), {}, false, {});
+    return impl_->run(impl_->public_call(klines_target(symbol, interval, startTime, endTime, limit)));
 }
 
 BinanceRest::Result BinanceRest::getOpenOrders(const std::string& symbol, int recvWindowMs) {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q; q << "symbol=" << symbol << "&recvWindow=" << recvWindowMs << "&timestamp=" << ts;
-    std::string qs = q.str(); qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("GET", "/fapi/v1/openOrders?" + qs, {}, false, impl_->apiKey);
+    return impl_->run(impl_->signed_call("GET", "/fapi/v1/openOrders", open_orders_params(symbol, recvWindowMs)));
 }
 
 BinanceRest::Result BinanceRest::getUserTrades(const std::string& symbol, int limit, int recvWindowMs) {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q; q << "symbol=" << symbol;
-    if (limit > 0) q << "&limit=" << limit;
-    q << "&recvWindow=" << recvWindowMs << "&timestamp=" << ts;
-    std::string qs = q.str(); qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("GET", "/fapi/v1/userTrades?" + qs, {}, false, impl_->apiKey);
+    return impl_->run(impl_->signed_call("GET", "/fapi/v1/userTrades", user_trades_params(symbol, limit, recvWindowMs)));
+}
+
+BinanceRest::Result BinanceRest::startUserDataStream() {
+    return impl_->run(impl_->key_call("POST", "/fapi/v1/listenKey"));
+}
+
+BinanceRest::Result BinanceRest::keepAliveUserDataStream() {
+    return impl_->run(impl_->key_call("PUT", "/fapi/v1/listenKey"));
+}
+
+BinanceRest::Result BinanceRest::closeUserDataStream() {
+    return impl_->run(impl_->key_call("DELETE", "/fapi/v1/listenKey"));
 }
 
 BinanceRest::Result BinanceRest::cancelOrder(const std::string& symbol, long long orderId, const std::string& origClientOrderId, int recvWindowMs) {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q; q << "symbol=" << symbol;
-    if (orderId > 0) q << "&orderId=" << orderId;
-    if (!origClientOrderId.empty()) q << "&origClientOrderId=" << url_encode(origClientOrderId);
-    q << "&recvWindow=" << recvWindowMs << "&timestamp=" << ts;
-    std::string qs = q.str(); qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("DELETE", "/fapi/v1/order?" + qs, {}, false, impl_->apiKey);
+    return impl_->run(impl_->signed_call("DELETE", "/fapi/v1/order", cancel_order_params(symbol, orderId, origClientOrderId, recvWindowMs)));
 }
 
 BinanceRest::Result BinanceRest::cancelAllOpenOrders(const std::string& symbol, int recvWindowMs) {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q; q << "symbol=" << symbol << "&recvWindow=" << recvWindowMs << "&timestamp=" << ts;
-    std::string qs = q.str(); qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("DELETE", "/fapi/v1/allOpenOrders?" + qs, {}, false, impl_->apiKey);
+    return impl_->run(impl_->signed_call("DELETE", "/fapi/v1/allOpenOrders", "symbol=" + symbol + "&recvWindow=" + std::to_string(recvWindowMs)));
+}
+
+BinanceRest::Result BinanceRest::placeBatchOrders(const std::vector<OrderRequest>& orders, int recvWindowMs) {
+    if (!batch_size_ok(orders.size(), kMaxBatchOrders)) return failed_result(0, "batchOrders: 1-5 orders per call");
+    return impl_->run(impl_->signed_call("POST", "/fapi/v1/batchOrders", batch_orders_params(orders, recvWindowMs)));
+}
+
+BinanceRest::Result BinanceRest::cancelBatchOrders(const std::string& symbol, const std::vector<long long>& orderIds, int recvWindowMs) {
+    if (!batch_size_ok(orderIds.size(), kMaxBatchCancels)) return failed_result(0, "batchOrders cancel: 1-10 orders per call");
+    return impl_->run(impl_->signed_call("DELETE", "/fapi/v1/batchOrders", batch_cancel_params(symbol, orderIds, recvWindowMs)));
 }
 
 BinanceRest::Result BinanceRest::getDepth(const std::string& symbol, int limit) {
-    std::ostringstream q;
-    q << "/fapi/v1/depth?symbol=" << symbol;
-    if (limit > 0) q << "&limit=" << limit;
-    return impl_->https_request("GET", q.str(), {}, false, {});
+    return impl_->run(impl_->public_call(depth_target(symbol, limit)));
 }
 
 BinanceRest::Result BinanceRest::getTickerPrice(const std::string& symbol) {
-    std::ostringstream q;
-    q << "/fapi/v1/ticker/price?symbol=" << symbol;
-    return impl_->https_request("GET", q.str(), {}, false, {});
+    return impl_->run(impl_->public_call("/fapi/v1/ticker/price?symbol=" + symbol));
 }
 
 BinanceRest::Result BinanceRest::placeOrder(const std::string& symbol, const std::string& side, const std::string& type, double quantity, double price, const std::string& tif, bool reduceOnly, bool testOnly, int recvWindowMs, const std::string& positionSide, double stopPrice, const std::string& workingType) {
-    // Build query
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-
-    std::ostringstream q;
-    q << "symbol=" << symbol;
-    q << "&side=" << side;
-    q << "&type=" << type;
-    q << "&quantity=" << std::fixed << std::setprecision(8) << quantity;
-    if (type == "LIMIT") {
-        q << "&price=" << std::fixed << std::setprecision(8) << price;
-        q << "&timeInForce=" << tif;
-    }
-    if (type == "STOP_MARKET" || type == "TAKE_PROFIT_MARKET") {
-        if (stopPrice > 0) q << "&stopPrice=" << std::fixed << std::setprecision(8) << stopPrice;
-        if (!workingType.empty()) q << "&workingType=" << workingType;
-    }
-    if (!positionSide.empty()) q << "&positionSide=" << positionSide;
-    if (reduceOnly) q << "&reduceOnly=true";
-    q << "&recvWindow=" << recvWindowMs;
-    q << "&timestamp=" << ts;
+    std::string endpoint = testOnly ? "/fapi/v1/order/test" : "/fapi/v1/order";
+    return impl_->run(impl_->signed_call("POST", endpoint, place_order_params(symbol, side, type, quantity, price, tif, reduceOnly, recvWindowMs, positionSide, stopPrice, workingType)));
+}
 
-    std::string qs = q.str();
-    std::string sig = impl_->hmac_sha256_hex(qs);
-    qs += "&signature=" + sig;
+BinanceRest::Result BinanceRest::placeOrder(const OrderRequest& order, bool testOnly, int recvWindowMs) {
+    return impl_->run(impl_->signed_call("POST", testOnly ? "/fapi/v1/order/test" : "/fapi/v1/order", order_request_params(order, recvWindowMs)));
+}
 
-    std::string endpoint = testOnly ? "/fapi/v1/order/test" : "/fapi/v1/order";
-    // Send parameters in query string only (avoid duplicating in body to prevent signature mismatches)
-    return impl_->https_request("POST", endpoint + "?" + qs, "", true, impl_->apiKey);
+BinanceRest::Result BinanceRest::modifyOrder(const std::string& symbol, long long orderId, const std::string& origClientOrderId, const std::string& side, double quantity, double price, int recvWindowMs) {
+    return impl_->run(impl_->signed_call("PUT", "/fapi/v1/order", modify_order_params(symbol, orderId, origClientOrderId, side, quantity, price, recvWindowMs)));
+}
+
+BinanceRest::Result BinanceRest::queryOrder(const std::string& symbol, long long orderId, const std::string& origClientOrderId, int recvWindowMs) {
+    return impl_->run(impl_->signed_call("GET", "/fapi/v1/order", cancel_order_params(symbol, orderId, origClientOrderId, recvWindowMs)));
 }
 
 BinanceRest::Result BinanceRest::setLeverage(const std::string& symbol, int leverage) {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q;
-    q << "symbol=" << symbol << "&leverage=" << leverage << "&timestamp=" << ts;
-    std::string qs = q.str();
-    qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("POST", "/fapi/v1/leverage?" + qs, "", true, impl_->apiKey);
+    return impl_->run(impl_->signed_call("POST", "/fapi/v1/leverage", "symbol=" + symbol + "&leverage=" + std::to_string(leverage)));
 }
 
 BinanceRest::Result BinanceRest::setMarginType(const std::string& symbol, const std::string& marginType) {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q;
-    q << "symbol=" << symbol << "&marginType=" << marginType << "&timestamp=" << ts;
-    std::string qs = q.str();
-    qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("POST", "/fapi/v1/marginType?" + qs, "", true, impl_->apiKey);
+    return impl_->run(impl_->signed_call("POST", "/fapi/v1/marginType", "symbol=" + symbol + "&marginType=" + marginType));
 }
 
 BinanceRest::Result BinanceRest::setDualPosition(bool enable) {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q;
-    q << "dualSidePosition=" << (enable?"true":"false") << "&timestamp=" << ts;
-    std::string qs = q.str();
-    qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("POST", "/fapi/v1/positionSide/dual?" + qs, "", true, impl_->apiKey);
+    return impl_->run(impl_->signed_call("POST", "/fapi/v1/positionSide/dual", std::string("dualSidePosition=") + (enable ? "true" : "false")));
 }
 
 BinanceRest::Result BinanceRest::cancelReplaceOrder(
@@ -346,25 +1011,122 @@ BinanceRest::Result BinanceRest::cancelReplaceOrder(
     const std::string& cancelReplaceMode,
     int recvWindowMs)
 {
-    using namespace std::chrono;
-    long long ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + impl_->timeOffsetMs;
-    std::ostringstream q;
-    q << "symbol=" << symbol;
-    q << "&cancelOrderId=" << cancelOrderId;
-    q << "&side=" << side;
-    q << "&type=" << type;
-    q << std::fixed << std::setprecision(8);
-    q << "&quantity=" << quantity;
-    if (type == "LIMIT") {
-        q << "&price=" << price;
-        q << "&timeInForce=" << timeInForce;
-    }
-    if (!positionSide.empty()) q << "&positionSide=" << positionSide;
-    if (reduceOnly) q << "&reduceOnly=true";
-    q << "&cancelReplaceMode=" << cancelReplaceMode;
-    q << "&recvWindow=" << recvWindowMs;
-    q << "&timestamp=" << ts;
-    std::string qs = q.str();
-    qs += "&signature=" + impl_->hmac_sha256_hex(qs);
-    return impl_->https_request("POST", "/fapi/v1/order/cancelReplace?" + qs, "", true, impl_->apiKey);
+    return impl_->run(impl_->signed_call("POST", "/fapi/v1/order/cancelReplace",
+        cancel_replace_params(symbol, cancelOrderId, side, type, quantity, price, timeInForce, reduceOnly, positionSide, cancelReplaceMode, recvWindowMs)));
+}
+
+// ---- Async endpoints ----
+
+BinanceRest::AsyncRequest BinanceRest::getServerTimeAsync(AsyncOptions options) {
+    return impl_->run_async(impl_->public_call("/fapi/v1/time"), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::getAccountInfoAsync(int recvWindowMs, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("GET", "/fapi/v2/account", "recvWindow=" + std::to_string(recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::getExchangeInfoAsync(const std::string& symbol, AsyncOptions options) {
+    return impl_->run_async(impl_->public_call(exchange_info_target(symbol)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::getKlinesAsync(const std::string& symbol, const std::string& interval, long long startTime, long long endTime, int limit, AsyncOptions options) {
+    return impl_->run_async(impl_->public_call(klines_target(symbol, interval, startTime, endTime, limit)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::getOpenOrdersAsync(const std::string& symbol, int recvWindowMs, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("GET", "/fapi/v1/openOrders", open_orders_params(symbol, recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::getUserTradesAsync(const std::string& symbol, int limit, int recvWindowMs, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("GET", "/fapi/v1/userTrades", user_trades_params(symbol, limit, recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::startUserDataStreamAsync(AsyncOptions options) {
+    return impl_->run_async(impl_->key_call("POST", "/fapi/v1/listenKey"), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::keepAliveUserDataStreamAsync(AsyncOptions options) {
+    return impl_->run_async(impl_->key_call("PUT", "/fapi/v1/listenKey"), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::closeUserDataStreamAsync(AsyncOptions options) {
+    return impl_->run_async(impl_->key_call("DELETE", "/fapi/v1/listenKey"), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::getTickerPriceAsync(const std::string& symbol, AsyncOptions options) {
+    return impl_->run_async(impl_->public_call("/fapi/v1/ticker/price?symbol=" + symbol), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::cancelOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, int recvWindowMs, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("DELETE", "/fapi/v1/order", cancel_order_params(symbol, orderId, origClientOrderId, recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::cancelAllOpenOrdersAsync(const std::string& symbol, int recvWindowMs, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("DELETE", "/fapi/v1/allOpenOrders", "symbol=" + symbol + "&recvWindow=" + std::to_string(recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::placeBatchOrdersAsync(const std::vector<OrderRequest>& orders, int recvWindowMs, AsyncOptions options) {
+    if (!batch_size_ok(orders.size(), kMaxBatchOrders)) return rejected_async("batchOrders: 1-5 orders per call", options);
+    return impl_->run_async(impl_->signed_call("POST", "/fapi/v1/batchOrders", batch_orders_params(orders, recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::cancelBatchOrdersAsync(const std::string& symbol, const std::vector<long long>& orderIds, int recvWindowMs, AsyncOptions options) {
+    if (!batch_size_ok(orderIds.size(), kMaxBatchCancels)) return rejected_async("batchOrders cancel: 1-10 orders per call", options);
+    return impl_->run_async(impl_->signed_call("DELETE", "/fapi/v1/batchOrders", batch_cancel_params(symbol, orderIds, recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::getDepthAsync(const std::string& symbol, int limit, AsyncOptions options) {
+    return impl_->run_async(impl_->public_call(depth_target(symbol, limit)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::placeOrderAsync(const std::string& symbol, const std::string& side, const std::string& type, double quantity, double price, const std::string& tif, bool reduceOnly, bool testOnly, int recvWindowMs, const std::string& positionSide, double stopPrice, const std::string& workingType, AsyncOptions options) {
+    std::string endpoint = testOnly ? "/fapi/v1/order/test" : "/fapi/v1/order";
+    return impl_->run_async(impl_->signed_call("POST", endpoint, place_order_params(symbol, side, type, quantity, price, tif, reduceOnly, recvWindowMs, positionSide, stopPrice, workingType)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::placeOrderAsync(const OrderRequest& order, bool testOnly, int recvWindowMs, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("POST", testOnly ? "/fapi/v1/order/test" : "/fapi/v1/order", order_request_params(order, recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::placeSerializedOrderAsync(const std::string& params, const std::string& clientOrderId, AsyncOptions options) {
+    if (clientOrderId.empty()) return impl_->run_async(impl_->signed_call("POST", "/fapi/v1/order", params), std::move(options));
+    return impl_->run_async(impl_->signed_call("POST", "/fapi/v1/order", params + "&newClientOrderId=" + url_encode(clientOrderId)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::modifyOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, const std::string& side, double quantity, double price, int recvWindowMs, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("PUT", "/fapi/v1/order", modify_order_params(symbol, orderId, origClientOrderId, side, quantity, price, recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::queryOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, int recvWindowMs, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("GET", "/fapi/v1/order", cancel_order_params(symbol, orderId, origClientOrderId, recvWindowMs)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::setLeverageAsync(const std::string& symbol, int leverage, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("POST", "/fapi/v1/leverage", "symbol=" + symbol + "&leverage=" + std::to_string(leverage)), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::setMarginTypeAsync(const std::string& symbol, const std::string& marginType, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("POST", "/fapi/v1/marginType", "symbol=" + symbol + "&marginType=" + marginType), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::setDualPositionAsync(bool enable, AsyncOptions options) {
+    return impl_->run_async(impl_->signed_call("POST", "/fapi/v1/positionSide/dual", std::string("dualSidePosition=") + (enable ? "true" : "false")), std::move(options));
+}
+
+BinanceRest::AsyncRequest BinanceRest::cancelReplaceOrderAsync(
+    const std::string& symbol,
+    long long cancelOrderId,
+    const std::string& side,
+    const std::string& type,
+    double quantity,
+    double price,
+    const std::string& timeInForce,
+    bool reduceOnly,
+    const std::string& positionSide,
+    const std::string& cancelReplaceMode,
+    int recvWindowMs,
+    AsyncOptions options)
+{
+    return impl_->run_async(impl_->signed_call("POST", "/fapi/v1/order/cancelReplace",
+        cancel_replace_params(symbol, cancelOrderId, side, type, quantity, price, timeInForce, reduceOnly, positionSide, cancelReplaceMode, recvWindowMs)), std::move(options));
 }
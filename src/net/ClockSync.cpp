@@ -0,0 +1,232 @@
+#include "binancerj/net/ClockSync.hpp"
+#include "binancerj/net/BinanceRest.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+
+namespace binancerj::net {
+
+namespace {
+
+constexpr int kBurst = 5;                // samples per round
+constexpr std::size_t kFilterRounds = 8;  // clock filter looks at this many recent rounds
+constexpr std::size_t kHistoryRounds = 32;
+constexpr long long kMinDriftSpanUs = 5LL * 60 * 1000 * 1000;  // fit drift over >= 5 minutes
+constexpr double kMaxDriftPpm = 500.0;
+constexpr long long kStepThresholdUs = 50 * 1000;  // larger jumps mean the local clock was stepped
+
+long long wallUs() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// {"serverTime":1499827319559}
+bool parseServerTime(const std::string& body, long long& out) {
+    const std::string key = "\"serverTime\"";
+    auto pos = body.find(key);
+    if (pos == std::string::npos) return false;
+    pos = body.find_first_of("0123456789", pos + key.size());
+    if (pos == std::string::npos) return false;
+    auto res = std::from_chars(body.data() + pos, body.data() + body.size(), out);
+    return res.ec == std::errc();
+}
+
+} // namespace
+
+ClockSync& ClockSync::instance() {
+    static ClockSync sync;
+    return sync;
+}
+
+ClockSync::~ClockSync() {
+    stop();
+}
+
+void ClockSync::start(const std::string& host, std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(runMutex_);
+    if (running_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> sampleLock(sampleMutex_);
+        if (host != host_) {
+            host_ = host;
+            history_.clear();
+            hostKey_.store(std::hash<std::string>{}(host), std::memory_order_release);
+        }
+    }
+    running_ = true;
+    thread_ = std::thread([this, interval]() { run(interval); });
+}
+
+void ClockSync::stop() {
+    {
+        std::lock_guard<std::mutex> lock(runMutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ClockSync::run(std::chrono::milliseconds interval) {
+    telemetry::logEvent("clock", "sync start");
+    for (;;) {
+        sampleNow();
+        std::unique_lock<std::mutex> lock(runMutex_);
+        // Retry sooner while unsynced so the first orders do not go out on the raw clock.
+        const auto wait = synced() ? interval : std::min<std::chrono::milliseconds>(interval, std::chrono::seconds(2));
+        if (wake_.wait_for(lock, wait, [this]() { return !running_; })) {
+            break;
+        }
+    }
+    telemetry::logEvent("clock", "sync stop");
+}
+
+bool ClockSync::sampleNow() {
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    BinanceRest rest(host_);  // rides the shared keep-alive pool
+
+    Point best{0, 0, -1};
+    for (int i = 0; i < kBurst; ++i) {
+        const long long t0 = wallUs();
+        auto r = rest.getServerTime();
+        const long long t1 = wallUs();
+        if (!r.ok) {
+            break;  // unreachable: don't stack up timeouts (and delay stop())
+        }
+        long long serverMs = 0;
+        if (!parseServerTime(r.body, serverMs)) {
+            continue;
+        }
+        // Assume a symmetric path: the server stamped the midpoint. serverTime has ms
+        // resolution, so take the middle of that millisecond.
+        const long long rtt = t1 - t0;
+        const long long mid = t0 + rtt / 2;
+        const long long offset = serverMs * 1000 + 500 - mid;
+        if (best.rttUs < 0 || rtt < best.rttUs) {
+            best = Point{mid, offset, rtt};
+        }
+    }
+    if (best.rttUs < 0) {
+        telemetry::logEvent("clock", "sample_failed host=" + host_);
+        return false;
+    }
+
+    if (!history_.empty() && synced()) {
+        const long long predicted = offsetUs();
+        if (std::llabs(best.offsetUs - predicted) > std::max(best.rttUs, kStepThresholdUs)) {
+            telemetry::logEvent("clock", "step detected delta_us=" + std::to_string(best.offsetUs - predicted));
+            history_.clear();
+        }
+    }
+    history_.push_back(best);
+    while (history_.size() > kHistoryRounds) {
+        history_.pop_front();
+    }
+
+    // Clock filter: the lowest-delay round among the last few carries the least error.
+    auto first = history_.size() > kFilterRounds ? history_.end() - static_cast<std::ptrdiff_t>(kFilterRounds) : history_.begin();
+    auto chosen = std::min_element(first, history_.end(), [](const Point& a, const Point& b) { return a.rttUs < b.rttUs; });
+    const double drift = fitDriftPpm();
+    publish(chosen->localUs, chosen->offsetUs, drift);
+    rttUs_.store(best.rttUs, std::memory_order_relaxed);
+    synced_.store(true, std::memory_order_release);
+
+    telemetry::logGauge("clock", "offset_ms", static_cast<double>(offsetUs()) / 1000.0);
+    telemetry::logGauge("clock", "rtt_ms", static_cast<double>(best.rttUs) / 1000.0);
+    telemetry::logGauge("clock", "drift_ppm", drift);
+    return true;
+}
+
+double ClockSync::fitDriftPpm() const {
+    if (history_.size() < 4 || history_.back().localUs - history_.front().localUs < kMinDriftSpanUs) {
+        return 0.0;
+    }
+    // Least squares of offset over local time, using only rounds close to the best delay.
+    long long minRtt = history_.front().rttUs;
+    for (const auto& p : history_) minRtt = std::min(minRtt, p.rttUs);
+    const long long rttLimit = 2 * minRtt + 1000;
+    const double x0 = static_cast<double>(history_.front().localUs);
+    const double y0 = static_cast<double>(history_.front().offsetUs);
+    double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (const auto& p : history_) {
+        if (p.rttUs > rttLimit) continue;
+        const double x = static_cast<double>(p.localUs) - x0;
+        const double y = static_cast<double>(p.offsetUs) - y0;
+        n += 1; sx += x; sy += y; sxx += x * x; sxy += x * y;
+    }
+    const double den = n * sxx - sx * sx;
+    if (n < 4 || den <= 0.0) {
+        return 0.0;
+    }
+    const double ppm = (n * sxy - sx * sy) / den * 1e6;
+    return std::clamp(ppm, -kMaxDriftPpm, kMaxDriftPpm);
+}
+
+void ClockSync::publish(long long refLocalUs, long long offsetUs, double driftPpm) {
+    const unsigned s = seq_.load(std::memory_order_relaxed);
+    seq_.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    refLocalUs_.store(refLocalUs, std::memory_order_relaxed);
+    estOffsetUs_.store(offsetUs, std::memory_order_relaxed);
+    driftPpm_.store(driftPpm, std::memory_order_relaxed);
+    seq_.store(s + 2, std::memory_order_release);
+}
+
+long long ClockSync::offsetUs() const {
+    long long ref = 0, offset = 0;
+    double drift = 0.0;
+    for (;;) {
+        const unsigned s1 = seq_.load(std::memory_order_acquire);
+        if (s1 & 1u) {
+            continue;  // writer mid-update
+        }
+        ref = refLocalUs_.load(std::memory_order_relaxed);
+        offset = estOffsetUs_.load(std::memory_order_relaxed);
+        drift = driftPpm_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) == s1) {
+            break;
+        }
+    }
+    if (drift == 0.0) {
+        return offset;
+    }
+    return offset + static_cast<long long>(drift * 1e-6 * static_cast<double>(wallUs() - ref));
+}
+
+long long ClockSync::serverTimeMs() const {
+    return (wallUs() + offsetUs()) / 1000;
+}
+
+bool ClockSync::samples(const std::string& host) const {
+    return hostKey_.load(std::memory_order_acquire) == std::hash<std::string>{}(host);
+}
+
+long long ClockSync::serverTimeMsFor(const std::string& host) const {
+    return samples(host) ? serverTimeMs() : wallUs() / 1000;
+}
+
+double ClockSync::driftPpm() const {
+    return driftPpm_.load(std::memory_order_relaxed);
+}
+
+int ClockSync::recvWindowMs(int fallbackMs) const {
+    if (!synced()) {
+        return fallbackMs;
+    }
+    // Three round trips of slack plus a fixed margin for server-side queueing.
+    const long long rttMs = (rttUs() + 999) / 1000;
+    const long long window = std::max(1000LL, 3 * rttMs + 500);
+    return static_cast<int>(std::min<long long>(window, fallbackMs));
+}
+
+} // namespace binancerj::net
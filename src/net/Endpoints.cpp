@@ -0,0 +1,54 @@
+#include "binancerj/net/Endpoints.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <cstdlib>
+
+namespace binancerj::net {
+
+namespace {
+
+std::string getEnv(const char* name) {
+#ifdef _WIN32
+    size_t len = 0; char* buf = nullptr;
+    if (_dupenv_s(&buf, &len, name) == 0 && buf) { std::string v(buf); free(buf); return v; }
+    return {};
+#else
+    const char* v = std::getenv(name);
+    return v ? std::string(v) : std::string();
+#endif
+}
+
+Endpoints load() {
+    Endpoints e;
+    e.restHost = getEnv("BINANCE_RJ_REST_HOST");
+    if (e.restHost.empty()) e.restHost = "fapi.binance.com";
+    std::string stream = getEnv("BINANCE_RJ_STREAM_HOST");
+    if (stream.empty()) stream = "fstream.binance.com";
+    splitHostPort(stream, e.streamHost, e.streamPort);
+    e.wsApiHost = getEnv("BINANCE_RJ_WS_API_HOST");
+    if (e.wsApiHost.empty()) e.wsApiHost = "ws-fapi.binance.com";
+    e.wsOrderEntry = getEnv("BINANCE_RJ_ORDER_TRANSPORT") == "ws";
+    telemetry::logEvent("endpoints", "rest=" + e.restHost + " stream=" + e.streamHost + ":" + e.streamPort + " ws_api=" + e.wsApiHost
+        + " orders=" + (e.wsOrderEntry ? "ws" : "rest"));
+    return e;
+}
+
+} // namespace
+
+const Endpoints& Endpoints::get() {
+    static const Endpoints endpoints = load();
+    return endpoints;
+}
+
+void splitHostPort(const std::string& authority, std::string& host, std::string& port, const char* defaultPort) {
+    const std::size_t colon = authority.rfind(':');
+    if (colon == std::string::npos || colon + 1 == authority.size()) {
+        host = authority.substr(0, colon);
+        port = defaultPort;
+        return;
+    }
+    host = authority.substr(0, colon);
+    port = authority.substr(colon + 1);
+}
+
+} // namespace binancerj::net
@@ -0,0 +1,93 @@
+#include "binancerj/net/JsonScan.hpp"
+
+#include <cctype>
+#include <charconv>
+
+namespace binancerj::net {
+
+namespace {
+
+bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+std::size_t skipString(std::string_view s, std::size_t i) {
+    for (++i; i < s.size(); ++i) {
+        if (s[i] == '\\') ++i;
+        else if (s[i] == '"') return i + 1;
+    }
+    return s.size();
+}
+
+} // namespace
+
+std::size_t jsonSkipValue(std::string_view s, std::size_t i) {
+    if (i >= s.size()) return i;
+    if (s[i] == '"') return skipString(s, i);
+    if (s[i] == '{' || s[i] == '[') {
+        int depth = 0;
+        while (i < s.size()) {
+            const char c = s[i];
+            if (c == '"') { i = skipString(s, i); continue; }
+            if (c == '{' || c == '[') ++depth;
+            else if ((c == '}' || c == ']') && --depth == 0) return i + 1;
+            ++i;
+        }
+        return i;
+    }
+    while (i < s.size() && s[i] != ',' && s[i] != '}' && s[i] != ']' && !isSpace(s[i])) ++i;
+    return i;
+}
+
+std::string_view jsonMember(std::string_view s, std::string_view key) {
+    std::size_t i = s.find('{');
+    if (i == std::string_view::npos) return {};
+    ++i;
+    while (i < s.size()) {
+        i = s.find('"', i);
+        if (i == std::string_view::npos) return {};
+        const std::size_t keyEnd = skipString(s, i);
+        const std::string_view k = s.substr(i + 1, keyEnd - i - 2);
+        i = s.find(':', keyEnd);
+        if (i == std::string_view::npos) return {};
+        ++i;
+        while (i < s.size() && isSpace(s[i])) ++i;
+        const std::size_t end = jsonSkipValue(s, i);
+        if (k == key) return s.substr(i, end - i);
+        i = end;
+    }
+    return {};
+}
+
+std::string_view jsonUnquote(std::string_view v) {
+    if (v.size() >= 2 && v.front() == '"' && v.back() == '"') return v.substr(1, v.size() - 2);
+    return v;
+}
+
+std::string jsonString(std::string_view v) {
+    if (v == "null") return {};
+    return std::string(jsonUnquote(v));
+}
+
+long long jsonLong(std::string_view v, long long fallback) {
+    v = jsonUnquote(v);
+    long long out = fallback;
+    const auto res = std::from_chars(v.data(), v.data() + v.size(), out);
+    return res.ec == std::errc() ? out : fallback;
+}
+
+double jsonDouble(std::string_view v, double fallback) {
+    v = jsonUnquote(v);
+    double out = fallback;
+    const auto res = std::from_chars(v.data(), v.data() + v.size(), out);
+    return res.ec == std::errc() ? out : fallback;
+}
+
+bool jsonBool(std::string_view v, bool fallback) {
+    v = jsonUnquote(v);
+    if (v == "true") return true;
+    if (v == "false") return false;
+    return fallback;
+}
+
+} // namespace binancerj::net
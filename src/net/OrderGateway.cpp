@@ -0,0 +1,215 @@
+#include "binancerj/net/OrderGateway.hpp"
+#include "binancerj/core/MpscRing.hpp"
+#include "binancerj/net/ClockSync.hpp"
+#include "binancerj/net/OrderJson.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace binancerj::net {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct QueuedIntent {
+    OrderIntent intent;
+    Clock::time_point queuedAt{};
+};
+
+double elapsedUs(Clock::time_point since) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - since).count();
+}
+
+core::OrderState stateOf(const BinanceRest::OrderRequest& o, const std::string& clientOrderId) {
+    core::OrderState st;
+    st.clientOrderId = clientOrderId;
+    st.symbol = o.symbol;
+    st.side = o.side;
+    st.type = o.type;
+    st.timeInForce = o.timeInForce;
+    st.positionSide = o.positionSide;
+    st.price = o.price;
+    st.stopPrice = o.stopPrice;
+    st.origQty = o.quantity;
+    st.reduceOnly = o.reduceOnly;
+    return st;
+}
+
+} // namespace
+
+struct OrderGateway::Impl : std::enable_shared_from_this<OrderGateway::Impl> {
+    OrderEntry& entry;
+    core::OrderManager& oms;
+    Options options;
+    core::MpscRing<QueuedIntent> intents;
+    core::MpscRing<OrderAck> acks;
+    std::atomic<std::size_t> outstanding{0};
+    std::atomic<core::OrderTracer*> tracer{nullptr};
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> sleeping{false};
+    std::atomic<bool> stopping{false};
+    std::thread thread;
+
+    Impl(OrderEntry& e, core::OrderManager& m, const Options& o)
+        : entry(e), oms(m), options(o), intents(o.queueCapacity), acks(o.ackCapacity) {}
+
+    // Producer side of the sleep handshake: a consumer that decided to sleep after its last
+    // empty check is woken; one that is still polling sees the intent anyway.
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wake.notify_one();
+        }
+    }
+
+    void run() {
+        QueuedIntent q;
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (intents.tryPop(q)) {
+                send(std::move(q));
+                continue;
+            }
+            // Poll briefly (a burst of hotkeys arrives within microseconds), then sleep.
+            const auto spinUntil = Clock::now() + std::chrono::microseconds(options.spinUs);
+            bool found = false;
+            while (Clock::now() < spinUntil) {
+                if (!intents.empty()) { found = true; break; }
+                std::this_thread::yield();
+            }
+            if (found) continue;
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (intents.empty() && !stopping.load(std::memory_order_acquire)) {
+                wake.wait_for(lock, std::chrono::milliseconds(100));
+            }
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void send(QueuedIntent q) {
+        const double queueUs = elapsedUs(q.queuedAt);
+        const OrderEntry::StagedOrder* staged = q.intent.staged.get();
+        oms.submit(stateOf(staged ? staged->order : q.intent.order, q.intent.order.newClientOrderId), ClockSync::instance().serverTimeMs());
+
+        core::OrderTracer* trace = tracer.load(std::memory_order_acquire);
+        const std::uint64_t traceId = trace ? trace->begin(q.intent.order.newClientOrderId, (staged ? staged->order : q.intent.order).type, q.queuedAt) : 0;
+
+        auto self = shared_from_this();
+        const Clock::time_point sentAt = Clock::now();
+        auto meta = std::make_shared<OrderIntent>(std::move(q.intent));
+        BinanceRest::AsyncOptions opts;
+        opts.onComplete = [self, meta, queueUs, sentAt, trace, traceId](const BinanceRest::Result& r) {
+            if (trace) trace->mark(traceId, core::OrderStage::Acked);
+            self->complete(*meta, r, queueUs, sentAt, traceId);
+        };
+        if (trace) {
+            // Stamped by the transport: after the call returns, the I/O thread may already have
+            // written it, and a later Signed would make the write span negative.
+            opts.onSigned = [trace, traceId]() { trace->mark(traceId, core::OrderStage::Signed); };
+            opts.onWritten = [trace, traceId]() { trace->mark(traceId, core::OrderStage::Written); };
+        }
+        if (staged) (void)entry.placeStagedAsync(*staged, meta->order.newClientOrderId, std::move(opts));
+        else (void)entry.placeOrderAsync(meta->order, meta->recvWindowMs, std::move(opts));
+        // Logged after the hand-off: the log file lock must not sit in front of the order.
+        telemetry::logCounter("order_gateway", "submitted", 1);
+        telemetry::logGauge("order_gateway", "queue_us", queueUs);
+    }
+
+    // Answer -> OMS. Only an exchange error code rejects the order; timeouts and transport
+    // errors leave it pending until an event or the next open-orders reconcile settles it.
+    void settle(const std::string& clientOrderId, const BinanceRest::Result& r) {
+        const core::OrderState ack = parseOrderJson(r.body);
+        if (ack.orderId > 0) {
+            oms.onAck(clientOrderId, ack);
+            return;
+        }
+        if (r.status < 400 || r.status >= 500) return;
+        const std::string err = orderErrorText(r.body);
+        if (!err.empty()) oms.onReject(clientOrderId, err, ClockSync::instance().serverTimeMs());
+    }
+
+    void complete(OrderIntent& intent, const BinanceRest::Result& r, double queueUs, Clock::time_point sentAt, std::uint64_t traceId) {
+        OrderAck ack;
+        ack.clientOrderId = intent.order.newClientOrderId;
+        ack.traceId = traceId;
+        ack.ackMs = elapsedUs(sentAt) / 1000.0;
+        telemetry::logGauge("order_gateway", "ack_ms", ack.ackMs);
+        settle(ack.clientOrderId, r);
+
+        core::ManagedOrder m;
+        if (oms.findClient(ack.clientOrderId, m)) ack.phase = m.phase;
+        if (ack.phase == core::OrderPhase::Rejected) telemetry::logCounter("order_gateway", "rejected", 1);
+        ack.source = intent.source;
+        ack.tag = intent.tag;
+        if (intent.staged) {
+            ack.order = intent.staged->order;
+            ack.order.newClientOrderId = ack.clientOrderId;
+        } else {
+            ack.order = intent.order;
+        }
+        ack.result = r;
+        ack.queueUs = queueUs;
+        if (intent.then) intent.then(ack);
+        outstanding.fetch_sub(1, std::memory_order_relaxed);
+        if (!acks.tryPush(std::move(ack))) telemetry::logCounter("order_gateway", "ack_dropped", 1);
+    }
+};
+
+OrderGateway::OrderGateway(OrderEntry& entry, core::OrderManager& oms, Options options)
+    : impl_(std::make_shared<Impl>(entry, oms, options)) {
+    impl_->thread = std::thread([impl = impl_.get()]() { impl->run(); });
+}
+
+OrderGateway::~OrderGateway() {
+    impl_->stopping.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(impl_->wakeMutex);
+        impl_->wake.notify_one();
+    }
+    if (impl_->thread.joinable()) impl_->thread.join();
+}
+
+std::string OrderGateway::submit(OrderIntent intent) {
+    if (intent.order.newClientOrderId.empty()) intent.order.newClientOrderId = impl_->oms.newClientOrderId();
+    std::string clientOrderId = intent.order.newClientOrderId;
+    QueuedIntent q;
+    q.intent = std::move(intent);
+    q.queuedAt = Clock::now();
+    impl_->outstanding.fetch_add(1, std::memory_order_relaxed);
+    if (!impl_->intents.tryPush(std::move(q))) {
+        impl_->outstanding.fetch_sub(1, std::memory_order_relaxed);
+        telemetry::logCounter("order_gateway", "queue_full", 1);
+        return std::string();
+    }
+    impl_->notify();
+    return clientOrderId;
+}
+
+std::size_t OrderGateway::drainAcks(std::vector<OrderAck>& out) {
+    std::size_t n = 0;
+    OrderAck ack;
+    while (impl_->acks.tryPop(ack)) {
+        out.push_back(std::move(ack));
+        ++n;
+    }
+    return n;
+}
+
+std::size_t OrderGateway::pending() const {
+    return impl_->outstanding.load(std::memory_order_relaxed);
+}
+
+void OrderGateway::setTracer(core::OrderTracer* tracer) {
+    impl_->tracer.store(tracer, std::memory_order_release);
+}
+
+} // namespace binancerj::net
@@ -0,0 +1,42 @@
+#include "binancerj/net/OrderJson.hpp"
+#include "binancerj/net/JsonScan.hpp"
+
+namespace binancerj::net {
+
+core::OrderState parseOrderJson(std::string_view e) {
+    core::OrderState o;
+    o.orderId = jsonLong(jsonMember(e, "orderId"));
+    if (o.orderId <= 0) return o;
+    o.clientOrderId = jsonString(jsonMember(e, "clientOrderId"));
+    o.symbol = jsonString(jsonMember(e, "symbol"));
+    o.side = jsonString(jsonMember(e, "side"));
+    o.type = jsonString(jsonMember(e, "type"));
+    o.timeInForce = jsonString(jsonMember(e, "timeInForce"));
+    o.positionSide = jsonString(jsonMember(e, "positionSide"));
+    o.status = jsonString(jsonMember(e, "status"));
+    o.price = jsonDouble(jsonMember(e, "price"));
+    o.stopPrice = jsonDouble(jsonMember(e, "stopPrice"));
+    o.origQty = jsonDouble(jsonMember(e, "origQty"));
+    o.executedQty = jsonDouble(jsonMember(e, "executedQty"));
+    o.avgPrice = jsonDouble(jsonMember(e, "avgPrice"));
+    o.reduceOnly = jsonBool(jsonMember(e, "reduceOnly"));
+    o.updateTimeMs = jsonLong(jsonMember(e, "updateTime"), jsonLong(jsonMember(e, "time")));
+    return o;
+}
+
+std::vector<core::OrderState> parseOrderArray(std::string_view array) {
+    std::vector<core::OrderState> out;
+    jsonForEach(array, [&out](std::string_view e) {
+        core::OrderState o = parseOrderJson(e);
+        if (o.orderId > 0) out.push_back(std::move(o));
+    });
+    return out;
+}
+
+std::string orderErrorText(std::string_view e) {
+    const std::string_view code = jsonMember(e, "code");
+    if (code.empty()) return {};
+    return std::string(jsonUnquote(code)) + " " + jsonString(jsonMember(e, "msg"));
+}
+
+} // namespace binancerj::net
@@ -0,0 +1,101 @@
+#include "binancerj/net/OrderStager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace binancerj::net {
+
+namespace {
+
+double floorStep(double v, double step) {
+    if (step <= 0.0) return v;
+    return std::floor((v + 1e-12) / step) * step;
+}
+
+double ceilStep(double v, double step) {
+    if (step <= 0.0) return v;
+    double x = floorStep(v, step);
+    if (x < v - 1e-12) x += step;
+    return x;
+}
+
+BinanceRest::OrderRequest iocLimit(const OrderStager::Inputs& in, bool isBuy, double qty, double price) {
+    BinanceRest::OrderRequest o;
+    o.symbol = in.symbol;
+    o.side = isBuy ? "BUY" : "SELL";
+    o.type = "LIMIT";
+    o.quantity = qty;
+    o.price = price;
+    o.timeInForce = "IOC";
+    o.workingType = "MARK_PRICE";
+    return o;
+}
+
+} // namespace
+
+bool OrderStager::Inputs::operator==(const Inputs& o) const {
+    return symbol == o.symbol && bestBid == o.bestBid && bestAsk == o.bestAsk && availableUsdt == o.availableUsdt &&
+           sizePct == o.sizePct && leverage == o.leverage && qtyStep == o.qtyStep && priceTick == o.priceTick &&
+           minQty == o.minQty && dualSide == o.dualSide && positions == o.positions && recvWindowMs == o.recvWindowMs;
+}
+
+OrderStager::OrderStager(const OrderEntry& entry)
+    : entry_(entry), published_(std::make_shared<const Staged>()) {}
+
+bool OrderStager::update(const Inputs& in) {
+    if (primed_ && in == last_) return false;
+    last_ = in;
+    primed_ = true;
+
+    auto staged = std::make_shared<Staged>();
+    staged->version = ++version_;
+    staged->symbol = in.symbol;
+
+    // Entries: the whole size at the touch, as the quick order buttons always sent them
+    auto stageEntry = [&](bool isBuy) -> StagedPtr {
+        const double ref = isBuy ? in.bestAsk : in.bestBid;
+        if (ref <= 0.0) {
+            staged->note = "No book";
+            return nullptr;
+        }
+        const double notional = in.availableUsdt * (std::max(0.0, in.sizePct) / 100.0) * in.leverage;
+        double qty = floorStep(notional / ref, in.qtyStep);
+        if (qty < in.minQty) qty = in.minQty;
+        if (qty <= 0.0) {
+            staged->note = "Qty too small";
+            return nullptr;
+        }
+        BinanceRest::OrderRequest o = iocLimit(in, isBuy, qty, isBuy ? ceilStep(ref, in.priceTick) : floorStep(ref, in.priceTick));
+        if (in.dualSide) o.positionSide = isBuy ? "LONG" : "SHORT";
+        return std::make_shared<const OrderEntry::StagedOrder>(entry_.stageOrder(o, in.recvWindowMs));
+    };
+    staged->buy = stageEntry(true);
+    staged->sell = stageEntry(false);
+
+    // Closes: cross the touch from the other side, mark price when that side is empty
+    for (const Position& p : in.positions) {
+        if (std::abs(p.amount) < 1e-12) continue;
+        const bool isLong = p.amount > 0.0;
+        double ref = isLong ? in.bestBid : in.bestAsk;
+        if (ref <= 0.0) ref = p.markPrice;
+        if (ref <= 0.0) continue;
+        double qty = floorStep(std::abs(p.amount), in.qtyStep);
+        if (qty < in.minQty) qty = in.minQty;
+        if (qty <= 0.0) continue;
+        BinanceRest::OrderRequest o = iocLimit(in, !isLong, qty, isLong ? floorStep(ref, in.priceTick) : ceilStep(ref, in.priceTick));
+        o.reduceOnly = true;
+        if (in.dualSide) o.positionSide = isLong ? "LONG" : "SHORT";
+        staged->flatten.push_back(std::make_shared<const OrderEntry::StagedOrder>(entry_.stageOrder(o, in.recvWindowMs)));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    published_ = std::move(staged);
+    return true;
+}
+
+std::shared_ptr<const OrderStager::Staged> OrderStager::current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_;
+}
+
+} // namespace binancerj::net
@@ -0,0 +1,233 @@
+#include "binancerj/net/RateLimitGovernor.hpp"
+#include "binancerj/net/ClockSync.hpp"
+#include "binancerj/net/RestScheduler.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace binancerj::net {
+
+namespace {
+
+// Share of the weight limit above which a class is delayed / shed, and how long it may wait.
+struct ClassPolicy {
+    double delayAt;
+    double shedAt;
+    int maxWaitMs;
+    const char* name;
+};
+
+constexpr ClassPolicy kPolicies[] = {
+    {1.00, 1.00, 0, "order"},        // never delayed; only a full budget stops it
+    {0.75, 0.92, 2000, "account"},   // account/orders/fills polling
+    {0.60, 0.85, 3000, "market"},    // klines, depth, tickers
+    {1.00, 1.00, 0, "cancel"},       // admitted unless the IP is banned (418)
+};
+
+constexpr int kDelayStepMs = 250;
+
+// Looks up name=value in a query string without a leading '?'.
+bool findParam(const std::string& query, const char* name, std::size_t& valuePos) {
+    const std::string key = std::string(name) + "=";
+    if (query.compare(0, key.size(), key) == 0) {
+        valuePos = key.size();
+        return true;
+    }
+    const std::size_t pos = query.find("&" + key);
+    if (pos == std::string::npos) return false;
+    valuePos = pos + 1 + key.size();
+    return true;
+}
+
+bool hasParam(const std::string& query, const char* name) {
+    std::size_t pos = 0;
+    return findParam(query, name, pos);
+}
+
+int intParam(const std::string& query, const char* name, int fallback) {
+    std::size_t pos = 0;
+    return findParam(query, name, pos) ? std::atoi(query.c_str() + pos) : fallback;
+}
+
+// Orders in a batchOrders call: one url-encoded JSON object each ("%7B" is '{').
+int batchSize(const std::string& query) {
+    std::size_t pos = 0;
+    if (!findParam(query, "batchOrders", pos)) return 1;
+    int n = 0;
+    for (pos = query.find("%7B", pos); pos != std::string::npos; pos = query.find("%7B", pos + 3)) ++n;
+    return std::max(1, n);
+}
+
+int depthWeight(int limit) {
+    if (limit <= 50) return 2;
+    if (limit <= 100) return 5;
+    if (limit <= 500) return 10;
+    return 20;
+}
+
+} // namespace
+
+RateLimitGovernor& RateLimitGovernor::instance() {
+    static RateLimitGovernor governor;
+    return governor;
+}
+
+RateLimitGovernor::Classified RateLimitGovernor::classify(const std::string& method, const std::string& target) {
+    const std::size_t q = target.find('?');
+    const std::string path = target.substr(0, q);
+    const std::string query = q == std::string::npos ? std::string() : target.substr(q + 1);
+    const bool isGet = method == "GET";
+
+    // Order entry and account configuration: user actions, never shed for polling's sake.
+    // Cancels (single, batch, all) do not count toward the order limits and are never held.
+    if (!isGet) {
+        const bool orderPath = path.rfind("/fapi/v1/order", 0) == 0 || path == "/fapi/v1/batchOrders" || path == "/fapi/v1/allOpenOrders";
+        if (method == "DELETE" && orderPath) return {Priority::Cancel, 1, 0};
+        if (path == "/fapi/v1/batchOrders") return {Priority::Order, 5, batchSize(query)};
+        if (path.rfind("/fapi/v1/order", 0) == 0) return {Priority::Order, 1, 1};
+        if (path == "/fapi/v1/leverage" || path == "/fapi/v1/marginType" || path == "/fapi/v1/positionSide/dual") {
+            return {Priority::Order, 1, 0};
+        }
+        return {Priority::Account, 1, 0};  // listenKey and the like
+    }
+    if (path == "/fapi/v2/account" || path == "/fapi/v2/positionRisk" || path == "/fapi/v1/userTrades") return {Priority::Account, 5};
+    if (path == "/fapi/v1/openOrders") return {Priority::Account, hasParam(query, "symbol") ? 1 : 40};
+    if (path == "/fapi/v1/order") return {Priority::Account, 1};
+    if (path == "/fapi/v1/allOrders") return {Priority::Account, 5};
+    if (path == "/fapi/v1/klines") return {Priority::Market, RestScheduler::klinesWeight(intParam(query, "limit", 500))};
+    if (path == "/fapi/v1/depth") return {Priority::Market, depthWeight(intParam(query, "limit", 500))};
+    if (path == "/fapi/v1/ticker/price") return {Priority::Market, hasParam(query, "symbol") ? 1 : 2};
+    return {Priority::Market, 1};  // time, exchangeInfo, other public endpoints
+}
+
+void RateLimitGovernor::rollWindowsLocked(long long nowMs) {
+    const long long minute = nowMs / 60000;
+    if (minute != minuteWindow_) {
+        minuteWindow_ = minute;
+        usedWeight_.store(0, std::memory_order_relaxed);
+        orders1m_ = 0;
+    }
+    const long long tenSec = nowMs / 10000;
+    if (tenSec != tenSecWindow_) {
+        tenSecWindow_ = tenSec;
+        orders10s_.store(0, std::memory_order_relaxed);
+    }
+}
+
+RateLimitGovernor::Decision RateLimitGovernor::admit(const Classified& cost, int waitedMs) {
+    const Priority priority = cost.priority;
+    const int weight = cost.weight;
+    const ClassPolicy& policy = kPolicies[static_cast<int>(priority)];
+    const long long nowMs = ClockSync::instance().serverTimeMs();  // exchange windows
+    std::lock_guard<std::mutex> lock(mutex_);
+    rollWindowsLocked(nowMs);
+
+    auto shed = [&](const char* reason) {
+        telemetry::logCounter("governor", std::string("shed_") + policy.name, 1);
+        return Decision{Decision::Shed, 0, reason};
+    };
+
+    // Pulling orders only lowers risk: charged, but never delayed or shed, not even in a 429
+    // back-off. A 418 ban is the exception: the exchange answers nothing and each call extends it.
+    if (priority == Priority::Cancel) {
+        if (std::chrono::steady_clock::now() < banUntil_) {
+            return shed("IP ban (418 Retry-After)");
+        }
+        usedWeight_.fetch_add(weight, std::memory_order_relaxed);
+        return Decision{Decision::Admit, 0, nullptr};
+    }
+
+    // Calls sent during a 429/418 back-off extend the ban: stop everything, orders included.
+    if (std::chrono::steady_clock::now() < backoffUntil_) {
+        return shed("exchange back-off (Retry-After)");
+    }
+
+    const int used = usedWeight_.load(std::memory_order_relaxed);
+    const double share = static_cast<double>(used + weight) / std::max(1, limits_.weight1m);
+    if (priority == Priority::Order) {
+        if (cost.orders > 0 && (orders10s_.load(std::memory_order_relaxed) + cost.orders > limits_.orders10s
+                                || orders1m_ + cost.orders > limits_.orders1m)) {
+            return shed("order count limit");
+        }
+        if (share > policy.shedAt) {
+            return shed("request weight limit");
+        }
+        orders10s_.fetch_add(cost.orders, std::memory_order_relaxed);
+        orders1m_ += cost.orders;
+    } else {
+        if (share > policy.shedAt) {
+            return shed("request weight budget");
+        }
+        if (share > policy.delayAt) {
+            if (waitedMs >= policy.maxWaitMs) {
+                return shed("request weight budget (waited)");
+            }
+            if (waitedMs == 0) {
+                telemetry::logCounter("governor", std::string("delayed_") + policy.name, 1);
+            }
+            // The budget refills at the exchange minute boundary.
+            const int toWindowEnd = static_cast<int>(60000 - nowMs % 60000) + 5;
+            return Decision{Decision::Delay, std::min(kDelayStepMs, toWindowEnd), nullptr};
+        }
+    }
+    usedWeight_.fetch_add(weight, std::memory_order_relaxed);
+    return Decision{Decision::Admit, 0, nullptr};
+}
+
+int RateLimitGovernor::holdMs(const Classified& cost) const {
+    const ClassPolicy& policy = kPolicies[static_cast<int>(cost.priority)];
+    const long long nowMs = ClockSync::instance().serverTimeMs();
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cost.priority == Priority::Cancel) {
+        return now < banUntil_ ? static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(banUntil_ - now).count()) + 1 : 0;
+    }
+    if (now < backoffUntil_) {
+        return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(backoffUntil_ - now).count()) + 1;
+    }
+    // Counts of a window that has already rolled over are stale (admit() rolls them on use).
+    const int used = nowMs / 60000 == minuteWindow_ ? usedWeight_.load(std::memory_order_relaxed) : 0;
+    const double share = static_cast<double>(used + cost.weight) / std::max(1, limits_.weight1m);
+    const int toMinuteEnd = static_cast<int>(60000 - nowMs % 60000) + 5;
+    if (cost.priority == Priority::Order && cost.orders > 0) {
+        const int orders10s = nowMs / 10000 == tenSecWindow_ ? orders10s_.load(std::memory_order_relaxed) : 0;
+        const int orders1m = nowMs / 60000 == minuteWindow_ ? orders1m_ : 0;
+        if (orders1m + cost.orders > limits_.orders1m) return toMinuteEnd;
+        if (orders10s + cost.orders > limits_.orders10s) return static_cast<int>(10000 - nowMs % 10000) + 5;
+    }
+    return share > policy.delayAt ? toMinuteEnd : 0;
+}
+
+void RateLimitGovernor::onResponse(int status, int usedWeight1m, int orderCount10s, int orderCount1m, int retryAfterSec) {
+    const long long nowMs = ClockSync::instance().serverTimeMs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    rollWindowsLocked(nowMs);
+    // Headers are cumulative within the window; max() keeps local charges for calls still in flight.
+    if (usedWeight1m >= 0) usedWeight_.store(std::max(usedWeight_.load(std::memory_order_relaxed), usedWeight1m), std::memory_order_relaxed);
+    if (orderCount10s >= 0) orders10s_.store(std::max(orders10s_.load(std::memory_order_relaxed), orderCount10s), std::memory_order_relaxed);
+    if (orderCount1m >= 0) orders1m_ = std::max(orders1m_, orderCount1m);
+    if (status == 429 || status == 418) {
+        const int seconds = retryAfterSec > 0 ? retryAfterSec : (status == 418 ? 120 : 5);
+        backoffUntil_ = std::max(backoffUntil_, std::chrono::steady_clock::now() + std::chrono::seconds(seconds));
+        if (status == 418) banUntil_ = std::max(banUntil_, backoffUntil_);
+        telemetry::logEvent("governor", "backoff status=" + std::to_string(status) + " seconds=" + std::to_string(seconds));
+    }
+}
+
+void RateLimitGovernor::setLimits(const Limits& limits) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limits_ = limits;
+}
+
+RateLimitGovernor::Limits RateLimitGovernor::limits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return limits_;
+}
+
+bool RateLimitGovernor::backingOff() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::chrono::steady_clock::now() < backoffUntil_;
+}
+
+} // namespace binancerj::net
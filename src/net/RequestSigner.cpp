@@ -0,0 +1,128 @@
+#include "binancerj/net/RequestSigner.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstring>
+
+namespace binancerj::net {
+
+namespace {
+
+constexpr std::size_t kBlockSize = 64;   // SHA-256 block
+constexpr std::size_t kDigestSize = 32;  // SHA-256 output
+
+struct HexTable {
+    std::array<char, 512> pairs{};
+    constexpr HexTable() {
+        const char* digits = "0123456789abcdef";
+        for (std::size_t i = 0; i < 256; ++i) {
+            pairs[2 * i] = digits[i >> 4];
+            pairs[2 * i + 1] = digits[i & 0x0F];
+        }
+    }
+};
+
+constexpr HexTable kHex{};
+
+} // namespace
+
+// ---- QueryBuilder ----
+
+void QueryBuilder::appendKey(std::string_view key) {
+    if (!buf_.empty() && buf_.back() != '?') {
+        buf_.push_back('&');
+    }
+    buf_.append(key.data(), key.size());
+    buf_.push_back('=');
+}
+
+QueryBuilder& QueryBuilder::add(std::string_view key, std::string_view value) {
+    appendKey(key);
+    buf_.append(value.data(), value.size());
+    return *this;
+}
+
+QueryBuilder& QueryBuilder::add(std::string_view key, long long value) {
+    appendKey(key);
+    char tmp[24];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), value);
+    buf_.append(tmp, res.ptr);
+    return *this;
+}
+
+QueryBuilder& QueryBuilder::addFixed(std::string_view key, double value, int decimals) {
+    appendKey(key);
+    char tmp[512];  // enough for any finite double in fixed notation
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), value, std::chars_format::fixed, decimals);
+    if (res.ec == std::errc()) {
+        buf_.append(tmp, res.ptr);
+    }
+    return *this;
+}
+
+// ---- RequestSigner ----
+
+RequestSigner::RequestSigner(std::string_view secret)
+    : inner_(EVP_MD_CTX_new()), outer_(EVP_MD_CTX_new()), work_(EVP_MD_CTX_new()) {
+    setSecret(secret);
+}
+
+RequestSigner::~RequestSigner() {
+    EVP_MD_CTX_free(work_);
+    EVP_MD_CTX_free(outer_);
+    EVP_MD_CTX_free(inner_);
+}
+
+void RequestSigner::setSecret(std::string_view secret) {
+    // RFC 2104: keys longer than a block are hashed first, then zero-padded to a block.
+    unsigned char key[kBlockSize] = {};
+    if (secret.size() > kBlockSize) {
+        unsigned int len = 0;
+        EVP_Digest(secret.data(), secret.size(), key, &len, EVP_sha256(), nullptr);
+    } else if (!secret.empty()) {
+        std::memcpy(key, secret.data(), secret.size());
+    }
+    unsigned char ipad[kBlockSize];
+    unsigned char opad[kBlockSize];
+    for (std::size_t i = 0; i < kBlockSize; ++i) {
+        ipad[i] = static_cast<unsigned char>(key[i] ^ 0x36);
+        opad[i] = static_cast<unsigned char>(key[i] ^ 0x5c);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    EVP_DigestInit_ex(inner_, EVP_sha256(), nullptr);
+    EVP_DigestUpdate(inner_, ipad, kBlockSize);
+    EVP_DigestInit_ex(outer_, EVP_sha256(), nullptr);
+    EVP_DigestUpdate(outer_, opad, kBlockSize);
+}
+
+void RequestSigner::sign(std::string_view payload, char* out) const {
+    unsigned char innerHash[kDigestSize];
+    unsigned char mac[kDigestSize];
+    unsigned int len = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        EVP_MD_CTX_copy_ex(work_, inner_);
+        EVP_DigestUpdate(work_, payload.data(), payload.size());
+        EVP_DigestFinal_ex(work_, innerHash, &len);
+        EVP_MD_CTX_copy_ex(work_, outer_);
+        EVP_DigestUpdate(work_, innerHash, kDigestSize);
+        EVP_DigestFinal_ex(work_, mac, &len);
+    }
+    toHex(mac, kDigestSize, out);
+}
+
+void RequestSigner::appendSignature(std::string& query) const {
+    char hex[kHexLength];
+    sign(query, hex);
+    query.append("&signature=");
+    query.append(hex, kHexLength);
+}
+
+void RequestSigner::toHex(const unsigned char* data, std::size_t len, char* out) {
+    for (std::size_t i = 0; i < len; ++i) {
+        std::memcpy(out + 2 * i, kHex.pairs.data() + 2 * data[i], 2);
+    }
+}
+
+} // namespace binancerj::net
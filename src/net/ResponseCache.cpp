@@ -0,0 +1,157 @@
+#include "binancerj/net/ResponseCache.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <string_view>
+#include <utility>
+
+namespace binancerj::net {
+
+namespace {
+
+struct TtlPolicy {
+    const char* path;
+    int ttlMs;
+};
+
+// Everything not listed (server time, order endpoints) bypasses the cache.
+constexpr TtlPolicy kPolicies[] = {
+    {"/fapi/v1/exchangeInfo", 60000},  // filters change rarely
+    {"/fapi/v1/ticker/price", 1000},
+    {"/fapi/v1/depth", 0},             // market data: coalesce only
+    {"/fapi/v1/klines", 0},
+    {"/fapi/v2/account", 500},         // account reads: invalidated by signed writes
+    {"/fapi/v2/positionRisk", 500},
+    {"/fapi/v1/openOrders", 500},
+    {"/fapi/v1/userTrades", 1000},
+};
+
+constexpr std::size_t kSweepAbove = 256;  // drop expired entries once the map grows past this
+
+} // namespace
+
+ResponseCache& ResponseCache::instance() {
+    static ResponseCache cache;
+    return cache;
+}
+
+std::chrono::milliseconds ResponseCache::ttlFor(const std::string& path) {
+    for (const auto& p : kPolicies) {
+        if (path == p.path) return std::chrono::milliseconds(p.ttlMs);
+    }
+    return std::chrono::milliseconds(-1);
+}
+
+std::string ResponseCache::makeKey(const std::string& scope, const std::string& path, const std::string& params) {
+    std::string key;
+    key.reserve(scope.size() + path.size() + params.size() + 2);
+    key.append(scope).append(1, '|').append(path).append(1, '?');
+    // Callers pass different recvWindows for the same read; it does not change the answer.
+    std::size_t pos = 0;
+    bool first = true;
+    while (pos <= params.size()) {
+        std::size_t end = params.find('&', pos);
+        if (end == std::string::npos) end = params.size();
+        const std::string_view param(params.data() + pos, end - pos);
+        if (!param.empty() && param.rfind("recvWindow=", 0) != 0) {
+            if (!first) key.append(1, '&');
+            key.append(param);
+            first = false;
+        }
+        pos = end + 1;
+    }
+    return key;
+}
+
+ResponseCache::Lookup ResponseCache::acquire(const std::string& key, Result& out, Waiter waiter, std::uint64_t* ticket) {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        if (now < it->second.expires) {
+            out = it->second.result;
+            telemetry::logCounter("cache", "hit", 1);
+            return Lookup::Hit;
+        }
+        entries_.erase(it);
+    }
+    auto flight = flights_.find(key);
+    if (flight != flights_.end()) {
+        flight->second.waiters.emplace_back(++nextTicket_, std::move(waiter));
+        if (ticket) *ticket = nextTicket_;
+        telemetry::logCounter("cache", "joined", 1);
+        return Lookup::Joined;
+    }
+    flights_[key].generation = generation_;
+    telemetry::logCounter("cache", "miss", 1);
+    return Lookup::Lead;
+}
+
+void ResponseCache::complete(const std::string& key, std::chrono::milliseconds ttl, const Result& r) {
+    std::vector<std::pair<std::uint64_t, Waiter>> waiters;
+    bool handOver = false;
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto flight = flights_.find(key);
+        if (flight == flights_.end()) {
+            return;
+        }
+        auto& pending = flight->second.waiters;
+        if ((r.status == -1 || r.status == -2) && !pending.empty()) {
+            // The lead's cancel or deadline says nothing about the answer: the oldest waiter
+            // fetches instead, the rest keep waiting on the same flight.
+            waiters.push_back(std::move(pending.front()));
+            pending.erase(pending.begin());
+            flight->second.generation = generation_;
+            handOver = true;
+        } else {
+            waiters = std::move(pending);
+            const bool current = flight->second.generation == generation_;
+            flights_.erase(flight);
+            if (r.ok && ttl.count() > 0 && current) {
+                if (entries_.size() >= kSweepAbove) {
+                    for (auto e = entries_.begin(); e != entries_.end();) {
+                        e = now < e->second.expires ? std::next(e) : entries_.erase(e);
+                    }
+                }
+                entries_[key] = Entry{r, now + ttl};
+            }
+        }
+    }
+    if (handOver) telemetry::logCounter("cache", "handover", 1);
+    // Outside the lock: waiters may issue further calls.
+    for (auto& w : waiters) {
+        try { w.second(r, handOver); } catch (...) {}
+    }
+}
+
+bool ResponseCache::leave(const std::string& key, std::uint64_t ticket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto flight = flights_.find(key);
+    if (flight == flights_.end()) return false;
+    auto& waiters = flight->second.waiters;
+    for (auto it = waiters.begin(); it != waiters.end(); ++it) {
+        if (it->first == ticket) {
+            waiters.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResponseCache::invalidate(const std::string& scope) {
+    const std::string prefix = scope + "|";
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    for (auto it = entries_.lower_bound(prefix); it != entries_.end() && it->first.compare(0, prefix.size(), prefix) == 0;) {
+        it = entries_.erase(it);
+    }
+}
+
+void ResponseCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    entries_.clear();
+}
+
+} // namespace binancerj::net
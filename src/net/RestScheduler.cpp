@@ -0,0 +1,210 @@
+#include "binancerj/net/RestScheduler.hpp"
+#include "binancerj/net/Endpoints.hpp"
+#include "binancerj/net/RateLimitGovernor.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace binancerj::net {
+
+namespace {
+
+BinanceRest::Result failedResult(const std::string& why) {
+    BinanceRest::Result r;
+    r.ok = false;
+    r.status = -1;
+    r.body = why;
+    return r;
+}
+
+RateLimitGovernor::Priority governorPriority(RestScheduler::EndpointClass cls) {
+    switch (cls) {
+    case RestScheduler::EndpointClass::Account: return RateLimitGovernor::Priority::Account;
+    case RestScheduler::EndpointClass::Order: return RateLimitGovernor::Priority::Order;
+    default: return RateLimitGovernor::Priority::Market;
+    }
+}
+
+const char* className(RestScheduler::EndpointClass cls) {
+    switch (cls) {
+    case RestScheduler::EndpointClass::Market: return "market";
+    case RestScheduler::EndpointClass::Account: return "account";
+    case RestScheduler::EndpointClass::Order: return "order";
+    default: return "unknown";
+    }
+}
+
+} // namespace
+
+RestScheduler::RestScheduler(Options options)
+    : options_(std::move(options)) {
+    const auto now = Clock::now();
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+        buckets_[i] = Bucket{options_.buckets[i], options_.buckets[i].burst, now};
+    }
+    const std::size_t n = std::max<std::size_t>(1, options_.connections);
+    workers_.reserve(n);
+    telemetry::logGauge("rest_scheduler", "connections", static_cast<double>(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+RestScheduler::~RestScheduler() {
+    shutdown();
+}
+
+RestScheduler& RestScheduler::shared() {
+    static RestScheduler instance{[] {
+        Options options;
+        options.host = Endpoints::get().restHost;
+        return options;
+    }()};
+    return instance;
+}
+
+int RestScheduler::klinesWeight(int limit) {
+    if (limit < 100) return 1;
+    if (limit < 500) return 2;
+    if (limit <= 1000) return 5;
+    return 10;
+}
+
+std::future<BinanceRest::Result> RestScheduler::submit(EndpointClass cls, int weight, int priority, Job job) {
+    auto promise = std::make_shared<std::promise<BinanceRest::Result>>();
+    auto future = promise->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            promise->set_value(failedResult("RestScheduler stopped"));
+            return future;
+        }
+        queues_[static_cast<std::size_t>(cls)].push(Task{priority, nextSeq_++, std::max(1, weight), 0, std::move(job), promise});
+    }
+    cv_.notify_one();
+    return future;
+}
+
+void RestScheduler::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& q : queues_) {
+        while (!q.empty()) {
+            q.top().promise->set_value(failedResult("RestScheduler stopped"));
+            q.pop();
+        }
+    }
+}
+
+std::size_t RestScheduler::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t total = 0;
+    for (const auto& q : queues_) {
+        total += q.size();
+    }
+    return total;
+}
+
+void RestScheduler::refillLocked(Bucket& bucket, Clock::time_point now) {
+    const double elapsed = std::chrono::duration<double>(now - bucket.refilled).count();
+    bucket.tokens = std::min(bucket.config.burst, bucket.tokens + elapsed * bucket.config.ratePerSec);
+    bucket.refilled = now;
+}
+
+void RestScheduler::workerLoop(std::size_t index) {
+    // Each worker keeps its own client so its connection can be reused across jobs.
+    BinanceRest client(options_.host);
+    client.setInsecureTLS(false);
+    (void)index;
+
+    for (;;) {
+        Task task;
+        EndpointClass cls = EndpointClass::Market;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (;;) {
+                if (stopping_) {
+                    return;
+                }
+                const auto now = Clock::now();
+                std::size_t best = queues_.size();
+                bool anyQueued = false;
+                Clock::duration wait = std::chrono::seconds(1);
+                for (std::size_t i = 0; i < queues_.size(); ++i) {
+                    if (queues_[i].empty()) {
+                        continue;
+                    }
+                    anyQueued = true;
+                    auto& bucket = buckets_[i];
+                    refillLocked(bucket, now);
+                    const double need = std::min<double>(queues_[i].top().weight, bucket.config.burst);
+                    if (bucket.tokens < need) {
+                        const double sec = (need - bucket.tokens) / std::max(0.001, bucket.config.ratePerSec);
+                        wait = std::min(wait, std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(sec)));
+                        continue;
+                    }
+                    // Held while the governor would delay or shed it (budget, Retry-After).
+                    const int holdMs = RateLimitGovernor::instance().holdMs({governorPriority(static_cast<EndpointClass>(i)), queues_[i].top().weight, 0});
+                    if (holdMs > 0) {
+                        wait = std::min<Clock::duration>(wait, std::chrono::milliseconds(holdMs));
+                        continue;
+                    }
+                    if (best == queues_.size() || TaskOrder{}(queues_[best].top(), queues_[i].top())) {
+                        best = i;
+                    }
+                }
+                if (best != queues_.size()) {
+                    task = queues_[best].top();
+                    queues_[best].pop();
+                    buckets_[best].tokens -= task.weight;
+                    cls = static_cast<EndpointClass>(best);
+                    break;
+                }
+                if (anyQueued) {
+                    cv_.wait_for(lock, wait);
+                } else {
+                    cv_.wait(lock);
+                }
+            }
+        }
+
+        BinanceRest::Result result;
+        try {
+            telemetry::ScopedTimer timer("rest_scheduler", className(cls));
+            result = task.job(client);
+        } catch (const std::exception& ex) {
+            result = failedResult(std::string("RestScheduler job error: ") + ex.what());
+        } catch (...) {
+            result = failedResult("RestScheduler job error");
+        }
+        if (result.status == -3 && task.sheds < options_.maxShedRetries) {
+            // Shed before it was sent: queue it again; the hold above waits out the cause.
+            telemetry::logEvent("rest_scheduler", std::string("requeue class=") + className(cls) + " reason=" + result.body);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!stopping_) {
+                    ++task.sheds;
+                    queues_[static_cast<std::size_t>(cls)].push(std::move(task));
+                    continue;
+                }
+            }
+        }
+        task.promise->set_value(std::move(result));
+    }
+}
+
+} // namespace binancerj::net
@@ -0,0 +1,156 @@
+#include "binancerj/net/TlsContext.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <openssl/ssl.h>
+
+#include <cstdlib>
+#include <filesystem>
+
+namespace binancerj::net {
+
+namespace {
+
+std::string getEnv(const char* name) {
+#ifdef _WIN32
+    size_t len = 0; char* buf = nullptr;
+    if (_dupenv_s(&buf, &len, name) == 0 && buf) { std::string v(buf); free(buf); return v; }
+    return {};
+#else
+    const char* v = std::getenv(name);
+    return v ? std::string(v) : std::string();
+#endif
+}
+
+void loadCaBundle(boost::asio::ssl::context& ctx) {
+    // Try environment overrides first
+    std::string cafile = getEnv("SSL_CERT_FILE");
+    if (cafile.empty()) cafile = getEnv("CURL_CA_BUNDLE");
+    if (!cafile.empty()) {
+        SSL_CTX_load_verify_locations(ctx.native_handle(), cafile.c_str(), nullptr);
+        telemetry::logEvent("tls", "ca_bundle file=" + cafile);
+        return;
+    }
+    // Try common local files
+    namespace fs = std::filesystem;
+    const char* guesses[] = {
+        "cacert.pem",
+        "cert\\cacert.pem",
+        "certs\\cacert.pem",
+        "C:\\Program Files\\OpenSSL-Win64\\certs\\cacert.pem",
+        "C:\\Program Files\\Git\\mingw64\\ssl\\certs\\ca-bundle.crt",
+    };
+    for (auto p : guesses) {
+        if (fs::exists(p)) {
+            SSL_CTX_load_verify_locations(ctx.native_handle(), p, nullptr);
+            telemetry::logEvent("tls", std::string("ca_bundle file=") + p);
+            break;
+        }
+    }
+}
+
+} // namespace
+
+TlsContextFactory& TlsContextFactory::instance() {
+    static TlsContextFactory factory;
+    return factory;
+}
+
+TlsContextFactory::~TlsContextFactory() {
+    for (auto& entry : sessions_) {
+        SSL_SESSION_free(entry.second);
+    }
+}
+
+std::unique_ptr<boost::asio::ssl::context> TlsContextFactory::makeContext(bool verifyPeer) {
+    auto ctx = std::make_unique<boost::asio::ssl::context>(boost::asio::ssl::context::tls_client);
+    SSL_CTX_set_min_proto_version(ctx->native_handle(), TLS1_2_VERSION);
+    ctx->set_default_verify_paths();
+    if (verifyPeer) {
+        ctx->set_verify_mode(boost::asio::ssl::verify_peer);
+        loadCaBundle(*ctx);
+    } else {
+        ctx->set_verify_mode(boost::asio::ssl::verify_none);
+    }
+    // Client-side cache through the callback only: OpenSSL's internal store is keyed by
+    // session id, but we look sessions up by host.
+    SSL_CTX_set_session_cache_mode(ctx->native_handle(), SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx->native_handle(), &TlsContextFactory::onNewSession);
+    return ctx;
+}
+
+boost::asio::ssl::context& TlsContextFactory::client(bool verifyPeer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = verifyPeer ? verified_ : insecure_;
+    if (!slot) {
+        slot = makeContext(verifyPeer);
+    }
+    return *slot;
+}
+
+void TlsContextFactory::prepare(SSL* ssl, const std::string& host) {
+    if (!SSL_set_tlsext_host_name(ssl, host.c_str())) {
+        telemetry::logEvent("tls", "sni_failed host=" + host);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(sessionKeyLocked(ssl, host));
+    if (it == sessions_.end()) {
+        return;
+    }
+    if (!SSL_SESSION_is_resumable(it->second)) {
+        SSL_SESSION_free(it->second);
+        sessions_.erase(it);
+        return;
+    }
+    SSL_set_session(ssl, it->second);
+}
+
+void TlsContextFactory::handshakeDone(SSL* ssl) {
+    telemetry::logCounter("tls", SSL_session_reused(ssl) ? "handshake_resumed" : "handshake_full", 1);
+}
+
+void TlsContextFactory::forget(const std::string& host) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::string& key : {host, host + "#insecure"}) {
+        auto it = sessions_.find(key);
+        if (it != sessions_.end()) {
+            SSL_SESSION_free(it->second);
+            sessions_.erase(it);
+        }
+    }
+}
+
+std::size_t TlsContextFactory::cachedSessions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.size();
+}
+
+std::string TlsContextFactory::sessionKeyLocked(SSL* ssl, const std::string& host) const {
+    // Sessions from the unverified context must never be offered on a verified connection.
+    const bool insecure = insecure_ && SSL_get_SSL_CTX(ssl) == insecure_->native_handle();
+    return insecure ? host + "#insecure" : host;
+}
+
+void TlsContextFactory::store(SSL* ssl, const std::string& host, SSL_SESSION* session) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = sessions_[sessionKeyLocked(ssl, host)];
+    if (slot) {
+        SSL_SESSION_free(slot);
+    }
+    slot = session;
+}
+
+int TlsContextFactory::onNewSession(SSL* ssl, SSL_SESSION* session) {
+    const char* host = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+    if (!host) {
+        return 0;
+    }
+    // Keep a copy: OpenSSL marks the connection's own session non-resumable when that
+    // connection is freed without a clean shutdown, which pooled/dropped sockets often are.
+    SSL_SESSION* copy = SSL_SESSION_dup(session);
+    if (copy) {
+        instance().store(ssl, host, copy);
+    }
+    return 0;  // OpenSSL keeps ownership of the original
+}
+
+} // namespace binancerj::net
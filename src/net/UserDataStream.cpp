@@ -0,0 +1,543 @@
+#include "binancerj/net/UserDataStream.hpp"
+#include "binancerj/net/BinanceRest.hpp"
+#include "binancerj/net/ClockSync.hpp"
+#include "binancerj/net/Endpoints.hpp"
+#include "binancerj/net/JsonScan.hpp"
+#include "binancerj/net/OrderJson.hpp"
+#include "binancerj/net/TlsContext.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace binancerj::net {
+
+namespace {
+
+namespace asio = boost::asio;
+namespace ssl = boost::asio::ssl;
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+using tcp = asio::ip::tcp;
+using WsStream = websocket::stream<beast::ssl_stream<beast::tcp_stream>>;
+
+constexpr int kMinBackoffMs = 250;
+constexpr int kMaxBackoffMs = 10000;
+constexpr auto kIdleTimeout = std::chrono::seconds(10);  // silent this long (ping at half) = dead socket
+
+long long serverNowMs() {
+    return ClockSync::instance().serverTimeMs();
+}
+
+// "CROSSED"/"cross" -> "cross", "ISOLATED"/"isolated" -> "isolated"
+std::string marginTypeName(std::string_view raw) {
+    raw = jsonUnquote(raw);
+    if (raw.empty()) return {};
+    return (raw.front() == 'i' || raw.front() == 'I') ? "isolated" : "cross";
+}
+
+// ---- Stream events ----
+
+// ORDER_TRADE_UPDATE "o" object; fill is set when the execution type is TRADE.
+core::OrderState parseOrderEvent(std::string_view o, long long eventTimeMs, core::FillState& fill, bool& traded) {
+    core::OrderState order;
+    order.orderId = jsonLong(jsonMember(o, "i"));
+    order.clientOrderId = jsonString(jsonMember(o, "c"));
+    order.symbol = jsonString(jsonMember(o, "s"));
+    order.side = jsonString(jsonMember(o, "S"));
+    order.type = jsonString(jsonMember(o, "o"));
+    order.timeInForce = jsonString(jsonMember(o, "f"));
+    order.positionSide = jsonString(jsonMember(o, "ps"));
+    order.status = jsonString(jsonMember(o, "X"));
+    order.price = jsonDouble(jsonMember(o, "p"));
+    order.stopPrice = jsonDouble(jsonMember(o, "sp"));
+    order.origQty = jsonDouble(jsonMember(o, "q"));
+    order.executedQty = jsonDouble(jsonMember(o, "z"));
+    order.avgPrice = jsonDouble(jsonMember(o, "ap"));
+    order.reduceOnly = jsonBool(jsonMember(o, "R"));
+    order.updateTimeMs = jsonLong(jsonMember(o, "T"), eventTimeMs);
+
+    traded = jsonUnquote(jsonMember(o, "x")) == "TRADE";
+    if (traded) {
+        fill.tradeId = jsonLong(jsonMember(o, "t"));
+        fill.orderId = order.orderId;
+        fill.symbol = order.symbol;
+        fill.side = order.side;
+        fill.price = jsonDouble(jsonMember(o, "L"));
+        fill.qty = jsonDouble(jsonMember(o, "l"));
+        fill.commission = jsonDouble(jsonMember(o, "n"));
+        fill.commissionAsset = jsonString(jsonMember(o, "N"));
+        fill.realizedPnl = jsonDouble(jsonMember(o, "rp"));
+        fill.maker = jsonBool(jsonMember(o, "m"));
+        fill.timeMs = order.updateTimeMs;
+    }
+    return order;
+}
+
+// ACCOUNT_UPDATE B[] / P[] and MARGIN_CALL p[] entries.
+core::PositionState parseEventPosition(std::string_view p) {
+    core::PositionState pos;
+    pos.symbol = jsonString(jsonMember(p, "s"));
+    pos.positionSide = jsonString(jsonMember(p, "ps"));
+    pos.amount = jsonDouble(jsonMember(p, "pa"));
+    pos.entryPrice = jsonDouble(jsonMember(p, "ep"));
+    pos.unrealizedPnl = jsonDouble(jsonMember(p, "up"));
+    pos.markPrice = jsonDouble(jsonMember(p, "mp"));
+    pos.isolatedWallet = jsonDouble(jsonMember(p, "iw"));
+    pos.marginType = marginTypeName(jsonMember(p, "mt"));
+    return pos;
+}
+
+// ---- REST bodies ----
+
+struct AccountReply {
+    std::vector<core::BalanceState> balances;
+    std::vector<core::PositionState> positions;
+    double takerRate{-1.0};
+    double makerRate{-1.0};
+};
+
+// GET /fapi/v2/account. Only open positions are kept; the exchange lists every symbol.
+AccountReply parseAccount(std::string_view body) {
+    AccountReply out;
+    jsonForEach(jsonMember(body, "assets"), [&out](std::string_view a) {
+        core::BalanceState b;
+        b.asset = jsonString(jsonMember(a, "asset"));
+        b.walletBalance = jsonDouble(jsonMember(a, "walletBalance"));
+        b.crossWalletBalance = jsonDouble(jsonMember(a, "crossWalletBalance"), b.walletBalance);
+        b.availableBalance = jsonDouble(jsonMember(a, "availableBalance"));
+        b.marginBalance = jsonDouble(jsonMember(a, "marginBalance"));
+        b.updateTimeMs = jsonLong(jsonMember(a, "updateTime"));
+        if (!b.asset.empty()) out.balances.push_back(std::move(b));
+    });
+    jsonForEach(jsonMember(body, "positions"), [&out](std::string_view p) {
+        core::PositionState pos;
+        pos.amount = jsonDouble(jsonMember(p, "positionAmt"));
+        if (pos.amount == 0.0) return;
+        pos.symbol = jsonString(jsonMember(p, "symbol"));
+        pos.positionSide = jsonString(jsonMember(p, "positionSide"));
+        if (pos.positionSide.empty()) pos.positionSide = "BOTH";
+        pos.entryPrice = jsonDouble(jsonMember(p, "entryPrice"));
+        pos.unrealizedPnl = jsonDouble(jsonMember(p, "unrealizedProfit"));
+        pos.markPrice = jsonDouble(jsonMember(p, "markPrice"));
+        pos.isolatedWallet = jsonDouble(jsonMember(p, "isolatedWallet"));
+        pos.leverage = static_cast<int>(jsonLong(jsonMember(p, "leverage")));
+        const std::string_view isolated = jsonMember(p, "isolated");
+        pos.marginType = !isolated.empty() ? (jsonBool(isolated) ? "isolated" : "cross") : marginTypeName(jsonMember(p, "marginType"));
+        pos.updateTimeMs = jsonLong(jsonMember(p, "updateTime"));
+        out.positions.push_back(std::move(pos));
+    });
+    out.takerRate = jsonDouble(jsonMember(body, "takerCommissionRate"), -1.0);
+    out.makerRate = jsonDouble(jsonMember(body, "makerCommissionRate"), -1.0);
+    return out;
+}
+
+// GET /fapi/v1/userTrades
+std::vector<core::FillState> parseUserTrades(std::string_view body) {
+    std::vector<core::FillState> out;
+    jsonForEach(body, [&out](std::string_view e) {
+        core::FillState f;
+        f.tradeId = jsonLong(jsonMember(e, "id"));
+        f.orderId = jsonLong(jsonMember(e, "orderId"));
+        f.symbol = jsonString(jsonMember(e, "symbol"));
+        f.side = jsonString(jsonMember(e, "side"));
+        if (f.side.empty()) f.side = jsonBool(jsonMember(e, "buyer")) ? "BUY" : "SELL";
+        f.price = jsonDouble(jsonMember(e, "price"));
+        f.qty = jsonDouble(jsonMember(e, "qty"));
+        f.commission = jsonDouble(jsonMember(e, "commission"));
+        f.commissionAsset = jsonString(jsonMember(e, "commissionAsset"));
+        f.realizedPnl = jsonDouble(jsonMember(e, "realizedPnl"));
+        f.maker = jsonBool(jsonMember(e, "maker"));
+        f.timeMs = jsonLong(jsonMember(e, "time"));
+        out.push_back(std::move(f));
+    });
+    return out;
+}
+
+} // namespace
+
+struct UserDataStream::Impl {
+    Options options;
+    asio::io_context io;
+    std::unique_ptr<asio::executor_work_guard<asio::io_context::executor_type>> ioWork;
+    std::thread ioThread;
+    asio::steady_timer reconnectTimer{io};
+    asio::steady_timer keepAliveTimer{io};
+    asio::steady_timer reconcileTimer{io};
+    asio::steady_timer accountRefreshTimer{io};
+    tcp::resolver resolver{io};
+    // Declared after io: its completions post to io, so it must go first.
+    BinanceRest rest;
+    core::AccountState state;
+    std::atomic<core::OrderManager*> orders{nullptr};
+    std::atomic<core::OrderTracer*> tracer{nullptr};
+
+    std::string streamHost;
+    std::string streamPort;
+    std::string authority;  // Host header
+    std::atomic<bool> insecureTLS{false};
+    std::atomic<bool> isOpen{false};
+
+    // I/O thread only
+    bool started{false};
+    std::string listenKey;
+    std::shared_ptr<WsStream> ws;  // current connection; handlers of older ones are ignored
+    beast::flat_buffer readBuffer;
+    int backoffMs{kMinBackoffMs};
+    int reconcilesInFlight{0};
+    bool accountRefreshPending{false};
+    std::set<std::string> watched;
+
+    explicit Impl(const Options& o) : options(o), rest(Endpoints::get().restHost) {
+        const Endpoints& ep = Endpoints::get();
+        streamHost = ep.streamHost;
+        streamPort = ep.streamPort;
+        authority = streamPort == "443" ? streamHost : streamHost + ":" + streamPort;
+        ioWork = std::make_unique<asio::executor_work_guard<asio::io_context::executor_type>>(io.get_executor());
+        ioThread = std::thread([this]() { io.run(); });
+    }
+
+    // The listenKey is left to lapse: DELETE would also end other sessions of the account.
+    ~Impl() {
+        ioWork.reset();
+        io.stop();
+        if (ioThread.joinable()) ioThread.join();
+    }
+
+    // Runs fn(result) on the I/O thread when a REST call completes.
+    template <class Fn>
+    BinanceRest::AsyncOptions onIo(Fn fn) {
+        BinanceRest::AsyncOptions opts;
+        opts.onComplete = [this, fn = std::move(fn)](const BinanceRest::Result& r) {
+            asio::post(io, [fn, r]() { fn(r); });
+        };
+        return opts;
+    }
+
+    // ---- listenKey and connection ----
+
+    void obtainKey() {
+        (void)rest.startUserDataStreamAsync(onIo([this](const BinanceRest::Result& r) {
+            const std::string key = r.ok ? jsonString(jsonMember(r.body, "listenKey")) : std::string();
+            if (key.empty()) {
+                telemetry::logEvent("userdata", "listen_key_failed status=" + std::to_string(r.status) + " body=" + r.body.substr(0, 160));
+                return scheduleReconnect();
+            }
+            if (key != listenKey) telemetry::logEvent("userdata", "listen_key_new");
+            listenKey = key;
+            open();
+        }));
+    }
+
+    void open() {
+        auto& tls = TlsContextFactory::instance();
+        auto conn = std::make_shared<WsStream>(io, tls.client(!insecureTLS.load()));
+        ws = conn;
+        // suggested() leaves idle detection off: a half-open socket would look open forever and
+        // events would stop until the next REST reconcile. Ping when quiet; the read fails after
+        // kIdleTimeout of silence and drop() reconnects.
+        auto timeouts = websocket::stream_base::timeout::suggested(beast::role_type::client);
+        timeouts.idle_timeout = kIdleTimeout;
+        timeouts.keep_alive_pings = true;
+        conn->set_option(timeouts);
+        conn->set_option(websocket::stream_base::decorator([](websocket::request_type& req) {
+            req.set(beast::http::field::user_agent, "BinanceRJTech/1.0");
+        }));
+        tls.prepare(conn->next_layer().native_handle(), streamHost);
+        resolver.async_resolve(streamHost, streamPort, [this, conn](const boost::system::error_code& ec, tcp::resolver::results_type results) {
+            if (conn != ws) return;
+            if (ec) return drop("resolve", ec);
+            beast::get_lowest_layer(*conn).expires_after(std::chrono::seconds(10));
+            beast::get_lowest_layer(*conn).async_connect(results, [this, conn](const boost::system::error_code& connEc, const tcp::endpoint&) {
+                if (conn != ws) return;
+                if (connEc) return drop("connect", connEc);
+                conn->next_layer().async_handshake(ssl::stream_base::client, [this, conn](const boost::system::error_code& tlsEc) {
+                    if (conn != ws) return;
+                    if (tlsEc) {
+                        TlsContextFactory::instance().forget(streamHost);
+                        return drop("tls_handshake", tlsEc);
+                    }
+                    TlsContextFactory::instance().handshakeDone(conn->next_layer().native_handle());
+                    beast::get_lowest_layer(*conn).expires_never();  // the websocket handshake/idle timeouts take over
+                    conn->async_handshake(authority, "/ws/" + listenKey, [this, conn](const boost::system::error_code& wsEc) {
+                        if (conn != ws) return;
+                        if (wsEc) return drop("ws_handshake", wsEc);
+                        isOpen.store(true, std::memory_order_release);
+                        backoffMs = kMinBackoffMs;
+                        telemetry::logEvent("userdata", "connected host=" + authority);
+                        read();
+                        // Events missed while down only show up in REST.
+                        reconcile(true);
+                        armKeepAlive();
+                        armReconcile();
+                    });
+                });
+            });
+        });
+    }
+
+    void drop(const char* stage, const boost::system::error_code& ec) {
+        telemetry::logEvent("userdata", std::string("disconnected stage=") + stage + " msg=" + ec.message());
+        closeSocket();
+        scheduleReconnect();
+    }
+
+    void closeSocket() {
+        isOpen.store(false, std::memory_order_release);
+        if (ws) {
+            boost::system::error_code ignored;
+            beast::get_lowest_layer(*ws).socket().close(ignored);
+        }
+        ws.reset();
+        keepAliveTimer.cancel();
+        reconcileTimer.cancel();
+    }
+
+    // A reconnect starts from the listenKey: POST returns the active key or a fresh one.
+    void scheduleReconnect() {
+        reconnectTimer.expires_after(std::chrono::milliseconds(backoffMs));
+        backoffMs = std::min(backoffMs * 2, kMaxBackoffMs);
+        reconnectTimer.async_wait([this](const boost::system::error_code& ec) {
+            if (!ec) obtainKey();
+        });
+    }
+
+    void read() {
+        auto conn = ws;
+        conn->async_read(readBuffer, [this, conn](const boost::system::error_code& ec, std::size_t) {
+            if (conn != ws) return;
+            if (ec) return drop("read", ec);
+            const std::string text = beast::buffers_to_string(readBuffer.data());
+            readBuffer.consume(readBuffer.size());
+            onEvent(text);
+            if (conn == ws) read();
+        });
+    }
+
+    void armKeepAlive() {
+        keepAliveTimer.expires_after(std::chrono::seconds(std::max(60, options.keepAliveIntervalSec)));
+        keepAliveTimer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec) return;
+            (void)rest.keepAliveUserDataStreamAsync(onIo([this](const BinanceRest::Result& r) {
+                if (r.ok) return;
+                telemetry::logEvent("userdata", "keepalive_failed status=" + std::to_string(r.status) + " body=" + r.body.substr(0, 160));
+                // -1125: the key is gone; anything else is retried on the next tick.
+                if (jsonLong(jsonMember(r.body, "code")) == -1125 && ws) {
+                    closeSocket();
+                    obtainKey();
+                }
+            }));
+            armKeepAlive();
+        });
+    }
+
+    // ---- Events ----
+
+    void onEvent(std::string_view text) {
+        const auto receivedAt = std::chrono::steady_clock::now();
+        const std::string_view type = jsonUnquote(jsonMember(text, "e"));
+        const long long eventTime = jsonLong(jsonMember(text, "E"), serverNowMs());
+        telemetry::logCounter("userdata", "events", 1);
+        telemetry::logGauge("userdata", "event_lag_ms", static_cast<double>(serverNowMs() - eventTime));
+
+        if (type == "ORDER_TRADE_UPDATE") {
+            core::FillState fill;
+            bool traded = false;
+            const core::OrderState order = parseOrderEvent(jsonMember(text, "o"), eventTime, fill, traded);
+            state.applyOrderUpdate(order, traded ? &fill : nullptr);
+            if (core::OrderManager* oms = orders.load(std::memory_order_acquire)) oms->applyUpdate(order);
+            if (core::OrderTracer* trace = tracer.load(std::memory_order_acquire)) {
+                if (order.status == "NEW") trace->mark(order.clientOrderId, core::OrderStage::NewEvent, receivedAt);
+                if (traded) trace->mark(order.clientOrderId, core::OrderStage::FirstFill, receivedAt);
+            }
+        } else if (type == "ACCOUNT_UPDATE") {
+            const std::string_view a = jsonMember(text, "a");
+            std::vector<core::BalanceState> balances;
+            jsonForEach(jsonMember(a, "B"), [&balances](std::string_view b) {
+                core::BalanceState bal;
+                bal.asset = jsonString(jsonMember(b, "a"));
+                bal.walletBalance = jsonDouble(jsonMember(b, "wb"));
+                bal.crossWalletBalance = jsonDouble(jsonMember(b, "cw"));
+                balances.push_back(std::move(bal));
+            });
+            std::vector<core::PositionState> positions;
+            jsonForEach(jsonMember(a, "P"), [&positions](std::string_view p) { positions.push_back(parseEventPosition(p)); });
+            state.applyAccountUpdate(balances, positions, eventTime);
+            scheduleAccountRefresh();
+        } else if (type == "ACCOUNT_CONFIG_UPDATE") {
+            const std::string_view ac = jsonMember(text, "ac");
+            if (!ac.empty()) state.applyLeverage(jsonString(jsonMember(ac, "s")), static_cast<int>(jsonLong(jsonMember(ac, "l"))), eventTime);
+        } else if (type == "MARGIN_CALL") {
+            std::vector<core::PositionState> positions;
+            jsonForEach(jsonMember(text, "p"), [&positions](std::string_view p) { positions.push_back(parseEventPosition(p)); });
+            telemetry::logEvent("userdata", "margin_call positions=" + std::to_string(positions.size()));
+            state.applyMarginCall(positions, eventTime);
+        } else if (type == "listenKeyExpired") {
+            telemetry::logEvent("userdata", "listen_key_expired");
+            closeSocket();
+            obtainKey();
+        }
+    }
+
+    // ---- REST safety net ----
+
+    void armReconcile() {
+        reconcileTimer.expires_after(std::chrono::seconds(std::max(5, options.reconcileIntervalSec)));
+        reconcileTimer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec) return;
+            reconcile(false);
+            armReconcile();
+        });
+    }
+
+    void scheduleAccountRefresh() {
+        if (accountRefreshPending) return;
+        accountRefreshPending = true;
+        accountRefreshTimer.expires_after(std::chrono::milliseconds(std::max(0, options.accountRefreshDelayMs)));
+        accountRefreshTimer.async_wait([this](const boost::system::error_code& ec) {
+            accountRefreshPending = false;
+            if (!ec) fetchAccount();
+        });
+    }
+
+    void fetchAccount() {
+        const long long fetchStart = serverNowMs();
+        ++reconcilesInFlight;
+        (void)rest.getAccountInfoAsync(5000, onIo([this, fetchStart](const BinanceRest::Result& r) {
+            --reconcilesInFlight;
+            if (!r.ok) return;
+            const AccountReply a = parseAccount(r.body);
+            const auto cur = state.snapshot();
+            const std::size_t corrected = state.reconcileAccount(a.balances, a.positions,
+                a.takerRate >= 0.0 ? a.takerRate : cur->takerRate, a.makerRate >= 0.0 ? a.makerRate : cur->makerRate, fetchStart);
+            report("account", corrected);
+        }));
+    }
+
+    void fetchOpenOrders() {
+        const long long fetchStart = serverNowMs();
+        ++reconcilesInFlight;
+        (void)rest.getOpenOrdersAsync(std::string(), 5000, onIo([this, fetchStart](const BinanceRest::Result& r) {
+            --reconcilesInFlight;
+            if (!r.ok) return;
+            const std::vector<core::OrderState> open = parseOrderArray(r.body);
+            report("open_orders", state.reconcileOpenOrders(open, fetchStart));
+            if (core::OrderManager* oms = orders.load(std::memory_order_acquire)) {
+                std::vector<core::OrderState> unanswered;
+                report("oms", oms->reconcile(open, fetchStart, &unanswered));
+                for (const auto& o : unanswered) queryUnanswered(o);
+            }
+        }));
+    }
+
+    // A placement whose answer never came and that is not open: ask for its final state.
+    // Only "order does not exist" (-2013) makes it a rejection; any other failure leaves it
+    // pending for the next reconcile.
+    void queryUnanswered(const core::OrderState& pending) {
+        ++reconcilesInFlight;
+        const std::string clientOrderId = pending.clientOrderId;
+        (void)rest.queryOrderAsync(pending.symbol, 0, clientOrderId, 5000, onIo([this, clientOrderId](const BinanceRest::Result& r) {
+            --reconcilesInFlight;
+            core::OrderManager* oms = orders.load(std::memory_order_acquire);
+            if (!oms) return;
+            if (r.ok) {
+                core::OrderState order = parseOrderJson(r.body);
+                if (order.orderId <= 0) return;
+                if (order.clientOrderId.empty()) order.clientOrderId = clientOrderId;
+                oms->applyUpdate(order);
+                report("oms_query", 1);
+            } else if (jsonLong(jsonMember(r.body, "code")) == -2013) {
+                oms->onReject(clientOrderId, "no answer (order does not exist)", serverNowMs());
+                report("oms_query", 1);
+            }
+        }));
+    }
+
+    void backfillFills(const std::string& symbol) {
+        (void)rest.getUserTradesAsync(symbol, options.fillBackfillLimit, 5000, onIo([symbol, this](const BinanceRest::Result& r) {
+            if (!r.ok) return;
+            const std::size_t added = state.mergeFills(parseUserTrades(r.body));
+            if (added > 0) telemetry::logCounter("userdata", "fills_backfilled", static_cast<long long>(added));
+        }));
+    }
+
+    // Full: account + all open orders, plus fills of watched symbols after a connect.
+    void reconcile(bool afterConnect) {
+        if (afterConnect) {
+            for (const auto& sym : watched) backfillFills(sym);
+        }
+        if (reconcilesInFlight > 0) return;
+        telemetry::logCounter("userdata", "reconcile", 1);
+        fetchAccount();
+        fetchOpenOrders();
+    }
+
+    // Corrections mean events were missed or misapplied.
+    static void report(const char* what, std::size_t corrected) {
+        if (corrected == 0) return;
+        telemetry::logCounter("userdata", "reconcile_corrections", static_cast<long long>(corrected));
+        telemetry::logEvent("userdata", std::string("reconcile_corrected what=") + what + " entries=" + std::to_string(corrected));
+    }
+};
+
+UserDataStream::UserDataStream(Options options) : impl_(new Impl(options)) {}
+
+UserDataStream::~UserDataStream() = default;
+
+void UserDataStream::setCredentials(const std::string& apiKey, const std::string& apiSecret) {
+    impl_->rest.setCredentials(apiKey, apiSecret);
+}
+
+void UserDataStream::setInsecureTLS(bool v) {
+    impl_->insecureTLS = v;
+    impl_->rest.setInsecureTLS(v);
+}
+
+void UserDataStream::start() {
+    asio::post(impl_->io, [impl = impl_.get()]() {
+        if (impl->started) return;
+        impl->started = true;
+        impl->obtainKey();
+    });
+}
+
+bool UserDataStream::connected() const {
+    return impl_->isOpen.load(std::memory_order_acquire);
+}
+
+void UserDataStream::watchSymbol(const std::string& symbol) {
+    asio::post(impl_->io, [impl = impl_.get(), symbol]() {
+        if (symbol.empty() || !impl->watched.insert(symbol).second) return;
+        if (impl->isOpen.load(std::memory_order_relaxed)) impl->backfillFills(symbol);
+    });
+}
+
+void UserDataStream::setOrderManager(core::OrderManager* oms) {
+    impl_->orders.store(oms, std::memory_order_release);
+}
+
+void UserDataStream::setOrderTracer(core::OrderTracer* tracer) {
+    impl_->tracer.store(tracer, std::memory_order_release);
+}
+
+void UserDataStream::requestReconcile() {
+    asio::post(impl_->io, [impl = impl_.get()]() { impl->reconcile(false); });
+}
+
+const core::AccountState& UserDataStream::state() const {
+    return impl_->state;
+}
+
+} // namespace binancerj::net
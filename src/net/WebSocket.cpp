@@ -1,4 +1,5 @@
 #include "binancerj/net/WebSocket.hpp"
+#include "binancerj/net/TlsContext.hpp"
 #include "binancerj/telemetry/PerfTelemetry.hpp"
 #include <boost/beast/websocket/ssl.hpp>
 #include <boost/system/error_code.hpp>
@@ -7,11 +8,9 @@
 WebSocket::WebSocket(const std::string& host, const std::string& port)
     : host_(host),
     port_(port),
-    ssl_context_(boost::asio::ssl::context::tlsv12_client),
+    ssl_context_(binancerj::net::TlsContextFactory::instance().client()),
     ws_(io_context_, ssl_context_) {
-    // Set up SSL verification
-    ssl_context_.set_verify_mode(boost::asio::ssl::verify_peer);
-    ssl_context_.set_default_verify_paths();
+    // Peer verification and CA loading happen once in the shared context
 }
 
 WebSocket::~WebSocket() {
@@ -24,8 +23,11 @@ void WebSocket::connect() {
         boost::asio::ip::tcp::resolver resolver(io_context_);
         auto const results = resolver.resolve(host_, port_);
 
+        auto& tls = binancerj::net::TlsContextFactory::instance();
+        tls.prepare(ws_.next_layer().native_handle(), host_);
         boost::asio::connect(ws_.next_layer().next_layer(), results.begin(), results.end());
         ws_.next_layer().handshake(boost::asio::ssl::stream_base::client);
+        tls.handshakeDone(ws_.next_layer().native_handle());
         ws_.handshake(host_, "/ws");
         std::cout << "Connected to " << host_ << std::endl;
         telemetry::logEvent("ws", "connected host=" + host_);
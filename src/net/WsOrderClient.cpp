@@ -0,0 +1,543 @@
+#include "binancerj/net/WsOrderClient.hpp"
+#include "binancerj/net/ClockSync.hpp"
+#include "binancerj/net/Endpoints.hpp"
+#include "binancerj/net/JsonScan.hpp"
+#include "binancerj/net/RateLimitGovernor.hpp"
+#include "binancerj/net/RequestSigner.hpp"
+#include "binancerj/net/ResponseCache.hpp"
+#include "binancerj/net/TlsContext.hpp"
+#include "binancerj/telemetry/PerfTelemetry.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace binancerj::net {
+
+namespace {
+
+namespace asio = boost::asio;
+namespace ssl = boost::asio::ssl;
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+using tcp = asio::ip::tcp;
+using WsStream = websocket::stream<beast::ssl_stream<beast::tcp_stream>>;
+using Governor = RateLimitGovernor;
+using Clock = std::chrono::steady_clock;
+
+constexpr const char* kPath = "/ws-fapi/v1";
+constexpr auto kSweepInterval = std::chrono::milliseconds(50);
+constexpr auto kIdleTimeout = std::chrono::seconds(5);  // silent this long (ping at half) = dead socket
+constexpr int kMaxExpiriesInRow = 3;  // written requests timing out with no answer in between = stuck session
+constexpr int kMinBackoffMs = 250;
+constexpr int kMaxBackoffMs = 5000;
+
+std::string getEnv(const char* name) {
+#ifdef _WIN32
+    size_t len = 0; char* buf = nullptr;
+    if (_dupenv_s(&buf, &len, name) == 0 && buf) { std::string v(buf); free(buf); return v; }
+    return {};
+#else
+    const char* v = std::getenv(name);
+    return v ? std::string(v) : std::string();
+#endif
+}
+
+std::string trimmed(std::string v) {
+    while (!v.empty() && std::isspace(static_cast<unsigned char>(v.front()))) v.erase(v.begin());
+    while (!v.empty() && std::isspace(static_cast<unsigned char>(v.back()))) v.pop_back();
+    if (v.size() >= 2 && (v.front() == '"' || v.front() == '\'') && v.back() == v.front()) v = v.substr(1, v.size() - 2);
+    return v;
+}
+
+std::string fixed8(double v) {
+    char buf[64];
+    auto res = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::fixed, 8);
+    return res.ec == std::errc() ? std::string(buf, res.ptr) : std::string("0");
+}
+
+// One request parameter; numbers go out unquoted. The signature covers "k=v&..." of the
+// params sorted by key, with the values exactly as sent.
+struct Param {
+    std::string key;
+    std::string value;
+    bool number{false};
+};
+
+void appendJsonString(std::string& out, std::string_view s) {
+    out += '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    out += '"';
+}
+
+// rateLimits: [{"rateLimitType":"REQUEST_WEIGHT","interval":"MINUTE","intervalNum":1,"count":9},...]
+void readRateLimits(std::string_view limits, BinanceRest::Result& r) {
+    jsonForEach(limits, [&r](std::string_view entry) {
+        const std::string_view type = jsonMember(entry, "rateLimitType");
+        const std::string_view interval = jsonMember(entry, "interval");
+        const long long num = jsonLong(jsonMember(entry, "intervalNum"), 0);
+        const int count = static_cast<int>(jsonLong(jsonMember(entry, "count"), -1));
+        if (type == "\"REQUEST_WEIGHT\"" && interval == "\"MINUTE\"" && num == 1) r.usedWeight1m = count;
+        else if (type == "\"ORDERS\"" && interval == "\"SECOND\"" && num == 10) r.orderCount10s = count;
+        else if (type == "\"ORDERS\"" && interval == "\"MINUTE\"" && num == 1) r.orderCount1m = count;
+    });
+}
+
+BinanceRest::Result failedResult(int status, const std::string& why) {
+    BinanceRest::Result r;
+    r.ok = false;
+    r.status = status;
+    r.body = why;
+    return r;
+}
+
+} // namespace
+
+struct WsOrderClient::Impl {
+    // One request from submission to answer; owned by the I/O thread after submit().
+    struct Request {
+        long long id{0};
+        const char* method{""};       // ws-fapi method, e.g. "order.place"
+        bool write{false};            // changes orders: stales cached account reads
+        Governor::Classified cost{Governor::Priority::Order, 1, 1};
+        std::vector<Param> params;    // without apiKey/timestamp/signature
+        int recvWindowMs{5000};
+        std::promise<Result> promise;
+        std::function<void(const Result&)> onComplete;
+        std::function<void()> onSigned;
+        std::function<void()> onWritten;
+        Clock::time_point deadline;
+        Clock::time_point sentAt;
+        int gateWaitedMs{0};
+        std::unique_ptr<asio::steady_timer> gate;  // governor delays
+    };
+    using RequestPtr = std::shared_ptr<Request>;
+
+    enum class State { Closed, Connecting, Open };
+
+    asio::io_context io;
+    std::unique_ptr<asio::executor_work_guard<asio::io_context::executor_type>> ioWork;
+    std::thread ioThread;
+    asio::steady_timer sweep{io};
+    asio::steady_timer reconnect{io};
+    tcp::resolver resolver{io};
+
+    std::string host;      // "host[:port]": Host header
+    std::string hostName;  // DNS name / SNI
+    std::string port;
+    std::string apiKey;
+    RequestSigner signer;
+    std::atomic<bool> insecureTLS{false};
+    std::atomic<long long> nextId{1};
+
+    // I/O thread only
+    State state{State::Closed};
+    std::shared_ptr<WsStream> ws;     // current connection; handlers of older ones are ignored
+    beast::flat_buffer readBuffer;
+    std::string writeFrame;
+    bool writing{false};
+    bool keepOpen{false};
+    int backoffMs{kMinBackoffMs};
+    int expiriesInRow{0};                                // written requests expired since the last answer
+    std::deque<RequestPtr> queued;                       // admitted, not yet written
+    std::unordered_map<long long, RequestPtr> written;   // awaiting the answer
+
+    std::atomic<bool> isOpen{false};
+    std::atomic<std::size_t> outstanding{0};
+
+    explicit Impl(const std::string& h) : host(h) {
+        splitHostPort(host, hostName, port);
+        apiKey = trimmed(getEnv("BINANCE_API_KEY"));
+        signer.setSecret(trimmed(getEnv("BINANCE_API_SECRET")));
+        ioWork = std::make_unique<asio::executor_work_guard<asio::io_context::executor_type>>(io.get_executor());
+        ioThread = std::thread([this]() { io.run(); });
+        asio::post(io, [this]() { armSweep(); });
+    }
+
+    ~Impl() {
+        ioWork.reset();
+        io.stop();
+        if (ioThread.joinable()) ioThread.join();
+        // Nothing runs on the I/O thread any more.
+        for (auto& r : queued) finish(*r, failedResult(-2, "WS API error: client closed"));
+        for (auto& [id, r] : written) finish(*r, failedResult(-2, "WS API error: client closed"));
+    }
+
+    AsyncRequest submit(const char* method, bool write, const char* restMethod, std::vector<Param> params, int recvWindowMs, AsyncOptions options) {
+        auto req = std::make_shared<Request>();
+        req->id = nextId.fetch_add(1, std::memory_order_relaxed);
+        req->method = method;
+        req->write = write;
+        req->cost = Governor::classify(restMethod, "/fapi/v1/order");
+        req->params = std::move(params);
+        req->recvWindowMs = recvWindowMs;
+        req->onComplete = std::move(options.onComplete);
+        req->onSigned = std::move(options.onSigned);
+        req->onWritten = std::move(options.onWritten);
+        req->deadline = Clock::now() + std::chrono::milliseconds(options.timeoutMs > 0 ? options.timeoutMs : 10000);
+        AsyncRequest handle;
+        handle.result = req->promise.get_future();
+        outstanding.fetch_add(1, std::memory_order_relaxed);
+        asio::post(io, [this, req]() { admit(req); });
+        return handle;
+    }
+
+    // Same ordering rules as REST: order entry outranks polling when the budget runs low.
+    void admit(const RequestPtr& req) {
+        const auto d = Governor::instance().admit(req->cost, req->gateWaitedMs);
+        if (d.kind == Governor::Decision::Shed) {
+            telemetry::logEvent("ws_order", std::string("shed method=") + req->method + " reason=" + d.reason);
+            return complete(req, failedResult(-3, std::string("Rate limit: ") + d.reason));
+        }
+        if (d.kind == Governor::Decision::Delay) {
+            if (!req->gate) req->gate = std::make_unique<asio::steady_timer>(io);
+            req->gateWaitedMs += d.delayMs;
+            req->gate->expires_after(std::chrono::milliseconds(d.delayMs));
+            req->gate->async_wait([this, req](const boost::system::error_code& ec) {
+                if (!ec) admit(req);
+            });
+            return;
+        }
+        queued.push_back(req);
+        if (state == State::Open) flush();
+        else open();
+    }
+
+    // Signs with the current exchange time, so a request that waited in the queue is not stale.
+    std::string frame(Request& req) {
+        std::vector<Param> params = req.params;
+        params.push_back(Param{"apiKey", apiKey, false});
+        params.push_back(Param{"recvWindow", std::to_string(req.recvWindowMs), true});
+        params.push_back(Param{"timestamp", std::to_string(ClockSync::instance().serverTimeMs()), true});
+        std::sort(params.begin(), params.end(), [](const Param& a, const Param& b) { return a.key < b.key; });
+
+        std::string payload;
+        payload.reserve(256);
+        for (const auto& p : params) {
+            if (!payload.empty()) payload += '&';
+            payload.append(p.key).append(1, '=').append(p.value);
+        }
+        char hex[RequestSigner::kHexLength];
+        signer.sign(payload, hex);
+
+        std::string out;
+        out.reserve(payload.size() + 192);
+        out += "{\"id\":";
+        out += std::to_string(req.id);
+        out += ",\"method\":\"";
+        out += req.method;
+        out += "\",\"params\":{";
+        for (const auto& p : params) {
+            appendJsonString(out, p.key);
+            out += ':';
+            if (p.number) out += p.value;
+            else appendJsonString(out, p.value);
+            out += ',';
+        }
+        out += "\"signature\":\"";
+        out.append(hex, sizeof(hex));
+        out += "\"}}";
+        return out;
+    }
+
+    void flush() {
+        if (writing || state != State::Open || queued.empty()) return;
+        RequestPtr req = std::move(queued.front());
+        queued.pop_front();
+        writeFrame = frame(*req);
+        if (req->onSigned) req->onSigned();
+        written.emplace(req->id, req);
+        writing = true;
+        auto conn = ws;
+        conn->async_write(asio::buffer(writeFrame), [this, conn, req](const boost::system::error_code& ec, std::size_t) {
+            if (conn != ws) return;
+            writing = false;
+            if (ec) return drop("write", ec);
+            req->sentAt = Clock::now();
+            if (req->onWritten) req->onWritten();
+            telemetry::logCounter("ws_order", "sent", 1);
+            flush();
+        });
+    }
+
+    void open() {
+        if (state != State::Closed) return;
+        state = State::Connecting;
+        reconnect.cancel();
+        auto& tls = TlsContextFactory::instance();
+        auto conn = std::make_shared<WsStream>(io, tls.client(!insecureTLS.load()));
+        ws = conn;
+        // suggested() leaves idle detection off: ping when quiet and drop a half-open socket
+        auto timeouts = websocket::stream_base::timeout::suggested(beast::role_type::client);
+        timeouts.idle_timeout = kIdleTimeout;
+        timeouts.keep_alive_pings = true;
+        conn->set_option(timeouts);
+        conn->set_option(websocket::stream_base::decorator([](websocket::request_type& req) {
+            req.set(beast::http::field::user_agent, "BinanceRJTech/1.0");
+        }));
+        tls.prepare(conn->next_layer().native_handle(), hostName);
+        resolver.async_resolve(hostName, port, [this, conn](const boost::system::error_code& ec, tcp::resolver::results_type results) {
+            if (conn != ws) return;
+            if (ec) return connectFailed("resolve", ec);
+            beast::get_lowest_layer(*conn).expires_after(std::chrono::seconds(10));
+            beast::get_lowest_layer(*conn).async_connect(results, [this, conn](const boost::system::error_code& connEc, const tcp::endpoint&) {
+                if (conn != ws) return;
+                if (connEc) return connectFailed("connect", connEc);
+                beast::get_lowest_layer(*conn).socket().set_option(tcp::no_delay(true));
+                conn->next_layer().async_handshake(ssl::stream_base::client, [this, conn](const boost::system::error_code& tlsEc) {
+                    if (conn != ws) return;
+                    if (tlsEc) {
+                        TlsContextFactory::instance().forget(hostName);
+                        return connectFailed("tls_handshake", tlsEc);
+                    }
+                    TlsContextFactory::instance().handshakeDone(conn->next_layer().native_handle());
+                    beast::get_lowest_layer(*conn).expires_never();  // the websocket handshake/idle timeouts take over
+                    conn->async_handshake(host, kPath, [this, conn](const boost::system::error_code& wsEc) {
+                        if (conn != ws) return;
+                        if (wsEc) return connectFailed("ws_handshake", wsEc);
+                        state = State::Open;
+                        isOpen.store(true, std::memory_order_release);
+                        backoffMs = kMinBackoffMs;
+                        expiriesInRow = 0;
+                        telemetry::logEvent("ws_order", "connected host=" + host);
+                        read();
+                        flush();
+                    });
+                });
+            });
+        });
+    }
+
+    void connectFailed(const char* stage, const boost::system::error_code& ec) {
+        telemetry::logEvent("ws_order", std::string("connect_failed stage=") + stage + " msg=" + ec.message());
+        state = State::Closed;
+        ws.reset();
+        scheduleReconnect();
+    }
+
+    // Queued requests keep their place; their own deadlines bound the wait.
+    void scheduleReconnect() {
+        if (!keepOpen && queued.empty()) return;
+        reconnect.expires_after(std::chrono::milliseconds(backoffMs));
+        backoffMs = std::min(backoffMs * 2, kMaxBackoffMs);
+        reconnect.async_wait([this](const boost::system::error_code& ec) {
+            if (!ec) open();
+        });
+    }
+
+    void read() {
+        auto conn = ws;
+        conn->async_read(readBuffer, [this, conn](const boost::system::error_code& ec, std::size_t) {
+            if (conn != ws) return;
+            if (ec) return drop("read", ec);
+            const std::string text = beast::buffers_to_string(readBuffer.data());
+            readBuffer.consume(readBuffer.size());
+            onFrame(text);
+            read();
+        });
+    }
+
+    // {"id":7,"status":200,"result":{...},"rateLimits":[...]} or {"id":7,"status":400,"error":{"code":..,"msg":..}}
+    void onFrame(std::string_view text) {
+        const long long id = jsonLong(jsonMember(text, "id"), -1);
+        auto it = written.find(id);
+        if (it == written.end()) {
+            telemetry::logCounter("ws_order", "unmatched", 1);
+            return;
+        }
+        RequestPtr req = std::move(it->second);
+        written.erase(it);
+        expiriesInRow = 0;
+
+        Result r;
+        r.status = static_cast<int>(jsonLong(jsonMember(text, "status"), -1));
+        r.ok = r.status >= 200 && r.status < 300;
+        const std::string_view body = jsonMember(text, r.ok ? "result" : "error");
+        r.body.assign(body.data(), body.size());
+        if (const auto limits = jsonMember(text, "rateLimits"); !limits.empty()) readRateLimits(limits, r);
+        if (r.status == 429 || r.status == 418) {
+            // error.data.retryAfter is an exchange timestamp (ms)
+            const long long until = jsonLong(jsonMember(jsonMember(body, "data"), "retryAfter"), 0);
+            const long long waitMs = until - ClockSync::instance().serverTimeMs();
+            r.retryAfterSec = until > 0 ? static_cast<int>(std::max(1LL, (waitMs + 999) / 1000)) : 0;
+        }
+        Governor::instance().onResponse(r.status, r.usedWeight1m, r.orderCount10s, r.orderCount1m, r.retryAfterSec);
+        if (r.usedWeight1m >= 0) telemetry::logGauge("ws_order", "used_weight_1m", static_cast<double>(r.usedWeight1m));
+        if (req->sentAt != Clock::time_point{}) {
+            telemetry::logGauge("ws_order", "rtt_ms", std::chrono::duration<double, std::milli>(Clock::now() - req->sentAt).count());
+        }
+        complete(req, std::move(r));
+    }
+
+    // Written requests cannot be replayed safely: fail them and let the caller query.
+    void drop(const char* stage, const boost::system::error_code& ec) {
+        telemetry::logEvent("ws_order", std::string("disconnected stage=") + stage + " msg=" + ec.message() + " in_flight=" + std::to_string(written.size()));
+        state = State::Closed;
+        isOpen.store(false, std::memory_order_release);
+        if (ws) {
+            boost::system::error_code ignored;
+            beast::get_lowest_layer(*ws).socket().close(ignored);
+        }
+        ws.reset();
+        writing = false;
+        auto lost = std::move(written);
+        written.clear();
+        for (auto& [id, req] : lost) {
+            telemetry::logCounter("ws_order", "lost", 1);
+            complete(req, failedResult(-1, std::string("WS API error: connection lost (") + stage + ": " + ec.message() + ")"));
+        }
+        scheduleReconnect();
+    }
+
+    void armSweep() {
+        sweep.expires_after(kSweepInterval);
+        sweep.async_wait([this](const boost::system::error_code& ec) {
+            if (ec) return;
+            expire();
+            armSweep();
+        });
+    }
+
+    void expire() {
+        const auto now = Clock::now();
+        for (auto it = queued.begin(); it != queued.end();) {
+            if ((*it)->deadline > now) { ++it; continue; }
+            RequestPtr req = std::move(*it);
+            it = queued.erase(it);
+            telemetry::logCounter("ws_order", "timeout", 1);
+            complete(req, failedResult(-1, "WS API error: timeout (not sent)"));
+        }
+        // Only the expired requests fail; the others keep their own deadlines. A dead socket is
+        // the idle timeout's call, but several expiries with no answer in between mean the
+        // session is stuck, so it is replaced instead of taking further orders.
+        for (auto it = written.begin(); it != written.end();) {
+            if (it->second->deadline > now) { ++it; continue; }
+            RequestPtr req = std::move(it->second);
+            it = written.erase(it);
+            ++expiriesInRow;
+            telemetry::logCounter("ws_order", "timeout", 1);
+            complete(req, failedResult(-1, "WS API error: timeout"));
+        }
+        if (expiriesInRow >= kMaxExpiriesInRow && state == State::Open) {
+            expiriesInRow = 0;
+            drop("response", beast::error::timeout);
+        }
+    }
+
+    void complete(const RequestPtr& req, Result r) {
+        if (req->gate) req->gate->cancel();
+        if (req->write && r.status != -3) {
+            // Same scope BinanceRest uses for this account's cached reads.
+            ResponseCache::instance().invalidate(Endpoints::get().restHost + "#" + apiKey);
+        }
+        finish(*req, std::move(r));
+    }
+
+    void finish(Request& req, Result r) {
+        outstanding.fetch_sub(1, std::memory_order_relaxed);
+        if (req.onComplete) {
+            try { req.onComplete(r); } catch (...) {}
+        }
+        req.promise.set_value(std::move(r));
+    }
+};
+
+WsOrderClient::WsOrderClient(const std::string& wsApiHost)
+    : impl_(new Impl(wsApiHost.empty() ? Endpoints::get().wsApiHost : wsApiHost)) {}
+
+WsOrderClient::~WsOrderClient() = default;
+
+void WsOrderClient::setCredentials(const std::string& apiKey, const std::string& apiSecret) {
+    asio::post(impl_->io, [impl = impl_.get(), apiKey]() { impl->apiKey = apiKey; });
+    impl_->signer.setSecret(apiSecret);
+}
+
+void WsOrderClient::setInsecureTLS(bool v) {
+    impl_->insecureTLS = v;
+}
+
+void WsOrderClient::connect() {
+    asio::post(impl_->io, [impl = impl_.get()]() {
+        impl->keepOpen = true;
+        impl->open();
+    });
+}
+
+bool WsOrderClient::connected() const {
+    return impl_->isOpen.load(std::memory_order_acquire);
+}
+
+std::size_t WsOrderClient::inFlight() const {
+    return impl_->outstanding.load(std::memory_order_relaxed);
+}
+
+// ---- Requests ----
+
+static void addOrderRef(std::vector<Param>& params, long long orderId, const std::string& origClientOrderId) {
+    if (orderId > 0) params.push_back(Param{"orderId", std::to_string(orderId), true});
+    else params.push_back(Param{"origClientOrderId", origClientOrderId, false});
+}
+
+WsOrderClient::AsyncRequest WsOrderClient::placeOrderAsync(const OrderRequest& o, int recvWindowMs, AsyncOptions options) {
+    std::vector<Param> params;
+    params.reserve(14);
+    params.push_back(Param{"symbol", o.symbol, false});
+    params.push_back(Param{"side", o.side, false});
+    params.push_back(Param{"type", o.type, false});
+    params.push_back(Param{"quantity", fixed8(o.quantity), true});
+    if (o.type == "LIMIT") {
+        params.push_back(Param{"price", fixed8(o.price), true});
+        params.push_back(Param{"timeInForce", o.timeInForce.empty() ? std::string("GTC") : o.timeInForce, false});
+    }
+    if (o.type == "STOP_MARKET" || o.type == "TAKE_PROFIT_MARKET") {
+        if (o.stopPrice > 0) params.push_back(Param{"stopPrice", fixed8(o.stopPrice), true});
+        if (!o.workingType.empty()) params.push_back(Param{"workingType", o.workingType, false});
+    }
+    if (!o.positionSide.empty()) params.push_back(Param{"positionSide", o.positionSide, false});
+    if (o.reduceOnly) params.push_back(Param{"reduceOnly", "true", false});
+    if (!o.newClientOrderId.empty()) params.push_back(Param{"newClientOrderId", o.newClientOrderId, false});
+    return impl_->submit("order.place", true, "POST", std::move(params), recvWindowMs, std::move(options));
+}
+
+WsOrderClient::AsyncRequest WsOrderClient::cancelOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, int recvWindowMs, AsyncOptions options) {
+    std::vector<Param> params{Param{"symbol", symbol, false}};
+    addOrderRef(params, orderId, origClientOrderId);
+    return impl_->submit("order.cancel", true, "DELETE", std::move(params), recvWindowMs, std::move(options));
+}
+
+WsOrderClient::AsyncRequest WsOrderClient::modifyOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, const std::string& side, double quantity, double price, int recvWindowMs, AsyncOptions options) {
+    std::vector<Param> params{Param{"symbol", symbol, false}};
+    addOrderRef(params, orderId, origClientOrderId);
+    params.push_back(Param{"side", side, false});
+    params.push_back(Param{"quantity", fixed8(quantity), true});
+    params.push_back(Param{"price", fixed8(price), true});
+    return impl_->submit("order.modify", true, "PUT", std::move(params), recvWindowMs, std::move(options));
+}
+
+WsOrderClient::AsyncRequest WsOrderClient::queryOrderAsync(const std::string& symbol, long long orderId, const std::string& origClientOrderId, int recvWindowMs, AsyncOptions options) {
+    std::vector<Param> params{Param{"symbol", symbol, false}};
+    addOrderRef(params, orderId, origClientOrderId);
+    return impl_->submit("order.status", false, "GET", std::move(params), recvWindowMs, std::move(options));
+}
+
+} // namespace binancerj::net